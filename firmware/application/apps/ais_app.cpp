@@ -133,7 +133,7 @@ static std::string true_heading(const TrueHeading value) {
 } /* namespace format */
 } /* namespace ais */
 
-void AISLogger::on_packet(const ais::Packet& packet) {
+void AISLogger::on_packet(const ais::Packet& packet, const uint32_t channel) {
 	// TODO: Unstuff here, not in baseband!
 	std::string entry;
 	entry.reserve((packet.length() + 3) / 4);
@@ -143,11 +143,14 @@ void AISLogger::on_packet(const ais::Packet& packet) {
 		entry += (nibble >= 10) ? ('W' + nibble) : ('0' + nibble);
 	}
 
+	entry += (channel == 0) ? " A" : " B";
+
 	log_file.write_entry(packet.received_at(), entry);
 }	
 
-void AISRecentEntry::update(const ais::Packet& packet) {
+void AISRecentEntry::update(const ais::Packet& packet, const uint32_t channel) {
 	received_count++;
+	channels |= (1U << channel);
 
 	switch(packet.message_id()) {
 	case 1:
@@ -281,7 +284,8 @@ void AISRecentEntryDetailView::paint(Painter& painter) {
 	field_rect = draw_field(painter, field_rect, s, "SoG ", ais::format::speed_over_ground(entry_.last_position.speed_over_ground));
 	field_rect = draw_field(painter, field_rect, s, "CoG ", ais::format::course_over_ground(entry_.last_position.course_over_ground));
 	field_rect = draw_field(painter, field_rect, s, "Head", ais::format::true_heading(entry_.last_position.true_heading));
-	field_rect = draw_field(painter, field_rect, s, "Rx #", to_string_dec_uint(entry_.received_count));
+	const std::string channels = (entry_.channels == 0b11) ? "A+B" : ((entry_.channels & 0b01) ? "A" : "B");
+	field_rect = draw_field(painter, field_rect, s, "Rx #", to_string_dec_uint(entry_.received_count) + " on " + channels);
 }
 
 void AISRecentEntryDetailView::set_entry(const AISRecentEntry& entry) {
@@ -306,8 +310,6 @@ AISAppView::AISAppView(NavigationView& nav) : nav_ { nav } {
 
 	recent_entry_detail_view.hidden(true);
 
-	target_frequency_ = initial_target_frequency;
-
 	radio::enable({
 		tuning_frequency(),
 		sampling_rate,
@@ -319,9 +321,9 @@ AISAppView::AISAppView(NavigationView& nav) : nav_ { nav } {
 	});
 
 	options_channel.on_change = [this](size_t, OptionsField::value_t v) {
-		this->on_frequency_changed(v);
+		channel_mask = v;
 	};
-	options_channel.set_by_value(target_frequency());
+	options_channel.set_by_value(channel_mask);
 
 	recent_entries_view.on_select = [this](const AISRecentEntry& entry) {
 		this->on_show_detail(entry);
@@ -353,13 +355,13 @@ void AISAppView::set_parent_rect(const Rect new_parent_rect) {
 	recent_entry_detail_view.set_parent_rect(content_rect);
 }
 
-void AISAppView::on_packet(const ais::Packet& packet) {
+void AISAppView::on_packet(const ais::Packet& packet, const uint32_t channel) {
 	if( logger ) {
-		logger->on_packet(packet);
+		logger->on_packet(packet, channel);
 	}
 
 	auto& entry = ::on_packet(recent, packet.source_id());
-	entry.update(packet);
+	entry.update(packet, channel);
 	recent_entries_view.set_dirty();
 
 	// TODO: Crude hack, should be a more formal listener arrangement...
@@ -382,21 +384,8 @@ void AISAppView::on_show_detail(const AISRecentEntry& entry) {
 	recent_entry_detail_view.focus();
 }
 
-void AISAppView::on_frequency_changed(const uint32_t new_target_frequency) {
-	set_target_frequency(new_target_frequency);
-}
-
-void AISAppView::set_target_frequency(const uint32_t new_value) {
-	target_frequency_ = new_value;
-	radio::set_tuning_frequency(tuning_frequency());
-}
-
-uint32_t AISAppView::target_frequency() const {
-	return target_frequency_;
-}
-
 uint32_t AISAppView::tuning_frequency() const {
-	return target_frequency() - (sampling_rate / 4);
+	return center_frequency - (sampling_rate / 4);
 }
 
 } /* namespace ui */
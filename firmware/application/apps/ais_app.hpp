@@ -71,6 +71,7 @@ struct AISRecentEntry {
 	AISPosition last_position;
 	size_t received_count;
 	int8_t navigational_status;
+	uint8_t channels;		/* Bit 0: heard on A (87B), bit 1: on B (88B) */
 
 	AISRecentEntry(
 	) : AISRecentEntry { 0 }
@@ -85,7 +86,8 @@ struct AISRecentEntry {
 		destination { },
 		last_position { },
 		received_count { 0 },
-		navigational_status { -1 }
+		navigational_status { -1 },
+		channels { 0 }
 	{
 	}
 
@@ -93,7 +95,7 @@ struct AISRecentEntry {
 		return mmsi;
 	}
 
-	void update(const ais::Packet& packet);
+	void update(const ais::Packet& packet, const uint32_t channel);
 };
 
 using AISRecentEntries = RecentEntries<AISRecentEntry>;
@@ -104,7 +106,7 @@ public:
 		return log_file.append(filename);
 	}
 	
-	void on_packet(const ais::Packet& packet);
+	void on_packet(const ais::Packet& packet, const uint32_t channel);
 
 private:
 	LogFile log_file { };
@@ -166,7 +168,8 @@ public:
 	std::string title() const override { return "AIS"; };
 
 private:
-	static constexpr uint32_t initial_target_frequency = 162025000;
+	/* Midway between 161.975MHz and 162.025MHz, both are received. */
+	static constexpr uint32_t center_frequency = 162000000;
 	static constexpr uint32_t sampling_rate = 2457600;
 	static constexpr uint32_t baseband_bandwidth = 1750000;
 	NavigationView& nav_;
@@ -192,8 +195,9 @@ private:
 		{ 3 * 8, 0 * 16 },
 		3,
 		{
-			{ "87B", 161975000 },
-			{ "88B", 162025000 },
+			{ "A+B", 0b11 },
+			{ "87B", 0b01 },
+			{ "88B", 0b10 },
 		}
 	};
 
@@ -222,23 +226,18 @@ private:
 		[this](Message* const p) {
 			const auto message = static_cast<const AISPacketMessage*>(p);
 			const ais::Packet packet { message->packet };
-			if( packet.is_valid() ) {
-				this->on_packet(packet);
+			if( packet.is_valid() && (channel_mask & (1U << message->channel)) ) {
+				this->on_packet(packet, message->channel);
 			}
 		}
 	};
 
-	uint32_t target_frequency_ = initial_target_frequency;
+	uint32_t channel_mask { 0b11 };
 
-	void on_packet(const ais::Packet& packet);
+	void on_packet(const ais::Packet& packet, const uint32_t channel);
 	void on_show_list();
 	void on_show_detail(const AISRecentEntry& entry);
 
-	void on_frequency_changed(const uint32_t new_target_frequency);
-
-	uint32_t target_frequency() const;
-	void set_target_frequency(const uint32_t new_value);
-
 	uint32_t tuning_frequency() const;
 };
 
@@ -34,6 +34,7 @@ CaptureAppView::CaptureAppView(NavigationView& nav) {
 
 	add_children({
 		&labels,
+		&labels_format,
 		&rssi,
 		&channel,
 		&field_frequency,
@@ -42,6 +43,7 @@ CaptureAppView::CaptureAppView(NavigationView& nav) {
 		&field_lna,
 		&field_vga,
 		&option_bandwidth,
+		&option_format,
 		&record_view,
 		&waterfall,
 	});
@@ -73,14 +75,29 @@ CaptureAppView::CaptureAppView(NavigationView& nav) {
 	};
 	
 	option_bandwidth.on_change = [this](size_t, uint32_t base_rate) {
-		sampling_rate = 8 * base_rate;	// Decimation by 8 done on baseband side
+		// Full-rate C8 is recorded straight from the baseband DMA
+		direct = (base_rate >= direct_rate_min);
+		sampling_rate = direct ? base_rate : (8 * base_rate);	// Decimation by 8 done on baseband side
 		
 		waterfall.on_hide();
+		// The format only applies to decimated captures
+		if( option_format.hidden() != direct ) {
+			labels_format.hidden(direct);
+			option_format.hidden(direct);
+			set_dirty();
+		}
+		update_file_type();
 		record_view.set_sampling_rate(sampling_rate);
 		receiver_model.set_sampling_rate(sampling_rate);
+		receiver_model.set_baseband_bandwidth(direct ? (sampling_rate * 3 / 4) : baseband_bandwidth);
 		waterfall.on_show();
 	};
 	
+	option_format.on_change = [this](size_t, OptionsField::value_t v) {
+		decimated_file_type = static_cast<RecordView::FileType>(v);
+		update_file_type();
+	};
+	
 	option_bandwidth.set_selected_index(7);		// 500k
 	
 	receiver_model.set_modulation(ReceiverModel::Mode::Capture);
@@ -123,6 +140,10 @@ void CaptureAppView::focus() {
 	record_view.focus();
 }
 
+void CaptureAppView::update_file_type() {
+	record_view.set_file_type(direct ? RecordView::FileType::RawS8 : decimated_file_type);
+}
+
 void CaptureAppView::on_tuning_frequency_changed(rf::Frequency f) {
 	receiver_model.set_tuning_frequency(f);
 }
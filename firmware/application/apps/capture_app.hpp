@@ -48,13 +48,21 @@ private:
 	static constexpr ui::Dim header_height = 3 * 16;
 
 	uint32_t sampling_rate = 0;
+	bool direct { false };
+	RecordView::FileType decimated_file_type { RecordView::FileType::RawS16 };
 	static constexpr uint32_t baseband_bandwidth = 2500000;
+	static constexpr uint32_t direct_rate_min = 2000000;
 
 	void on_tuning_frequency_changed(rf::Frequency f);
+	void update_file_type();
 
 	Labels labels {
 		{ { 0 * 8, 1 * 16 }, "Rate:", Color::light_grey() },
 	};
+
+	Labels labels_format {
+		{ { 11 * 8, 1 * 16 }, "Fmt:", Color::light_grey() },
+	};
 	
 	RSSI rssi {
 		{ 24 * 8, 0, 6 * 8, 4 },
@@ -95,7 +103,20 @@ private:
 			{ " 50k ", 50000 },
 			{ "100k ", 100000 },
 			{ "250k ", 250000 },
-			{ "500k ", 500000 }
+			{ "500k ", 500000 },
+			{ "2M C8", 2000000 },
+			{ "4M C8", 4000000 },
+			{ "5M C8", 5000000 }
+		}
+	};
+	
+	// Decimated rates only, hidden at full rate where captures are always C8
+	OptionsField option_format {
+		{ 15 * 8, 1 * 16 },
+		3,
+		{
+			{ "C16", RecordView::FileType::RawS16 },
+			{ "CBF", RecordView::FileType::RawBFP }
 		}
 	};
 	
@@ -61,6 +61,10 @@ struct ERTKey {
 	}
 };
 
+inline uint32_t recent_entry_hash(const ERTKey& key) {
+	return key.id ^ (key.commodity_type << 24);
+}
+
 struct ERTRecentEntry {
 	using Key = ERTKey;
 
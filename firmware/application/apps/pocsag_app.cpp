@@ -102,11 +102,12 @@ POCSAGAppView::POCSAGAppView(NavigationView& nav) {
 	options_bitrate.on_change = [this](size_t, OptionsField::value_t v) {
 		on_config_changed(v, options_phase.selected_index_value());
 	};
-	options_bitrate.set_selected_index(1);	// 1200bps
+	options_bitrate.set_selected_index(0);	// Auto
 	
 	options_phase.on_change = [this](size_t, OptionsField::value_t v) {
 		on_config_changed(options_bitrate.selected_index_value(),v);
 	};
+	on_config_changed(options_bitrate.selected_index_value(), options_phase.selected_index_value());
 	check_ignore.set_value(ignore);
 	check_ignore.on_select = [this](Checkbox&, bool v) {
 		ignore = v;
@@ -202,7 +203,11 @@ void POCSAGAppView::on_packet(const POCSAGPacketMessage * message) {
 }
 
 void POCSAGAppView::on_config_changed(const uint32_t new_bitrate, bool new_phase) {
-	baseband::set_pocsag(pocsag_bitrates[new_bitrate], new_phase);
+	// Auto: the baseband decodes all bit rates at once and tags each batch
+	if (new_bitrate < 3)
+		baseband::set_pocsag(pocsag_bitrates[new_bitrate], new_phase);
+	else
+		baseband::set_pocsag(pocsag::BitRate::UNKNOWN, new_phase);
 }
 
 void POCSAGAppView::set_target_frequency(const uint32_t new_value) {
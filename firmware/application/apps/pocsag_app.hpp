@@ -88,6 +88,7 @@ private:
 		{ 12 * 8, 21 },
 		7,
 		{
+			{ "Auto   ", 3 },
 			{ "512bps ", 0 },
 			{ "1200bps", 1 },
 			{ "2400bps", 2 }
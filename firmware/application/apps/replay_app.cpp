@@ -27,6 +27,7 @@
 #include "io_file.hpp"
 
 #include "baseband_api.hpp"
+#include "iq_bfp.hpp"
 #include "portapack.hpp"
 #include "portapack_persistent_memory.hpp"
 
@@ -51,6 +52,12 @@ void ReplayAppView::on_file_changed(std::filesystem::path new_file_path) {
 	
 	file_path = new_file_path;
 	
+	// Block floating point capture, decoded on baseband side
+	auto extension = file_path.extension().string();
+	for (auto &c: extension)
+		c = toupper(c);
+	file_format = (extension == ".CBF") ? ReplayConfig::Format::BFP8 : ReplayConfig::Format::C16;
+	
 	// Get original record frequency if available
 	std::filesystem::path info_file_path = file_path;
 	info_file_path.replace_extension(u".TXT");
@@ -79,7 +86,9 @@ void ReplayAppView::on_file_changed(std::filesystem::path new_file_path) {
 	text_sample_rate.set(unit_auto_scale(sample_rate, 3, 0) + "Hz");
 	
 	auto file_size = data_file.size();
-	auto duration = (file_size * 1000) / (2 * 2 * sample_rate);
+	auto duration = (file_format == ReplayConfig::Format::BFP8) ?
+		(file_size * 1000 * iq_bfp::block_samples_max) / (iq_bfp::block_bytes_max * sample_rate) :
+		(file_size * 1000) / (2 * 2 * sample_rate);
 	
 	progressbar.set_max(file_size);
 	text_filename.set(file_path.filename().string().substr(0, 12));
@@ -136,7 +145,8 @@ void ReplayAppView::start() {
 			[](uint32_t return_code) {
 				ReplayThreadDoneMessage message { return_code };
 				EventDispatcher::send_message(message);
-			}
+			},
+			file_format
 		);
 	}
 	
@@ -218,7 +228,7 @@ ReplayAppView::ReplayAppView(
 	};
 	
 	button_open.on_select = [this, &nav](Button&) {
-		auto open_view = nav.push<FileLoadView>(".C16");
+		auto open_view = nav.push<FileLoadView>(".C16|.CBF");
 		open_view->on_changed = [this](std::filesystem::path new_file_path) {
 			on_file_changed(new_file_path);
 		};
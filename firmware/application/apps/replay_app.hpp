@@ -71,6 +71,7 @@ private:
 	void file_error();
 
 	std::filesystem::path file_path { };
+	ReplayConfig::Format file_format { ReplayConfig::Format::C16 };
 	std::unique_ptr<ReplayThread> replay_thread { };
 	bool ready_signal { false };
 
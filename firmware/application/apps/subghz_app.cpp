@@ -0,0 +1,210 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "subghz_app.hpp"
+
+#include "baseband_api.hpp"
+
+#include "portapack.hpp"
+using namespace portapack;
+
+#include "rtc_time.hpp"
+#include "string_format.hpp"
+
+#include "utility.hpp"
+
+namespace subghz {
+
+namespace format {
+
+static std::string protocol(const Protocol value) {
+	switch(value) {
+	case Protocol::ERT:			return "ERT";
+	case Protocol::TPMS:		return "TPMS";
+	case Protocol::OOKRemote:	return "OOK";
+	default:					return "???";
+	}
+}
+
+} /* namespace format */
+
+} /* namespace subghz */
+
+void SubGHzLogger::on_packet(const std::string& entry) {
+	rtc::RTC datetime;
+	rtcGetTime(&RTCD1, &datetime);
+
+	log_file.write_entry(datetime, entry);
+}
+
+const SubGHzRecentEntry::Key SubGHzRecentEntry::invalid_key { subghz::Protocol::None, 0 };
+
+void SubGHzRecentEntry::update(const std::string& data) {
+	received_count++;
+
+	last_data = data;
+}
+
+namespace ui {
+
+template<>
+void RecentEntriesTable<SubGHzRecentEntries>::draw(
+	const Entry& entry,
+	const Rect& target_rect,
+	Painter& painter,
+	const Style& style
+) {
+	std::string line = subghz::format::protocol(entry.protocol);
+	line.resize(4, ' ');
+
+	std::string data = entry.last_data;
+	data.resize(21, ' ');
+	line += " " + data;
+
+	if( entry.received_count > 999 ) {
+		line += " +++";
+	} else {
+		line += " " + to_string_dec_uint(entry.received_count, 3);
+	}
+
+	line.resize(target_rect.width() / 8, ' ');
+	painter.draw_string(target_rect.location(), style, line);
+}
+
+SubGHzAppView::SubGHzAppView(NavigationView&) {
+	baseband::run_image(portapack::spi_flash::image_tag_subghz);
+
+	add_children({
+		&rssi,
+		&channel,
+		&options_band,
+		&field_rf_amp,
+		&field_lna,
+		&field_vga,
+		&recent_entries_view,
+	});
+
+	radio::enable({
+		tuning_frequency(),
+		sampling_rate,
+		baseband_bandwidth,
+		rf::Direction::Receive,
+		receiver_model.rf_amp(),
+		static_cast<int8_t>(receiver_model.lna()),
+		static_cast<int8_t>(receiver_model.vga()),
+	});
+
+	options_band.on_change = [this](size_t, OptionsField::value_t v) {
+		this->on_band_changed(v);
+	};
+	options_band.set_by_value(target_frequency());
+
+	logger = std::make_unique<SubGHzLogger>();
+	if( logger ) {
+		logger->append(u"subghz.txt");
+	}
+}
+
+SubGHzAppView::~SubGHzAppView() {
+	radio::disable();
+
+	baseband::shutdown();
+}
+
+void SubGHzAppView::focus() {
+	options_band.focus();
+}
+
+void SubGHzAppView::set_parent_rect(const Rect new_parent_rect) {
+	View::set_parent_rect(new_parent_rect);
+	recent_entries_view.set_parent_rect({ 0, header_height, new_parent_rect.width(), new_parent_rect.height() - header_height });
+}
+
+void SubGHzAppView::on_packet(const ert::Packet& packet) {
+	if( logger ) {
+		const auto formatted = packet.symbols_formatted();
+		logger->on_packet("ERT " + formatted.data + "/" + formatted.errors);
+	}
+
+	if( packet.crc_ok() ) {
+		const uint64_t id = (static_cast<uint64_t>(packet.commodity_type()) << 32) | packet.id();
+		on_entry(
+			{ subghz::Protocol::ERT, id },
+			to_string_dec_uint(packet.id(), 10) + " " + to_string_dec_uint(packet.consumption(), 10)
+		);
+	}
+}
+
+void SubGHzAppView::on_packet(const tpms::Packet& packet) {
+	if( logger ) {
+		const auto formatted = packet.symbols_formatted();
+		logger->on_packet("TPMS " + to_string_dec_uint(packet.signal_type(), 1) + " " + formatted.data + "/" + formatted.errors);
+	}
+
+	const auto reading_opt = packet.reading();
+	if( reading_opt.is_valid() ) {
+		const auto reading = reading_opt.value();
+		const uint64_t id = (static_cast<uint64_t>(reading.type()) << 32) | reading.id().value();
+
+		std::string data = to_string_hex(reading.id().value(), 8);
+		if( reading.pressure().is_valid() ) {
+			data += " " + to_string_dec_int(reading.pressure().value().kilopascal(), 3) + "kPa";
+		}
+		if( reading.temperature().is_valid() ) {
+			data += " " + to_string_dec_int(reading.temperature().value().celsius(), 3) + "C";
+		}
+		on_entry({ subghz::Protocol::TPMS, id }, data);
+	}
+}
+
+void SubGHzAppView::on_packet(const OOKRemotePacketMessage& message) {
+	const auto code = to_string_hex(message.code, (message.bit_count + 3) / 4);
+	const auto bits = to_string_dec_uint(message.bit_count) + "b";
+
+	if( logger ) {
+		logger->on_packet("OOK " + code + " " + bits + " " + to_string_dec_uint(message.short_pulse_us) + "us");
+	}
+
+	on_entry({ subghz::Protocol::OOKRemote, message.code }, code + " " + bits);
+}
+
+void SubGHzAppView::on_entry(const SubGHzRecentEntry::Key& key, const std::string& data) {
+	auto& entry = ::on_packet(recent, key);
+	entry.update(data);
+	recent_entries_view.set_dirty();
+}
+
+void SubGHzAppView::on_band_changed(const uint32_t new_band_frequency) {
+	set_target_frequency(new_band_frequency);
+}
+
+void SubGHzAppView::set_target_frequency(const uint32_t new_value) {
+	target_frequency_ = new_value;
+	radio::set_tuning_frequency(tuning_frequency());
+}
+
+uint32_t SubGHzAppView::target_frequency() const {
+	return target_frequency_;
+}
+
+uint32_t SubGHzAppView::tuning_frequency() const {
+	return target_frequency() - (sampling_rate / 4);
+}
+
+} /* namespace ui */
@@ -0,0 +1,211 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SUBGHZ_APP_H__
+#define __SUBGHZ_APP_H__
+
+#include "ui_widget.hpp"
+#include "ui_navigation.hpp"
+#include "ui_receiver.hpp"
+#include "ui_rssi.hpp"
+#include "ui_channel.hpp"
+
+#include "event_m0.hpp"
+
+#include "log_file.hpp"
+
+#include "recent_entries.hpp"
+
+#include "ert_packet.hpp"
+#include "tpms_packet.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace subghz {
+
+enum class Protocol : uint32_t {
+	None = 0,
+	ERT = 1,
+	TPMS = 2,
+	OOKRemote = 3,
+};
+
+/* OOK remote codes can use all 64 bits, so the protocol is kept apart from
+ * the ID rather than packed into it.
+ */
+inline uint32_t recent_entry_hash(const std::pair<Protocol, uint64_t>& key) {
+	return static_cast<uint32_t>(key.second ^ (key.second >> 32)) ^ (static_cast<uint32_t>(key.first) << 28);
+}
+
+} /* namespace subghz */
+
+struct SubGHzRecentEntry {
+	using Key = std::pair<subghz::Protocol, uint64_t>;
+
+	static const Key invalid_key;
+
+	subghz::Protocol protocol { invalid_key.first };
+	uint64_t id { invalid_key.second };
+
+	size_t received_count { 0 };
+
+	std::string last_data { };
+
+	SubGHzRecentEntry(
+		const Key& key
+	) : protocol { key.first },
+		id { key.second }
+	{
+	}
+
+	Key key() const {
+		return { protocol, id };
+	}
+
+	void update(const std::string& data);
+};
+
+using SubGHzRecentEntries = RecentEntries<SubGHzRecentEntry>;
+
+class SubGHzLogger {
+public:
+	Optional<File::Error> append(const std::filesystem::path& filename) {
+		return log_file.append(filename);
+	}
+
+	void on_packet(const std::string& entry);
+
+private:
+	LogFile log_file { };
+};
+
+namespace ui {
+
+using SubGHzRecentEntriesView = RecentEntriesView<SubGHzRecentEntries>;
+
+class SubGHzAppView : public View {
+public:
+	SubGHzAppView(NavigationView& nav);
+	~SubGHzAppView();
+
+	void set_parent_rect(const Rect new_parent_rect) override;
+
+	// Prevent painting of region covered entirely by a child.
+	// TODO: Add flag to View that specifies view does not need to be cleared before painting.
+	void paint(Painter&) override { };
+
+	void focus() override;
+
+	std::string title() const override { return "Sub-GHz"; };
+
+private:
+	static constexpr uint32_t initial_target_frequency = 433920000;
+	static constexpr uint32_t sampling_rate = 4915200;
+	static constexpr uint32_t baseband_bandwidth = 3500000;
+
+	MessageHandlerRegistration message_handler_ert_packet {
+		Message::ID::ERTPacket,
+		[this](Message* const p) {
+			const auto message = static_cast<const ERTPacketMessage*>(p);
+			const ert::Packet packet { message->type, message->packet };
+			this->on_packet(packet);
+		}
+	};
+
+	MessageHandlerRegistration message_handler_tpms_packet {
+		Message::ID::TPMSPacket,
+		[this](Message* const p) {
+			const auto message = static_cast<const TPMSPacketMessage*>(p);
+			const tpms::Packet packet { message->packet, message->signal_type };
+			this->on_packet(packet);
+		}
+	};
+
+	MessageHandlerRegistration message_handler_ook_remote_packet {
+		Message::ID::OOKRemotePacket,
+		[this](Message* const p) {
+			const auto message = static_cast<const OOKRemotePacketMessage*>(p);
+			this->on_packet(*message);
+		}
+	};
+
+	static constexpr ui::Dim header_height = 1 * 16;
+
+	RSSI rssi {
+		{ 21 * 8, 0, 6 * 8, 4 },
+	};
+
+	Channel channel {
+		{ 21 * 8, 5, 6 * 8, 4 },
+	};
+
+	OptionsField options_band {
+		{ 0 * 8, 0 * 16 },
+		3,
+		{
+			{ "315", 315000000 },
+			{ "434", 433920000 },
+			{ "868", 868350000 },
+			{ "915", 911600000 },
+		}
+	};
+
+	RFAmpField field_rf_amp {
+		{ 13 * 8, 0 * 16 }
+	};
+
+	LNAGainField field_lna {
+		{ 15 * 8, 0 * 16 }
+	};
+
+	VGAGainField field_vga {
+		{ 18 * 8, 0 * 16 }
+	};
+
+	SubGHzRecentEntries recent { };
+	std::unique_ptr<SubGHzLogger> logger { };
+
+	const RecentEntriesColumns columns { {
+		{ "Tp", 4 },
+		{ "ID/Data", 21 },
+		{ "Cnt", 3 },
+	} };
+	SubGHzRecentEntriesView recent_entries_view { columns, recent };
+
+	uint32_t target_frequency_ = initial_target_frequency;
+
+	void on_packet(const ert::Packet& packet);
+	void on_packet(const tpms::Packet& packet);
+	void on_packet(const OOKRemotePacketMessage& message);
+	void on_entry(const SubGHzRecentEntry::Key& key, const std::string& data);
+
+	void on_band_changed(const uint32_t new_band_frequency);
+
+	uint32_t target_frequency() const;
+	void set_target_frequency(const uint32_t new_value);
+
+	uint32_t tuning_frequency() const;
+};
+
+} /* namespace ui */
+
+#endif/*__SUBGHZ_APP_H__*/
@@ -44,6 +44,14 @@ constexpr bool operator==(const tpms::TransponderID& lhs, const tpms::Transponde
 
 } /* namespace std */
 
+namespace tpms {
+
+inline uint32_t recent_entry_hash(const std::pair<Reading::Type, TransponderID>& key) {
+	return key.second.value() ^ (key.first << 24);
+}
+
+} /* namespace tpms */
+
 struct TPMSRecentEntry {
 	using Key = std::pair<tpms::Reading::Type, tpms::TransponderID>;
 
@@ -28,6 +28,9 @@
 #include "baseband_api.hpp"
 #include "portapack_persistent_memory.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace portapack;
 
 namespace ui {
@@ -78,6 +81,96 @@ void ADSBLogger::log_str(std::string& logline) {
 	log_file.write_entry(datetime,logline);
 }
 
+uint32_t AirlinesDB::pack_code(const char* const code) {
+	// Big-endian, so numeric order is the file's (strcmp) order.
+	return (uint8_t(code[0]) << 16) | (uint8_t(code[1]) << 8) | uint8_t(code[2]);
+}
+
+bool AirlinesDB::open(const std::filesystem::path& path) {
+	if (loaded)
+		return true;
+
+	if (file.open(path).is_valid())
+		return false;
+
+	// One record per code, the file size gives the count.
+	const auto size = file.size();
+	if (size > records_offset)
+		codes.reserve((size - records_offset) / record_size);
+
+	std::array<char, 256> block;
+	for (File::Offset offset = 0; offset < records_offset; offset += block.size()) {
+		const auto read = file.read(block.data(), block.size());
+		if (read.is_error() || (read.value() != block.size())) {
+			codes.clear();
+			return false;
+		}
+
+		for (size_t i = 0; i < block.size(); i += 4) {
+			if (!block[i]) {
+				loaded = true;
+				return true;
+			}
+
+			const auto code = pack_code(&block[i]);
+			if (!codes.empty() && (code < codes.back()))
+				sorted = false;
+			codes.push_back(code);
+		}
+	}
+
+	loaded = true;
+	return true;
+}
+
+int32_t AirlinesDB::index_of(const uint32_t code) const {
+	if (sorted) {
+		const auto it = std::lower_bound(codes.begin(), codes.end(), code);
+		if ((it != codes.end()) && (*it == code))
+			return it - codes.begin();
+	} else {
+		// Hand-made file, still in RAM at least.
+		const auto it = std::find(codes.begin(), codes.end(), code);
+		if (it != codes.end())
+			return it - codes.begin();
+	}
+	return -1;
+}
+
+const AirlinesDB::Airline* AirlinesDB::find(const std::string& callsign) {
+	if (!loaded || (callsign.size() < 3))
+		return nullptr;
+
+	const auto code = pack_code(callsign.c_str());
+
+	for (auto it = cache.begin(); it != cache.end(); ++it) {
+		if (it->code == code) {
+			cache.splice(cache.begin(), cache, it);
+			return &cache.front();
+		}
+	}
+
+	const auto index = index_of(code);
+	if (index < 0)
+		return nullptr;
+
+	char record[record_size];
+	if (file.seek(records_offset + index * record_size).is_error())
+		return nullptr;
+	const auto read = file.read(record, record_size);
+	if (read.is_error() || (read.value() != record_size))
+		return nullptr;
+
+	// Fields are zero-padded, but don't count on a terminator.
+	std::string name { &record[0], strnlen(&record[0], 32) };
+	std::string country { &record[32], strnlen(&record[32], 32) };
+
+	if (cache.size() >= cache_size)
+		cache.pop_back();
+	cache.push_front({ code, name, country });
+	return &cache.front();
+}
+
 void ADSBRxDetailsView::focus() {
 	button_see_map.focus();
 }
@@ -111,15 +204,11 @@ ADSBRxDetailsView::~ADSBRxDetailsView() {
 ADSBRxDetailsView::ADSBRxDetailsView(
 	NavigationView& nav,
 	const AircraftRecentEntry& entry,
+	AirlinesDB& airlines_db,
 	const std::function<void(void)> on_close
 ) : entry_copy(entry),
 	on_close_(on_close)
 {
-	char file_buffer[32] { 0 };
-	bool found = false;
-	std::string airline_code;
-	size_t c;
-	
 	add_children({
 		&labels,
 		&text_callsign,
@@ -133,32 +222,15 @@ ADSBRxDetailsView::ADSBRxDetailsView(
 		&button_see_map
 	});
 	
-	std::unique_ptr<ADSBLogger> logger { };
 	update(entry_copy);
 
 	// The following won't (shouldn't !) change for a given airborne aircraft
 	// Try getting the airline's name from airlines.db
-	auto result = db_file.open("ADSB/airlines.db");
-	if (!result.is_valid()) {
-		// Search for 3-letter code in 0x0000~0x2000
-		airline_code = entry_copy.callsign.substr(0, 3);
-		c = 0;
-		do {
-			db_file.read(file_buffer, 4);
-			if (!file_buffer[0])
-				break;
-			if (!airline_code.compare(0, 4, file_buffer))
-				found = true;
-			else
-				c++;
-		} while (!found);
-		
-		if (found) {
-			db_file.seek(0x2000 + (c << 6));
-			db_file.read(file_buffer, 32);
-			text_airline.set(file_buffer);
-			db_file.read(file_buffer, 32);
-			text_country.set(file_buffer);
+	if (airlines_db.open("ADSB/airlines.db")) {
+		const auto airline = airlines_db.find(entry_copy.callsign);
+		if (airline) {
+			text_airline.set(airline->name);
+			text_country.set(airline->country);
 		} else {
 			text_airline.set("Unknown");
 			text_country.set("Unknown");
@@ -294,6 +366,7 @@ ADSBRxView::ADSBRxView(NavigationView& nav) {
 		detailed_entry_key = entry.key();
 		details_view = nav.push<ADSBRxDetailsView>(
 			entry,
+			airlines_db,
 			[this]() {
 				send_updates = false;
 			});
@@ -32,6 +32,9 @@
 #include "adsb.hpp"
 #include "message.hpp"
 
+#include <list>
+#include <vector>
+
 using namespace adsb;
 
 namespace ui {
@@ -122,9 +125,41 @@ private:
 };
 
 
+/* ADSB/airlines.db: 4-byte ICAO airline codes ("AAL\0"), sorted, ending
+ * with a null code before 0x2000, then a 64-byte record (name, country,
+ * 32 bytes each) per code, in the same order.
+ * The codes are read once and binary-searched in RAM, recently resolved
+ * records are kept so reopening details doesn't touch the SD card.
+ */
+class AirlinesDB {
+public:
+	struct Airline {
+		uint32_t code;
+		std::string name;
+		std::string country;
+	};
+
+	bool open(const std::filesystem::path& path);
+	const Airline* find(const std::string& callsign);
+
+private:
+	static constexpr File::Offset records_offset = 0x2000;
+	static constexpr size_t record_size = 64;
+	static constexpr size_t cache_size = 8;
+
+	File file { };
+	bool loaded { false };
+	bool sorted { true };
+	std::vector<uint32_t> codes { };
+	std::list<Airline> cache { };	// Most recently used first
+
+	static uint32_t pack_code(const char* const code);
+	int32_t index_of(const uint32_t code) const;
+};
+
 class ADSBRxDetailsView : public View {
 public:
-	ADSBRxDetailsView(NavigationView&, const AircraftRecentEntry& entry, const std::function<void(void)> on_close);
+	ADSBRxDetailsView(NavigationView&, const AircraftRecentEntry& entry, AirlinesDB& airlines_db, const std::function<void(void)> on_close);
 	~ADSBRxDetailsView();
 
 	ADSBRxDetailsView(const ADSBRxDetailsView&) = delete;
@@ -143,7 +178,6 @@ private:
 	std::function<void(void)> on_close_ { };
 	GeoMapView* geomap_view { nullptr };
 	bool send_updates { false };
-	File db_file { };
 	
 	Labels labels {
 		{ { 0 * 8, 1 * 16 }, "Callsign:", Color::light_grey() },
@@ -225,6 +259,7 @@ private:
 		{ "Time", 8 }
 	} };
 	AircraftRecentEntries recent { };
+	AirlinesDB airlines_db { };
 	RecentEntriesView<RecentEntries<AircraftRecentEntry>> recent_entries_view { columns, recent };
 	
 	SignalToken signal_token_tick_second { };
@@ -0,0 +1,194 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ui_channel_monitor.hpp"
+
+#include "baseband_api.hpp"
+#include "audio.hpp"
+#include "string_format.hpp"
+
+#include "portapack.hpp"
+
+#include <algorithm>
+
+using namespace portapack;
+
+namespace ui {
+
+ChannelMonitorView::ChannelMonitorView(
+	NavigationView& nav
+) : nav_ { nav }
+{
+	baseband::run_image(portapack::spi_flash::image_tag_nfm_channelizer);
+
+	add_children({
+		&labels,
+		&field_lna,
+		&field_vga,
+		&field_rf_amp,
+		&field_volume,
+		&field_frequency,
+		&options_spacing,
+		&field_channels,
+		&field_squelch,
+		&options_listen,
+	});
+
+	for(size_t i=0; i<text_channels.size(); i++) {
+		text_channels[i].set_parent_rect({
+			0 * 8, static_cast<Coord>((3 + i) * 16),
+			30 * 8, 1 * 16
+		});
+		text_channels[i].set_style(&style_closed);
+		add_child(&text_channels[i]);
+	}
+
+	field_volume.set_value((receiver_model.headphone_volume() - audio::headphone::volume_range().max).decibel() + 99);
+	field_volume.on_change = [this](int32_t v) {
+		this->on_headphone_volume_changed(v);
+	};
+
+	field_frequency.set_value(first_frequency);
+	field_frequency.set_step(channel_spacing);
+	field_frequency.on_change = [this](rf::Frequency f) {
+		first_frequency = f;
+		update_config();
+	};
+	field_frequency.on_edit = [this, &nav]() {
+		auto new_view = nav.push<FrequencyKeypadView>(first_frequency);
+		new_view->on_changed = [this](rf::Frequency f) {
+			field_frequency.set_value(f);
+		};
+	};
+
+	options_spacing.set_by_value(channel_spacing);
+	options_spacing.on_change = [this](size_t, OptionsField::value_t v) {
+		channel_spacing = v;
+		field_frequency.set_step(channel_spacing);
+		update_config();
+	};
+
+	field_channels.set_value(channel_count);
+	field_channels.on_change = [this](int32_t v) {
+		channel_count = v;
+		set_listen_options();
+		update_config();
+	};
+
+	field_squelch.set_value(-60);
+	field_squelch.on_change = [this](int32_t) {
+		update_config();
+	};
+
+	set_listen_options();
+	options_listen.on_change = [this](size_t, OptionsField::value_t v) {
+		listen_channel = v;
+		update_config();
+	};
+
+	// Any mode with the -fs/4 tuning offset the channelizer expects. Capture
+	// doesn't send a demodulator configuration to the baseband.
+	receiver_model.set_modulation(ReceiverModel::Mode::Capture);
+	receiver_model.set_baseband_bandwidth(1750000);
+	update_config();
+	receiver_model.enable();
+
+	audio::output::start();
+}
+
+ChannelMonitorView::~ChannelMonitorView() {
+	audio::output::stop();
+
+	receiver_model.set_sampling_rate(3072000);	// Other apps expect the usual rate
+	receiver_model.disable();
+
+	baseband::shutdown();
+}
+
+void ChannelMonitorView::focus() {
+	field_frequency.focus();
+}
+
+rf::Frequency ChannelMonitorView::channel_frequency(const size_t channel) const {
+	return first_frequency + channel * channel_spacing;
+}
+
+void ChannelMonitorView::set_listen_options() {
+	using option_t = std::pair<std::string, int32_t>;
+	using options_t = std::vector<option_t>;
+
+	options_t options { { "Auto", -1 } };
+	for(size_t c=0; c<channel_count; c++) {
+		options.emplace_back(to_string_dec_uint(c + 1, 4), c);
+	}
+	/* set_options() selects the first channel, so restore the choice after. */
+	const int32_t listen = (listen_channel < static_cast<int32_t>(channel_count)) ? listen_channel : -1;
+	options_listen.set_options(options);
+	options_listen.set_by_value(listen);
+	listen_channel = listen;
+}
+
+void ChannelMonitorView::update_config() {
+	/* The channelizer's channels sit either side of the tuned frequency, with
+	 * channel_count / 2 in the middle.
+	 */
+	receiver_model.set_sampling_rate(channel_spacing * ChannelizerConfigureMessage::sampling_rate_per_spacing);
+	receiver_model.set_tuning_frequency(channel_frequency(channel_count / 2));
+
+	baseband::set_channelizer(
+		channel_spacing,
+		channel_count,
+		channel_spacing / 5,
+		field_squelch.value(),
+		listen_channel
+	);
+
+	for(size_t c=0; c<text_channels.size(); c++) {
+		text_channels[c].set_style(&style_closed);
+		text_channels[c].set((c < channel_count) ? (to_string_dec_uint(c + 1, 2) + to_string_short_freq(channel_frequency(c))) : "");
+	}
+}
+
+void ChannelMonitorView::on_status(const ChannelizerStatus& status) {
+	constexpr int32_t bar_db_min = -90;
+	constexpr size_t bar_length = 11;
+
+	for(size_t c=0; c<channel_count; c++) {
+		const int32_t max_db = status.max_db[c];
+		const size_t bar = std::min(static_cast<size_t>(std::max(max_db - bar_db_min, 0) * bar_length / -bar_db_min), bar_length);
+
+		text_channels[c].set_style(
+			(status.audio_channel == static_cast<int32_t>(c)) ? &style_listening :
+			((status.squelch_open & (1U << c)) ? &style_open : &style_closed)
+		);
+		text_channels[c].set(
+			to_string_dec_uint(c + 1, 2)
+			+ to_string_short_freq(channel_frequency(c))
+			+ " " + to_string_dec_int(max_db, 4) + "dB "
+			+ std::string(bar, '|')
+		);
+	}
+}
+
+void ChannelMonitorView::on_headphone_volume_changed(int32_t v) {
+	const auto new_volume = volume_t::decibel(v - 99) + audio::headphone::volume_range().max;
+	receiver_model.set_headphone_volume(new_volume);
+}
+
+} /* namespace ui */
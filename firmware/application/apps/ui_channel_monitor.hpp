@@ -0,0 +1,160 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __UI_CHANNEL_MONITOR_H__
+#define __UI_CHANNEL_MONITOR_H__
+
+#include "ui.hpp"
+#include "ui_widget.hpp"
+#include "ui_navigation.hpp"
+#include "ui_receiver.hpp"
+#include "ui_font_fixed_8x16.hpp"
+
+#include "message.hpp"
+#include "rf_path.hpp"
+
+#include <array>
+
+namespace ui {
+
+/* Watches a block of adjacent NFM channels with the polyphase channelizer
+ * baseband, instead of stepping the radio through them one at a time.
+ */
+class ChannelMonitorView : public View {
+public:
+	ChannelMonitorView(NavigationView& nav);
+	~ChannelMonitorView();
+
+	void focus() override;
+
+	std::string title() const override { return "Ch. monitor"; };
+
+private:
+	static constexpr size_t channels_max = ChannelizerConfigureMessage::channels_max;
+	static constexpr rf::Frequency initial_first_frequency = 446006250;	// PMR446 channel 1
+
+	NavigationView& nav_;
+
+	rf::Frequency first_frequency { initial_first_frequency };
+	size_t channel_count { channels_max };
+	uint32_t channel_spacing { 12500 };
+	int32_t listen_channel { -1 };
+
+	const Style style_closed {
+		.font = font::fixed_8x16,
+		.background = Color::black(),
+		.foreground = Color::grey(),
+	};
+
+	const Style style_open {
+		.font = font::fixed_8x16,
+		.background = Color::black(),
+		.foreground = Color::green(),
+	};
+
+	const Style style_listening {
+		.font = font::fixed_8x16,
+		.background = Color::black(),
+		.foreground = Color::yellow(),
+	};
+
+	Labels labels {
+		{ { 0 * 8, 0 * 16 }, "LNA:   VGA:   AMP:  VOL:", Color::light_grey() },
+		{ { 0 * 8, 1 * 16 }, "F:", Color::light_grey() },
+		{ { 13 * 8, 1 * 16 }, "SP:", Color::light_grey() },
+		{ { 22 * 8, 1 * 16 }, "CH:", Color::light_grey() },
+		{ { 0 * 8, 2 * 16 }, "SQ:   dB", Color::light_grey() },
+		{ { 9 * 8, 2 * 16 }, "LISTEN:", Color::light_grey() },
+	};
+
+	LNAGainField field_lna {
+		{ 4 * 8, 0 * 16 }
+	};
+
+	VGAGainField field_vga {
+		{ 11 * 8, 0 * 16 }
+	};
+
+	RFAmpField field_rf_amp {
+		{ 18 * 8, 0 * 16 }
+	};
+
+	NumberField field_volume {
+		{ 24 * 8, 0 * 16 },
+		2,
+		{ 0, 99 },
+		1,
+		' ',
+	};
+
+	FrequencyField field_frequency {
+		{ 2 * 8, 1 * 16 },
+	};
+
+	OptionsField options_spacing {
+		{ 16 * 8, 1 * 16 },
+		5,
+		{
+			{ "12.5k", 12500 },
+			{ "25k  ", 25000 },
+		}
+	};
+
+	NumberField field_channels {
+		{ 25 * 8, 1 * 16 },
+		2,
+		{ 2, channels_max },
+		1,
+		' ',
+	};
+
+	NumberField field_squelch {
+		{ 3 * 8, 2 * 16 },
+		3,
+		{ -90, 0 },
+		1,
+		' ',
+	};
+
+	OptionsField options_listen {
+		{ 16 * 8, 2 * 16 },
+		4,
+		{ }
+	};
+
+	std::array<Text, channels_max> text_channels { };
+
+	rf::Frequency channel_frequency(const size_t channel) const;
+
+	void set_listen_options();
+	void update_config();
+	void on_status(const ChannelizerStatus& status);
+	void on_headphone_volume_changed(int32_t v);
+
+	MessageHandlerRegistration message_handler_status {
+		Message::ID::ChannelizerStatus,
+		[this](const Message* const p) {
+			this->on_status(static_cast<const ChannelizerStatusMessage*>(p)->status);
+		}
+	};
+};
+
+} /* namespace ui */
+
+#endif/*__UI_CHANNEL_MONITOR_H__*/
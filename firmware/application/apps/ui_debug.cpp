@@ -28,6 +28,8 @@
 #include "string_format.hpp"
 
 #include "audio.hpp"
+#include "baseband_api.hpp"
+#include "portapack_shared_memory.hpp"
 
 #include "ui_sd_card_debug.hpp"
 
@@ -49,6 +51,10 @@ DebugMemoryView::DebugMemoryView(NavigationView& nav) {
 		&text_label_m0_heap_fragmented_free_value,
 		&text_label_m0_heap_fragments,
 		&text_label_m0_heap_fragments_value,
+		&text_label_queue_high_water,
+		&text_label_queue_high_water_value,
+		&text_label_queue_rejected,
+		&text_label_queue_rejected_value,
 		&button_done
 	});
 
@@ -60,6 +66,9 @@ DebugMemoryView::DebugMemoryView(NavigationView& nav) {
 	text_label_m0_heap_fragmented_free_value.set(to_string_dec_uint(m0_fragmented_free_space, 5));
 	text_label_m0_heap_fragments_value.set(to_string_dec_uint(m0_fragments, 5));
 
+	text_label_queue_high_water_value.set(to_string_dec_uint(shared_memory.application_queue.high_water(), 5));
+	text_label_queue_rejected_value.set(to_string_dec_uint(shared_memory.application_queue.rejected(), 5));
+
 	button_done.on_select = [&nav](Button&){ nav.pop(); };
 }
 
@@ -357,10 +366,76 @@ DebugMenuView::DebugMenuView(NavigationView& nav) {
 		{ "Peripherals",	ui::Color::dark_cyan(),	&bitmap_icon_peripherals,	[&nav](){ nav.push<DebugPeripheralsMenuView>(); } },
 		{ "Temperature",	ui::Color::dark_cyan(),	&bitmap_icon_temperature,	[&nav](){ nav.push<TemperatureView>(); } },
 		{ "Controls",		ui::Color::dark_cyan(),	&bitmap_icon_controls,		[&nav](){ nav.push<DebugControlsView>(); } },
+		{ "Baseband load",	ui::Color::dark_cyan(),	nullptr,					[&nav](){ nav.push<DebugBasebandView>(); } },
 	});
 	set_max_rows(1); // allow wider buttons
 }
 
+/* DebugBasebandView ****************************************************/
+
+DebugBasebandView::DebugBasebandView(NavigationView& nav) {
+	add_children({
+		&labels,
+		&options_mode,
+		&text_frequency,
+		&stats_view,
+		&button_done
+	});
+
+	stats_view.set_parent_rect({ 0, 2 * 16, 240, 9 * 16 });
+
+	text_frequency.set(to_string_short_freq(receiver_model.tuning_frequency()) + "MHz");
+
+	options_mode.on_change = [this](size_t, OptionsField::value_t v) {
+		this->set_mode(static_cast<ReceiverModel::Mode>(v));
+	};
+	set_mode(ReceiverModel::Mode::NarrowbandFMAudio);
+
+	button_done.on_select = [&nav](Button&){ nav.pop(); };
+}
+
+DebugBasebandView::~DebugBasebandView() {
+	receiver_model.disable();
+	baseband::shutdown();
+}
+
+void DebugBasebandView::set_mode(const ReceiverModel::Mode mode) {
+	receiver_model.disable();
+	baseband::shutdown();
+
+	switch(mode) {
+	case ReceiverModel::Mode::NarrowbandFMAudio:
+		baseband::run_image(portapack::spi_flash::image_tag_nfm_audio);
+		receiver_model.set_modulation(mode);
+		receiver_model.set_sampling_rate(3072000);
+		receiver_model.set_baseband_bandwidth(1750000);
+		break;
+
+	case ReceiverModel::Mode::AMAudio:
+		baseband::run_image(portapack::spi_flash::image_tag_am_audio);
+		receiver_model.set_modulation(mode);
+		receiver_model.set_sampling_rate(3072000);
+		receiver_model.set_baseband_bandwidth(1750000);
+		break;
+
+	case ReceiverModel::Mode::WidebandFMAudio:
+		baseband::run_image(portapack::spi_flash::image_tag_wfm_audio);
+		receiver_model.set_modulation(mode);
+		receiver_model.set_sampling_rate(3072000);
+		receiver_model.set_baseband_bandwidth(2000000);
+		break;
+
+	default:
+		return;
+	}
+
+	receiver_model.enable();
+}
+
+void DebugBasebandView::focus() {
+	options_mode.focus();
+}
+
 /*DebugLCRView::DebugLCRView(NavigationView& nav, std::string lcr_string) {
 	
 	std::string debug_text;
@@ -27,10 +27,12 @@
 #include "ui_painter.hpp"
 #include "ui_menu.hpp"
 #include "ui_navigation.hpp"
+#include "ui_baseband_stats_view.hpp"
 
 #include "rffc507x.hpp"
 #include "max2837.hpp"
 #include "portapack.hpp"
+#include "receiver_model.hpp"
 
 #include <functional>
 #include <utility>
@@ -76,8 +78,26 @@ private:
 		{ 200, 160, 40, 16 },
 	};
 
+	Text text_label_queue_high_water {
+		{ 0, 176, 160, 16 },
+		"App Queue Peak Bytes",
+	};
+
+	Text text_label_queue_high_water_value {
+		{ 200, 176, 40, 16 },
+	};
+
+	Text text_label_queue_rejected {
+		{ 0, 192, 144, 16 },
+		"App Queue Rejected",
+	};
+
+	Text text_label_queue_rejected_value {
+		{ 200, 192, 40, 16 },
+	};
+
 	Button button_done {
-		{ 72, 192, 96, 24 },
+		{ 72, 224, 96, 24 },
 		"Done"
 	};
 };
@@ -268,6 +288,46 @@ private:
 	};
 };
 
+class DebugBasebandView : public View {
+public:
+	explicit DebugBasebandView(NavigationView& nav);
+	~DebugBasebandView();
+
+	void focus() override;
+
+	std::string title() const override { return "Baseband load"; };
+
+private:
+	void set_mode(const ReceiverModel::Mode mode);
+
+	Labels labels {
+		{ { 0 * 8, 0 * 16 }, "Mode:", Color::light_grey() },
+		{ { 11 * 8, 0 * 16 }, "at", Color::light_grey() }
+	};
+
+	OptionsField options_mode {
+		{ 6 * 8, 0 * 16 },
+		4,
+		{
+			{ "NFM ", toUType(ReceiverModel::Mode::NarrowbandFMAudio) },
+			{ "AM  ", toUType(ReceiverModel::Mode::AMAudio) },
+			{ "WFM ", toUType(ReceiverModel::Mode::WidebandFMAudio) },
+		}
+	};
+
+	Text text_frequency {
+		{ 14 * 8, 0 * 16, 16 * 8, 16 },
+		"",
+	};
+
+	BasebandStatsView stats_view { };
+
+	Button button_done {
+		{ 72, 264, 96, 24 },
+		"Done"
+	};
+};
+
 /*class DebugLCRView : public View {
 public:
 	DebugLCRView(NavigationView& nav, std::string lcrstring);
@@ -54,7 +54,8 @@ void FileManBaseView::load_directory_contents(const std::filesystem::path& dir_p
 					for (auto &c: entry_extension)
 						c = toupper(c);
 					
-					if (entry_extension != extension_filter)
+					// The filter can list several extensions, separated by '|'
+					if (("|" + extension_filter + "|").find("|" + entry_extension + "|") == std::string::npos)
 						matched = false;
 				}
 				
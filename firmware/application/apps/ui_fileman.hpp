@@ -69,6 +69,7 @@ protected:
 		{ ".BMP", &bitmap_icon_file_image, ui::Color::green() },
 		{ ".C8",  &bitmap_icon_file_iq, ui::Color::blue() },
 		{ ".C16", &bitmap_icon_file_iq, ui::Color::blue() },
+		{ ".CBF", &bitmap_icon_file_iq, ui::Color::blue() },
 		{ ".WAV", &bitmap_icon_file_wav, ui::Color::dark_magenta() },
 		{ "", &bitmap_icon_file, ui::Color::light_grey() }
 	};
@@ -96,7 +96,7 @@ void ScannerThread::run() {
 								frequency_index = frequency_list_.size();	
 							frequency_index--;
 						}
-						receiver_model.set_tuning_frequency(frequency_list_[frequency_index]);	// Retune
+						receiver_model.fast_tune(frequency_list_[frequency_index]);	// Retune, not persisted
 					}
 					else
 						restart_scan=false;			//Effectively skipping first retuning, giving system time
@@ -153,6 +153,8 @@ void ScannerView::focus() {
 }
 
 ScannerView::~ScannerView() {
+	if (current_index < frequency_list.size())	//Leave the last scanned freq for the next app, fast_tune() didn't store it
+		persistent_memory::set_tuned_frequency(frequency_list[current_index]);
 	audio::output::stop();
 	receiver_model.disable();
 	baseband::shutdown();
@@ -440,6 +442,8 @@ void ScannerView::scan_pause() {
 	if (scan_thread->is_scanning()) {
 		scan_thread->set_freq_lock(0); 		//Reset the scanner lock (because user paused, or MAX_FREQ_LOCK reached) for next freq scan	
 		scan_thread->set_scanning(false); // WE STOP SCANNING
+		if (current_index < frequency_list.size())	//Persist it: fast_tune() doesn't, and a mode change retunes from it
+			receiver_model.set_tuning_frequency(frequency_list[current_index]);
 		audio::output::start();
 	}
 }
@@ -192,7 +192,10 @@ void SearchView::on_channel_spectrum(const ChannelSpectrum& spectrum) {
 	uint8_t power;
 	size_t bin;
 	
-	baseband::spectrum_streaming_stop();
+	// Sweep slices arrive in order, tagged with their frequency. Skip any
+	// still in flight from a previous range.
+	if ((slices_nb > 1) && (spectrum.center_frequency != slices[slice_counter].center_frequency))
+		return;
 	
 	// Add pixels to spectrum display and find max power for this slice
 	// Center 12 bins are ignored (DC spike is blanked)
@@ -221,20 +224,20 @@ void SearchView::on_channel_spectrum(const ChannelSpectrum& spectrum) {
 	slices[slice_counter].max_index = max_bin;
 	
 	if (slices_nb > 1) {
-		// Slice sequence
-		if (slice_counter >= slices_nb) {
+		// Slice sequence, the baseband retunes on its own
+		if (++slice_counter >= slices_nb) {
 			do_detection();
 			slice_counter = 0;
-		} else
-			slice_counter++;
-		receiver_model.set_tuning_frequency(slices[slice_counter].center_frequency);
-		baseband::set_spectrum(SEARCH_SLICE_WIDTH, 31);	// Clear
+		}
 	} else {
 		// Unique slice
 		do_detection();
 	}
-	
-	baseband::spectrum_streaming_start();
+}
+
+void SearchView::on_sweep_retune(const rf::Frequency frequency) {
+	receiver_model.fast_tune(frequency);
+	baseband::spectrum_sweep_tuned(frequency);
 }
 
 void SearchView::on_show() {
@@ -275,7 +278,12 @@ void SearchView::on_range_changed() {
 			slices[slice].center_frequency = center_frequency;
 			center_frequency += SEARCH_SLICE_WIDTH;
 		}
+		
+		baseband::spectrum_sweep_start(slices[0].center_frequency, SEARCH_SLICE_WIDTH, slices_nb,
+			SEARCH_SWEEP_SETTLE, SEARCH_SWEEP_AVERAGE);
 	} else {
+		baseband::spectrum_sweep_stop();
+		
 		slices[0].center_frequency = (f_max + f_min) / 2;
 		receiver_model.set_tuning_frequency(slices[0].center_frequency);
 
@@ -286,6 +294,9 @@ void SearchView::on_range_changed() {
 	bin_skip_frac = 0xF000 / slices_nb;
 
 	slice_counter = 0;
+	bin_skip_acc = 0;
+	pixel_index = 0;
+	mean_acc = 0;
 }
 
 void SearchView::on_lna_changed(int32_t v_db) {
@@ -34,6 +34,8 @@ namespace ui {
 #define SEARCH_BIN_NB			256					// FFT power bins
 #define SEARCH_BIN_NB_NO_DC	(SEARCH_BIN_NB - 16)	// Bins after trimming
 #define SEARCH_BIN_WIDTH		(SEARCH_SLICE_WIDTH / SEARCH_BIN_NB)
+#define SEARCH_SWEEP_SETTLE	1	// Buffers dropped after each retune
+#define SEARCH_SWEEP_AVERAGE	2	// Spectra averaged per slice
 
 #define DETECT_DELAY		5	// In 100ms units
 #define RELEASE_DELAY		6
@@ -134,6 +136,7 @@ private:
 	bool locked { false };
 	
 	void on_channel_spectrum(const ChannelSpectrum& spectrum);
+	void on_sweep_retune(const rf::Frequency frequency);
 	void on_range_changed();
 	void do_detection();
 	void on_lna_changed(int32_t v_db);
@@ -233,6 +236,13 @@ private:
 			this->fifo = message.fifo;
 		}
 	};
+	MessageHandlerRegistration message_handler_sweep_retune {
+		Message::ID::SpectrumSweepRetune,
+		[this](const Message* const p) {
+			const auto message = *reinterpret_cast<const SpectrumSweepRetuneMessage*>(p);
+			this->on_sweep_retune(message.frequency);
+		}
+	};
 	MessageHandlerRegistration message_handler_frame_sync {
 		Message::ID::DisplayFrameSync,
 		[this](const Message* const) {
@@ -40,7 +40,12 @@ static void send_message(const Message* const message) {
 	// another message is present before setting new message.
 	shared_memory.baseband_message = message;
 	creg::m0apptxevent::assert_event();
-	while(shared_memory.baseband_message);
+
+	// The M4 sends an event once it has taken the message. Any interrupt
+	// wakes the core as well, so a missed event costs at most a tick.
+	while(shared_memory.baseband_message) {
+		__WFE();
+	}
 }
 
 void AMConfig::apply() const {
@@ -239,6 +244,21 @@ void set_adsb() {
 	send_message(&message);
 }
 
+void set_channelizer(const uint32_t channel_spacing, const size_t channel_count, const size_t deviation,
+					const int32_t squelch_db, const int32_t audio_channel) {
+	const ChannelizerConfigureMessage message {
+		channel_spacing,
+		channel_count,
+		deviation,
+		audio_24k_hpf_300hz_config,
+		audio_24k_deemph_300_6_config,
+		squelch_db,
+		audio_channel
+	};
+	send_message(&message);
+	audio::set_rate(audio::Rate::Hz_24000);
+}
+
 void set_jammer(const bool run, const jammer::JammerType type, const uint32_t speed) {
 	const JammerConfigureMessage message {
 		run, 
@@ -302,13 +322,21 @@ void shutdown() {
 	send_message(&message);
 
 	shared_memory.application_queue.reset();
+	shared_memory.application_mailbox.reset();
 	
 	baseband_image_running = false;
 }
 
-void spectrum_streaming_start() {
+void spectrum_streaming_start(
+	const SpectrumStreamingConfigMessage::Window window,
+	const SpectrumStreamingConfigMessage::Averaging averaging,
+	const uint32_t average_count
+) {
 	SpectrumStreamingConfigMessage message {
-		SpectrumStreamingConfigMessage::Mode::Running
+		SpectrumStreamingConfigMessage::Mode::Running,
+		window,
+		averaging,
+		average_count
 	};
 	send_message(&message);
 }
@@ -320,6 +348,29 @@ void spectrum_streaming_stop() {
 	send_message(&message);
 }
 
+void spectrum_sweep_start(
+	const int64_t first_frequency,
+	const uint32_t step,
+	const uint32_t slice_count,
+	const uint32_t settle_buffers,
+	const uint32_t average_count
+) {
+	const SpectrumSweepConfigMessage message {
+		first_frequency, step, slice_count, settle_buffers, average_count
+	};
+	send_message(&message);
+}
+
+void spectrum_sweep_stop() {
+	const SpectrumSweepConfigMessage message { 0, 0, 0, 0, 1 };
+	send_message(&message);
+}
+
+void spectrum_sweep_tuned(const int64_t frequency) {
+	const SpectrumSweepTunedMessage message { frequency };
+	send_message(&message);
+}
+
 void set_sample_rate(const uint32_t sample_rate) {
 	SamplerateConfigMessage message { sample_rate };
 	send_message(&message);
@@ -79,6 +79,8 @@ void set_fsk_data(const uint32_t stream_length, const uint32_t samples_per_bit,
 					const uint32_t progress_notice);
 void set_pocsag(const pocsag::BitRate bitrate, bool phase);
 void set_adsb();
+void set_channelizer(const uint32_t channel_spacing, const size_t channel_count, const size_t deviation,
+					const int32_t squelch_db, const int32_t audio_channel);
 void set_jammer(const bool run, const jammer::JammerType type, const uint32_t speed);
 void set_rds_data(const uint16_t message_length);
 void set_spectrum(const size_t sampling_rate, const size_t trigger);
@@ -89,8 +91,21 @@ void request_beep();
 void run_image(const portapack::spi_flash::image_tag_t image_tag);
 void shutdown();
 
-void spectrum_streaming_start();
+void spectrum_streaming_start(
+	const SpectrumStreamingConfigMessage::Window window = SpectrumStreamingConfigMessage::Window::Hamming,
+	const SpectrumStreamingConfigMessage::Averaging averaging = SpectrumStreamingConfigMessage::Averaging::None,
+	const uint32_t average_count = 1
+);
 void spectrum_streaming_stop();
+void spectrum_sweep_start(
+	const int64_t first_frequency,
+	const uint32_t step,
+	const uint32_t slice_count,
+	const uint32_t settle_buffers,
+	const uint32_t average_count
+);
+void spectrum_sweep_stop();
+void spectrum_sweep_tuned(const int64_t frequency);
 
 void set_sample_rate(const uint32_t sample_rate);
 void capture_start(CaptureConfig* const config);
@@ -41,8 +41,11 @@ CaptureThread::CaptureThread(
 	size_t write_size,
 	size_t buffer_count,
 	std::function<void()> success_callback,
-	std::function<void(File::Error)> error_callback
-) : config { write_size, buffer_count },
+	std::function<void(File::Error)> error_callback,
+	CaptureConfig::Format format,
+	File::Size preallocate_bytes
+) : config { write_size, buffer_count, format },
+	preallocate_bytes { preallocate_bytes },
 	writer { std::move(writer) },
 	success_callback { std::move(success_callback) },
 	error_callback { std::move(error_callback) }
@@ -73,15 +76,28 @@ msg_t CaptureThread::static_fn(void* arg) {
 }
 
 Optional<File::Error> CaptureThread::run() {
+	// Before streaming starts, the FAT scan takes a while. Without it (no
+	// contiguous space), the file grows as usual.
+	if( preallocate_bytes ) {
+		stats.preallocated = !writer->preallocate(preallocate_bytes).is_valid();
+	}
+
 	BasebandCapture capture { &config };
 	BufferExchange buffers { &config };
 
 	while( !chThdShouldTerminate() ) {
 		auto buffer = buffers.get();
+		const halrtcnt_t write_start = halGetCounterValue();
 		auto write_result = writer->write(buffer->data(), buffer->size());
 		if( write_result.is_error() ) {
 			return write_result.error();
 		}
+		const halrtcnt_t write_duration = halGetCounterValue() - write_start;
+		stats.write_count++;
+		stats.write_duration_total += write_duration;
+		if( write_duration > stats.write_duration_max ) {
+			stats.write_duration_max = write_duration;
+		}
 		buffer->empty();
 		buffers.put(buffer);
 	}
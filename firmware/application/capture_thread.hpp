@@ -40,7 +40,9 @@ public:
 		size_t write_size,
 		size_t buffer_count,
 		std::function<void()> success_callback,
-		std::function<void(File::Error)> error_callback
+		std::function<void(File::Error)> error_callback,
+		CaptureConfig::Format format = CaptureConfig::Format::C16,
+		File::Size preallocate_bytes = 0
 	);
 	~CaptureThread();
 
@@ -53,8 +55,24 @@ public:
 		return config;
 	}
 
+	/* Time spent in each write of one buffer (write_size bytes). Buffers
+	 * are dropped when a write takes longer than the other buffers last.
+	 */
+	struct WriteStats {
+		bool preallocated { false };
+		uint32_t write_count { 0 };
+		halrtcnt_t write_duration_max { 0 };
+		uint64_t write_duration_total { 0 };
+	};
+
+	const WriteStats& write_stats() const {
+		return stats;
+	}
+
 private:
 	CaptureConfig config;
+	const File::Size preallocate_bytes;
+	WriteStats stats { };
 	std::unique_ptr<stream::Writer> writer;
 	std::function<void()> success_callback;
 	std::function<void(File::Error)> error_callback;
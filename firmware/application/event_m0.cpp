@@ -213,6 +213,13 @@ void EventDispatcher::handle_application_queue() {
 	shared_memory.application_queue.handle([](Message* const message) {
 		message_map.send(message);
 	});
+	shared_memory.application_mailbox.handle([](Message* const message) {
+		message_map.send(message);
+	});
+	// A slot left mid-post is still pending, and its post won't signal again.
+	if( shared_memory.application_mailbox.is_pending() ) {
+		events_flag(EVT_MASK_APPLICATION);
+	}
 }
 
 void EventDispatcher::handle_local_queue() {
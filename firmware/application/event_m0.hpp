@@ -64,7 +64,7 @@ public:
 	static void set_display_sleep(const bool sleep);
 
 	static inline void check_fifo_isr() {
-		if( !shared_memory.application_queue.is_empty() ) {
+		if( !shared_memory.application_queue.is_empty() || shared_memory.application_mailbox.is_pending() ) {
 			events_flag_isr(EVT_MASK_APPLICATION);
 		}
 	}
@@ -57,6 +57,12 @@ Optional<File::Error> File::create(const std::filesystem::path& filename) {
 }
 
 File::~File() {
+	if( preallocated ) {
+		// Release the space that was never written.
+		if( f_lseek(&f, written_end) == FR_OK ) {
+			f_truncate(&f);
+		}
+	}
 	f_close(&f);
 }
 
@@ -73,6 +79,7 @@ File::Result<File::Size> File::read(void* const data, const Size bytes_to_read)
 File::Result<File::Size> File::write(const void* const data, const Size bytes_to_write) {
 	UINT bytes_written = 0;
 	const auto result = f_write(&f, data, bytes_to_write, &bytes_written);
+	written_end = std::max(written_end, static_cast<Size>(f_tell(&f)));
 	if( result == FR_OK ) {
 		if( bytes_to_write == bytes_written ) {
 			return { static_cast<File::Size>(bytes_written) };
@@ -124,6 +131,27 @@ Optional<File::Error> File::sync() {
 	}
 }
 
+Optional<File::Error> File::preallocate(const Size size) {
+	// FAT file sizes are 32 bits.
+	const auto result = f_expand(&f, std::min(size, static_cast<Size>(0xffffffffU)), 1);
+	if( result == FR_OK ) {
+		preallocated = true;
+		return { };
+	} else {
+		return { result };
+	}
+}
+
+Optional<File::Error> File::truncate() {
+	const auto result = f_truncate(&f);
+	if( result == FR_OK ) {
+		written_end = f_tell(&f);
+		return { };
+	} else {
+		return { result };
+	}
+}
+
 static std::filesystem::path find_last_file_matching_pattern(const std::filesystem::path& pattern) {
 	std::filesystem::path last_match;
 	for(const auto& entry : std::filesystem::directory_iterator(u"", pattern)) {
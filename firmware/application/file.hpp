@@ -343,8 +343,20 @@ public:
 	// TODO: Return Result<>.
 	Optional<Error> sync();
 
+	/* Allocates `size` bytes of contiguous clusters to a new, empty file, so
+	 * writes never wait on FAT allocation. Space past the last byte written
+	 * is released when the file is closed. Fails (FR_DENIED) if the file is
+	 * not empty or no contiguous free space is large enough.
+	 */
+	Optional<Error> preallocate(const Size size);
+
+	/* Truncates the file at the current position. */
+	Optional<Error> truncate();
+
 private:
 	FIL f { };
+	bool preallocated { false };
+	Size written_end { 0 };
 
 	Optional<Error> open_fatfs(const std::filesystem::path& filename, BYTE mode);
 };
@@ -207,6 +207,11 @@ void MAX2837::set_lpf_rf_bandwidth(const uint32_t bandwidth_minimum) {
 }
 
 bool MAX2837::set_frequency(const rf::Frequency lo_frequency) {
+	/* Only registers whose value changes are rewritten, so a hop within one
+	 * LO band costs two or three SPI writes.
+	 */
+	const RegisterMap previous = _map;
+
 	/* TODO: This is a sad implementation. Refactor. */
 	if( lo::band[0].contains(lo_frequency) ) {
 		_map.r.syn_int_div.LOGEN_BSW = 0b00;	/* 2300 - 2399.99MHz */
@@ -223,25 +228,35 @@ bool MAX2837::set_frequency(const rf::Frequency lo_frequency) {
 	} else {
 		return false;
 	}
-	_dirty[Register::SYN_INT_DIV] = 1;
-	_dirty[Register::RXRF_1] = 1;
+	mark_if_changed(previous, Register::RXRF_1);
 
 	const uint64_t div_q20 = (lo_frequency * (1 << 20)) / pll_factor;
 
 	_map.r.syn_int_div.SYN_INTDIV = div_q20 >> 20;
-	_dirty[Register::SYN_INT_DIV] = 1;
 	_map.r.syn_fr_div_2.SYN_FRDIV_19_10 = (div_q20 >> 10) & 0x3ff;
-	_dirty[Register::SYN_FR_DIV_2] = 1;
+	const bool int_div_changed = mark_if_changed(previous, Register::SYN_INT_DIV);
+	const bool fr_div_2_changed = mark_if_changed(previous, Register::SYN_FR_DIV_2);
 	/* flush to commit high FRDIV first, as low FRDIV commits the change */
 	flush();
 
 	_map.r.syn_fr_div_1.SYN_FRDIV_9_0 = (div_q20 & 0x3ff);
-	_dirty[Register::SYN_FR_DIV_1] = 1;
+	if( mark_if_changed(previous, Register::SYN_FR_DIV_1) || int_div_changed || fr_div_2_changed ) {
+		_dirty[Register::SYN_FR_DIV_1] = 1;
+	}
 	flush();
 
 	return true;
 }
 
+bool MAX2837::mark_if_changed(const RegisterMap& previous, const Register reg) {
+	const auto reg_num = toUType(reg);
+	if( _map.w[reg_num] != previous.w[reg_num] ) {
+		_dirty[reg_num] = 1;
+		return true;
+	}
+	return false;
+}
+
 void MAX2837::set_rx_lo_iq_calibration(const size_t v) {
 	_map.r.rx_top_rx_bias.RX_IQERR_SPI_EN = 1;
 	_dirty[Register::RX_TOP_RX_BIAS] = 1;
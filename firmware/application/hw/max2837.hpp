@@ -900,6 +900,7 @@ private:
 	DirtyRegisters<Register, reg_count> _dirty { };
 
 	void flush_one(const Register reg);
+	bool mark_if_changed(const RegisterMap& previous, const Register reg);
 
 	void write(const address_t reg_num, const reg_t value);
 
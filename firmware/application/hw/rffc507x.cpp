@@ -234,6 +234,7 @@ void RFFC507x::set_mixer_current(const uint8_t value) {
 
 void RFFC507x::set_frequency(const rf::Frequency lo_frequency) {
 	const SynthConfig synth_config = SynthConfig::calculate(lo_frequency);
+	const RegisterMap previous = _map;
 
 	/* Boost charge pump leakage if VCO frequency > 3.2GHz, indicated by
 	 * prescaler divider set to 4 (log2=2) instead of 2 (log2=1).
@@ -243,19 +244,28 @@ void RFFC507x::set_frequency(const rf::Frequency lo_frequency) {
 	} else {
 		_map.r.lf.pllcpl = 2;
 	}
-	flush_one(Register::LF);
+	mark_if_changed(previous, Register::LF);
 
 	_map.r.p2_freq1.p2n = synth_config.n_divider_q24 >> 24;
 	_map.r.p2_freq1.p2lodiv = synth_config.lo_divider_log2;
 	_map.r.p2_freq1.p2presc = synth_config.prescaler_divider_log2;
 	_map.r.p2_freq2.p2nmsb = (synth_config.n_divider_q24 >> 8) & 0xffff;
 	_map.r.p2_freq3.p2nlsb = synth_config.n_divider_q24 & 0xff;
-	_dirty[Register::P2_FREQ1] = 1;
-	_dirty[Register::P2_FREQ2] = 1;
-	_dirty[Register::P2_FREQ3] = 1;
+	mark_if_changed(previous, Register::P2_FREQ1);
+	mark_if_changed(previous, Register::P2_FREQ2);
+	mark_if_changed(previous, Register::P2_FREQ3);
 	flush();
 }
 
+bool RFFC507x::mark_if_changed(const RegisterMap& previous, const Register reg) {
+	const auto reg_num = toUType(reg);
+	if( _map.w[reg_num] != previous.w[reg_num] ) {
+		_dirty[reg_num] = 1;
+		return true;
+	}
+	return false;
+}
+
 void RFFC507x::set_gpo1(const bool new_value) {
 	if( new_value ) {
 		_map.r.gpo.p2gpo |= 1;
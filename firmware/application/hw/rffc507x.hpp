@@ -824,6 +824,7 @@ private:
 	reg_t read(const Register reg);
 
 	void flush_one(const Register reg);
+	bool mark_if_changed(const RegisterMap& previous, const Register reg);
 
 	reg_t readback(const Readback readback);
 
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "file.hpp"
+#include "optional.hpp"
 
 namespace stream {
 
@@ -35,6 +36,13 @@ class Writer {
 public:
 	virtual File::Result<File::Size> write(const void* const buffer, const File::Size bytes) = 0;
 	virtual ~Writer() = default;
+
+	/* Reserves space for about `bytes` of writes ahead of time, where the
+	 * destination supports it.
+	 */
+	virtual Optional<File::Error> preallocate(const File::Size) {
+		return { };
+	}
 };
 
 } /* namespace stream */
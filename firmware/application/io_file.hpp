@@ -62,6 +62,10 @@ public:
 	}
 
 	File::Result<File::Size> write(const void* const buffer, const File::Size bytes) override;
+
+	Optional<File::Error> preallocate(const File::Size bytes) override {
+		return file.preallocate(bytes);
+	}
 	
 protected:
 	File file { };
@@ -22,16 +22,136 @@
 #include "log_file.hpp"
 
 #include "string_format.hpp"
+#include "rtc_time.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+LogFile::LogFile() {
+	signal_token_tick_second = rtc_time::signal_tick_second += [this]() {
+		this->on_tick_second();
+	};
+}
+
+LogFile::~LogFile() {
+	rtc_time::signal_tick_second -= signal_token_tick_second;
+	flush();
+}
+
+Optional<File::Error> LogFile::append(const std::filesystem::path& filename) {
+	const auto error = file.append(filename);
+	is_open = !error.is_valid();
+	if( is_open ) {
+		file_offset = file.size();
+		append_offset = file_offset;
+	}
+	return error;
+}
 
 Optional<File::Error> LogFile::write_entry(const rtc::RTC& datetime, const std::string& entry) {
 	std::string timestamp = to_string_timestamp(datetime);
 	return write_line(timestamp + " " + entry);
 }
 
+Optional<File::Error> LogFile::flush() {
+	pending_seconds = 0;
+	if( !is_open ) {
+		return { };
+	}
+
+	if( dirty ) {
+		const auto error = write_out(pending);
+		if( error.is_valid() ) {
+			return error;
+		}
+		dirty = false;
+	}
+
+	if( unsynced ) {
+		const auto error = file.sync();
+		if( error.is_valid() ) {
+			return error;
+		}
+		unsynced = false;
+	}
+
+	return { };
+}
+
+void LogFile::on_tick_second() {
+	if( (dirty || unsynced) && (++pending_seconds >= flush_interval) ) {
+		flush();
+	}
+}
+
 Optional<File::Error> LogFile::write_line(const std::string& message) {
-	auto error = file.write_line(message);
-	if( !error.is_valid() ) {
-		file.sync();
+	const size_t length = message.size() + 2;
+
+	if( length > (buffer.size() - pending) ) {
+		const auto error = write_sectors();
+		if( length > (buffer.size() - pending) ) {
+			dropped_lines_++;
+			return error;
+		}
 	}
-	return error;
+
+	put(message.data(), message.size());
+	put("\r\n", 2);
+
+	return write_sectors();
+}
+
+void LogFile::put(const char* const data, const size_t count) {
+	const size_t write_index = (read_index + pending) % buffer.size();
+	const size_t first = std::min(count, buffer.size() - write_index);
+	memcpy(&buffer[write_index], data, first);
+	memcpy(&buffer[0], data + first, count - first);
+	pending += count;
+	dirty = true;
+}
+
+/* Write out every complete sector, leaving the partial one buffered. */
+Optional<File::Error> LogFile::write_sectors() {
+	if( !is_open ) {
+		return { };
+	}
+
+	const File::Size end = (file_offset + pending) & ~File::Size(sector_size - 1);
+	if( end <= file_offset ) {
+		return { };
+	}
+
+	return write_out(end - file_offset);
+}
+
+Optional<File::Error> LogFile::write_out(const size_t count) {
+	// Ring contents may wrap; at most two pieces.
+	size_t remaining = count;
+	while( remaining ) {
+		const size_t piece = std::min(remaining, buffer.size() - read_index);
+		const auto result = file.write(&buffer[read_index], piece);
+		if( result.is_error() ) {
+			// Position is unknown after a failed write; retry from a known one.
+			file.seek(file_offset);
+			return { result.error() };
+		}
+
+		read_index = (read_index + piece) % buffer.size();
+		pending -= piece;
+		remaining -= piece;
+		file_offset += piece;
+		unsynced = true;
+	}
+
+	// Keep a partial sector buffered, so the next write covers all of it
+	// again. Bytes that were in the file before it was opened are not.
+	const size_t partial = std::min<File::Size>(file_offset & (sector_size - 1), file_offset - append_offset);
+	if( partial ) {
+		read_index = (read_index + buffer.size() - partial) % buffer.size();
+		pending += partial;
+		file_offset -= partial;
+		file.seek(file_offset);
+	}
+
+	return { };
 }
@@ -22,25 +22,65 @@
 #ifndef __LOG_FILE_H__
 #define __LOG_FILE_H__
 
+#include <array>
 #include <string>
 
 #include "file.hpp"
+#include "signal.hpp"
 
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
+/* Lines are collected in a RAM ring and written out a whole sector at a
+ * time, aligned to the sector boundaries of the file. Anything left over
+ * is written and the file synced once it has been pending for
+ * flush_interval seconds, or when the log is closed. Lines that find the
+ * ring full (the card is failing writes) are dropped and counted.
+ */
 class LogFile {
 public:
-	Optional<File::Error> append(const std::filesystem::path& filename) {
-		return file.append(filename);
-	}
+	static constexpr size_t sector_size = 512;
+	static constexpr size_t buffer_size = 2 * sector_size;
+	static constexpr uint32_t flush_interval = 5;
+
+	LogFile();
+	~LogFile();
+
+	LogFile(const LogFile&) = delete;
+	LogFile& operator=(const LogFile&) = delete;
+
+	Optional<File::Error> append(const std::filesystem::path& filename);
 
 	Optional<File::Error> write_entry(const rtc::RTC& datetime, const std::string& entry);
 
+	Optional<File::Error> flush();
+
+	uint32_t dropped_lines() const {
+		return dropped_lines_;
+	}
+
 private:
 	File file { };
+	bool is_open { false };
+	File::Size file_offset { 0 };
+	File::Size append_offset { 0 };
+
+	std::array<char, buffer_size> buffer { };
+	size_t read_index { 0 };
+	size_t pending { 0 };
+	bool dirty { false };
+	bool unsynced { false };
+	uint32_t pending_seconds { 0 };
+	uint32_t dropped_lines_ { 0 };
+
+	SignalToken signal_token_tick_second { };
+
+	void on_tick_second();
 
 	Optional<File::Error> write_line(const std::string& message);
+	void put(const char* const data, const size_t count);
+	Optional<File::Error> write_sectors();
+	Optional<File::Error> write_out(const size_t count);
 };
 
 #endif/*__LOG_FILE_H__*/
@@ -61,7 +61,7 @@ private:
 	size_t bit_counter { 0 };
 	uint8_t ones_counter { 0 };
 	
-	CRC<16, true, true> crc_ccitt { 0x1021, 0xFFFF, 0xFFFF };
+	TableCRC<16, 0x1021, true, true> crc_ccitt { 0xFFFF, 0xFFFF };
 };
 
 } /* namespace ax25 */
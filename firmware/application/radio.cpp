@@ -96,6 +96,12 @@ static baseband::CPLD baseband_cpld;
 
 static rf::Direction direction { rf::Direction::Receive };
 
+/* LO plan last programmed by set_tuning_frequency(), for fast_tune() to
+ * compare against. Invalid (empty) whenever the front-end state is unknown.
+ */
+static rf::Frequency tuned_frequency { 0 };
+static tuning::config::Config tuned_config { };
+
 void init() {
 	rf_path.init();
 	first_if.init();
@@ -119,6 +125,7 @@ void set_direction(const rf::Direction new_direction) {
 				chSysHalt();
 			}
 		}
+		tuned_config = { };
 	}
 	
 	direction = new_direction;
@@ -149,12 +156,60 @@ bool set_tuning_frequency(const rf::Frequency frequency) {
 		rf_path.set_band(tuning_config.rf_path_band);
 		baseband_cpld.set_invert(tuning_config.baseband_invert);
 
+		tuned_frequency = frequency;
+		tuned_config = result_second_if ? tuning_config : tuning::config::Config { };
+
 		return result_second_if;
 	} else {
 		return false;
 	}
 }
 
+bool fast_tune(const rf::Frequency frequency) {
+	if( !tuned_config.is_valid() ) {
+		return set_tuning_frequency(frequency);
+	}
+	if( frequency == tuned_frequency ) {
+		return true;
+	}
+
+	const auto tuning_config = tuning::config::create(frequency);
+	if( !tuning_config.is_valid() ) {
+		return false;
+	}
+
+	/* The first LO only relocks through a disable/enable cycle, so it is
+	 * left alone unless it moves (it never runs in the mid band).
+	 */
+	if( tuning_config.first_lo_frequency != tuned_config.first_lo_frequency ) {
+		first_if.disable();
+
+		if( tuning_config.first_lo_frequency ) {
+			first_if.set_frequency(tuning_config.first_lo_frequency);
+			first_if.enable();
+		}
+	}
+
+	if( tuning_config.second_lo_frequency != tuned_config.second_lo_frequency ) {
+		if( !second_if.set_frequency(tuning_config.second_lo_frequency) ) {
+			tuned_config = { };
+			return false;
+		}
+	}
+
+	if( tuning_config.rf_path_band != tuned_config.rf_path_band ) {
+		rf_path.set_band(tuning_config.rf_path_band);
+	}
+	if( tuning_config.baseband_invert != tuned_config.baseband_invert ) {
+		baseband_cpld.set_invert(tuning_config.baseband_invert);
+	}
+
+	tuned_frequency = frequency;
+	tuned_config = tuning_config;
+
+	return true;
+}
+
 void set_rf_amp(const bool rf_amp) {
 	rf_path.set_rf_amp(rf_amp);
 	
@@ -196,6 +251,7 @@ void disable() {
 	baseband_codec.set_mode(max5864::Mode::Shutdown);
 	second_if.set_mode(max2837::Mode::Standby);
 	first_if.disable();
+	tuned_config = { };
 	set_rf_amp(false);
 	
 	led_rx.off();
@@ -43,6 +43,10 @@ void init();
 
 void set_direction(const rf::Direction new_direction);
 bool set_tuning_frequency(const rf::Frequency frequency);
+/* Retune for scanning and sweeping: only the parts of the LO plan that
+ * differ from the last tune are reprogrammed.
+ */
+bool fast_tune(const rf::Frequency frequency);
 void set_rf_amp(const bool rf_amp);
 void set_lna_gain(const int_fast8_t db);
 void set_vga_gain(const int_fast8_t db);
@@ -66,6 +66,10 @@ void ReceiverModel::set_tuning_frequency(rf::Frequency f) {
 	update_tuning_frequency();
 }
 
+void ReceiverModel::fast_tune(rf::Frequency f) {
+	radio::fast_tune(f + tuning_offset());
+}
+
 rf::Frequency ReceiverModel::frequency_step() const {
 	return frequency_step_;
 }
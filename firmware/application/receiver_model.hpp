@@ -42,6 +42,10 @@ public:
 
 	rf::Frequency tuning_frequency() const;
 	void set_tuning_frequency(rf::Frequency f);
+	/* Transient retune for scanning and sweeping, not persisted: the next
+	 * set_tuning_frequency() or reconfiguration goes back to tuning_frequency().
+	 */
+	void fast_tune(rf::Frequency f);
 
 	rf::Frequency frequency_step() const;
 	void set_frequency_step(rf::Frequency f);
@@ -27,43 +27,263 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <list>
+#include <array>
+#include <new>
+#include <type_traits>
 #include <utility>
 #include <functional>
 #include <iterator>
 #include <algorithm>
 
-template<class Entry>
-using RecentEntries = std::list<Entry>;
-
-template<typename ContainerType, typename Key>
-typename ContainerType::const_iterator find(const ContainerType& entries, const Key key) {
-	return std::find_if(
-		std::begin(entries), std::end(entries),
-		[key](typename ContainerType::const_reference e) { return e.key() == key; }
-	);
+/* Hash of an entry key, for the RecentEntries index. Keys that aren't
+ * integers need an overload found by ADL (see ert_app.hpp, tpms_app.hpp).
+ */
+template<typename Key>
+constexpr typename std::enable_if<std::is_integral<Key>::value, uint32_t>::type recent_entry_hash(const Key key) {
+	return static_cast<uint32_t>(static_cast<uint64_t>(key) ^ (static_cast<uint64_t>(key) >> 32));
 }
 
-template<typename ContainerType>
-static void truncate_entries(ContainerType& entries, const size_t entries_max = 64) {
-	while(entries.size() > entries_max) {
-		entries.pop_back();
+/* The most recently updated entries, newest first. Entries live in a
+ * fixed pool, linked into a most-recently-used list and indexed by key in
+ * an open-addressed hash table, so an update moves the entry to the front
+ * in O(1) without copying or allocating. When full, a new key replaces the
+ * least recently updated entry.
+ */
+template<class Entry, size_t Capacity = 64>
+class RecentEntries {
+	static_assert(Capacity < 255, "RecentEntries node index is 8 bits");
+
+	using Key = typename Entry::Key;
+	using node_t = uint8_t;
+	static constexpr node_t none = 0xff;
+
+	// At most half full, so probe sequences stay short.
+	static constexpr size_t index_size = [] {
+		size_t n = 1;
+		while( n < Capacity * 2 ) {
+			n <<= 1;
+		}
+		return n;
+	}();
+
+public:
+	using value_type = Entry;
+	using reference = Entry&;
+	using const_reference = const Entry&;
+
+	template<typename Container, typename Value>
+	class iterator_base {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = Entry;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Value*;
+		using reference = Value&;
+
+		iterator_base(
+			Container* const entries,
+			const node_t node
+		) : entries { entries },
+			node { node }
+		{
+		}
+
+		reference operator*() const { return entries->entry(node); }
+		pointer operator->() const { return &entries->entry(node); }
+
+		iterator_base& operator++() {
+			node = entries->next[node];
+			return *this;
+		}
+
+		iterator_base operator++(int) {
+			auto result = *this;
+			++(*this);
+			return result;
+		}
+
+		// From end(), steps back to the oldest entry.
+		iterator_base& operator--() {
+			node = (node == none) ? entries->tail : entries->prev[node];
+			return *this;
+		}
+
+		iterator_base operator--(int) {
+			auto result = *this;
+			--(*this);
+			return result;
+		}
+
+		operator iterator_base<const RecentEntries, const Entry>() const {
+			return { entries, node };
+		}
+
+		friend bool operator==(const iterator_base& a, const iterator_base& b) { return a.node == b.node; }
+		friend bool operator!=(const iterator_base& a, const iterator_base& b) { return a.node != b.node; }
+
+	private:
+		Container* entries;
+		node_t node;
+	};
+
+	using iterator = iterator_base<RecentEntries, Entry>;
+	using const_iterator = iterator_base<const RecentEntries, const Entry>;
+
+	RecentEntries() {
+		index.fill(none);
+	}
+
+	~RecentEntries() {
+		clear();
+	}
+
+	RecentEntries(const RecentEntries&) = delete;
+	RecentEntries& operator=(const RecentEntries&) = delete;
+
+	iterator begin() { return { this, head }; }
+	iterator end() { return { this, none }; }
+	const_iterator begin() const { return { this, head }; }
+	const_iterator end() const { return { this, none }; }
+
+	bool empty() const { return count == 0; }
+	size_t size() const { return count; }
+
+	reference front() { return entry(head); }
+	const_reference front() const { return entry(head); }
+
+	iterator find(const Key& key) {
+		return { this, lookup(key) };
+	}
+
+	const_iterator find(const Key& key) const {
+		return { this, lookup(key) };
+	}
+
+	/* Entry for key, created if new, and moved to the front. */
+	reference on_packet(const Key& key) {
+		auto node = lookup(key);
+		if( node != none ) {
+			unlink(node);
+		} else {
+			if( count < Capacity ) {
+				node = count++;
+			} else {
+				node = tail;
+				unlink(node);
+				index_remove(node);
+				entry(node).~Entry();
+			}
+			new (&pool[node]) Entry(key);
+			index_insert(node);
+		}
+		link_front(node);
+		return entry(node);
 	}
+
+	void clear() {
+		for(node_t node=head; node!=none; node=next[node]) {
+			entry(node).~Entry();
+		}
+		index.fill(none);
+		head = tail = none;
+		count = 0;
+	}
+
+private:
+	std::array<typename std::aligned_storage<sizeof(Entry), alignof(Entry)>::type, Capacity> pool;
+	std::array<node_t, Capacity> prev;
+	std::array<node_t, Capacity> next;
+	std::array<node_t, index_size> index;
+	node_t head { none };
+	node_t tail { none };
+	size_t count { 0 };
+
+	Entry& entry(const node_t node) {
+		return *reinterpret_cast<Entry*>(&pool[node]);
+	}
+
+	const Entry& entry(const node_t node) const {
+		return *reinterpret_cast<const Entry*>(&pool[node]);
+	}
+
+	static size_t slot_of(const Key& key) {
+		// Fibonacci hashing spreads sequential IDs across the table.
+		return (recent_entry_hash(key) * 2654435769U) >> (32 - log2(index_size));
+	}
+
+	static constexpr size_t log2(const size_t n) {
+		return (n > 1) ? (1 + log2(n >> 1)) : 0;
+	}
+
+	node_t lookup(const Key& key) const {
+		for(size_t slot=slot_of(key); index[slot]!=none; slot=(slot + 1) & (index_size - 1)) {
+			if( entry(index[slot]).key() == key ) {
+				return index[slot];
+			}
+		}
+		return none;
+	}
+
+	void index_insert(const node_t node) {
+		size_t slot = slot_of(entry(node).key());
+		while( index[slot] != none ) {
+			slot = (slot + 1) & (index_size - 1);
+		}
+		index[slot] = node;
+	}
+
+	void index_remove(const node_t node) {
+		size_t slot = slot_of(entry(node).key());
+		while( index[slot] != node ) {
+			slot = (slot + 1) & (index_size - 1);
+		}
+
+		// Backward-shift the rest of the probe run, no tombstones.
+		size_t hole = slot;
+		for(size_t i=(hole + 1) & (index_size - 1); index[i]!=none; i=(i + 1) & (index_size - 1)) {
+			const size_t home = slot_of(entry(index[i]).key());
+			// Move it if its home isn't cyclically within (hole, i].
+			if( ((i - home) & (index_size - 1)) >= ((i - hole) & (index_size - 1)) ) {
+				index[hole] = index[i];
+				hole = i;
+			}
+		}
+		index[hole] = none;
+	}
+
+	void unlink(const node_t node) {
+		if( prev[node] != none ) {
+			next[prev[node]] = next[node];
+		} else {
+			head = next[node];
+		}
+		if( next[node] != none ) {
+			prev[next[node]] = prev[node];
+		} else {
+			tail = prev[node];
+		}
+	}
+
+	void link_front(const node_t node) {
+		prev[node] = none;
+		next[node] = head;
+		if( head != none ) {
+			prev[head] = node;
+		} else {
+			tail = node;
+		}
+		head = node;
+	}
+};
+
+template<typename ContainerType, typename Key>
+typename ContainerType::const_iterator find(const ContainerType& entries, const Key key) {
+	return entries.find(key);
 }
 
 template<typename ContainerType, typename Key>
 typename ContainerType::reference on_packet(ContainerType& entries, const Key key) {
-	auto matching_recent = find(entries, key);
-	if( matching_recent != std::end(entries) ) {
-		// Found within. Move to front of list, increment counter.
-		entries.push_front(*matching_recent);
-		entries.erase(matching_recent);
-	} else {
-		entries.emplace_front(key);
-		truncate_entries(entries);
-	}
-
-	return entries.front();
+	return entries.on_packet(key);
 }
 
 template<typename ContainerType>
@@ -42,8 +42,9 @@ ReplayThread::ReplayThread(
 	size_t read_size,
 	size_t buffer_count,
 	bool* ready_signal,
-	std::function<void(uint32_t return_code)> terminate_callback
-) : config { read_size, buffer_count },
+	std::function<void(uint32_t return_code)> terminate_callback,
+	ReplayConfig::Format format
+) : config { read_size, buffer_count, format },
 	reader { std::move(reader) },
 	ready_sig { ready_signal },
 	terminate_callback { std::move(terminate_callback) }
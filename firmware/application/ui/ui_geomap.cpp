@@ -147,43 +147,138 @@ GeoMap::GeoMap(
 	//set_focusable(true);
 }
 
-void GeoMap::paint(Painter& painter) {
-	u_int16_t line;
-	std::array<ui::Color, 240> map_line_buffer;
+const Color* GeoMap::tile(const uint32_t tx, const uint32_t ty) {
+	const auto& level = levels[level_];
+	const uint32_t tiles_x = (level.width + tile_size - 1) / tile_size;
+	const uint32_t key = (level_ << 24) | (ty * tiles_x + tx);
+	
+	auto& cache = *tile_cache;
+	auto lru = &cache[0];
+	for (auto& entry : cache) {
+		if (entry.key == key) {
+			entry.last_used = ++tile_use_count;
+			return entry.pixels.data();
+		}
+		if (entry.last_used < lru->last_used)
+			lru = &entry;
+	}
+	
+	const auto tile_bytes = sizeof(lru->pixels);
+	map_file.seek(level.offset + (ty * tiles_x + tx) * tile_bytes);
+	const auto result = map_file.read(lru->pixels.data(), tile_bytes);
+	if (result.is_error() || (result.value() != tile_bytes)) {
+		lru->pixels.fill(Color::black());
+		lru->key = 0xffffffff;
+	} else {
+		lru->key = key;
+	}
+	lru->last_used = ++tile_use_count;
+	return lru->pixels.data();
+}
+
+// Draws the part of the map under area (screen coordinates, within the widget)
+void GeoMap::draw_map(const Rect area) {
 	const auto r = screen_rect();
 	
-	// Ony redraw map if it moved by at least 1 pixel
-	if ((x_pos != prev_x_pos) || (y_pos != prev_y_pos)) {
-		for (line = 0; line < r.height(); line++) {
-			map_file.seek(4 + ((x_pos + (map_width * (y_pos + line))) << 1));
-			map_file.read(map_line_buffer.data(), r.width() << 1);
-			display.draw_pixels({ 0, r.top() + line, r.width(), 1 }, map_line_buffer);
+	// Anything off the map edges is left black
+	const Rect map_area = area.intersect({
+		r.left() - x_pos, r.top() - y_pos,
+		map_width, map_height
+	});
+	if ((map_area.width() != area.width()) || (map_area.height() != area.height()))
+		display.fill_rectangle(area, Color::black());
+	if (map_area.is_empty())
+		return;
+	
+	if (!tiled) {
+		draw_map_lines(map_area);
+		return;
+	}
+	
+	// Map pixel coordinates of the area
+	const int32_t mx0 = x_pos + map_area.left() - r.left();
+	const int32_t my0 = y_pos + map_area.top() - r.top();
+	const int32_t mx1 = mx0 + map_area.width();
+	const int32_t my1 = my0 + map_area.height();
+	
+	for (int32_t ty = my0 / tile_size; ty <= (my1 - 1) / (int32_t)tile_size; ty++) {
+		for (int32_t tx = mx0 / tile_size; tx <= (mx1 - 1) / (int32_t)tile_size; tx++) {
+			const Color* const pixels = tile(tx, ty);
+			
+			const int32_t x0 = std::max(mx0, tx * (int32_t)tile_size);
+			const int32_t x1 = std::min(mx1, (tx + 1) * (int32_t)tile_size);
+			const int32_t y0 = std::max(my0, ty * (int32_t)tile_size);
+			const int32_t y1 = std::min(my1, (ty + 1) * (int32_t)tile_size);
+			const Point p { r.left() + x0 - x_pos, r.top() + y0 - y_pos };
+			
+			if ((x1 - x0) == (int32_t)tile_size) {
+				// Full-width rows are contiguous
+				display.render_box(p, { x1 - x0, y1 - y0 }, &pixels[(y0 - ty * tile_size) * tile_size]);
+			} else {
+				for (int32_t y = y0; y < y1; y++) {
+					display.render_line(
+						p + Point(0, y - y0),
+						x1 - x0,
+						&pixels[(y - ty * tile_size) * tile_size + (x0 - tx * tile_size)]
+					);
+				}
+			}
 		}
-		
-		prev_x_pos = x_pos;
-		prev_y_pos = y_pos;
 	}
+}
+
+void GeoMap::draw_map_lines(const Rect area) {
+	std::array<ui::Color, 240> map_line_buffer;
+	const auto r = screen_rect();
+	const int32_t mx = x_pos + area.left() - r.left();
+	const int32_t my = y_pos + area.top() - r.top();
+	
+	for (int32_t line = 0; line < area.height(); line++) {
+		map_file.seek(4 + ((mx + (map_width * (my + line))) << 1));
+		map_file.read(map_line_buffer.data(), area.width() << 1);
+		display.render_line({ area.left(), area.top() + line }, area.width(), map_line_buffer.data());
+	}
+}
+
+void GeoMap::draw_markers(Painter& painter, const Point origin) {
+	// Cross and bearing fit in this
+	marker_area = { origin - Point(16, 16), { 32, 32 } };
 	
  	//center tag above bearing
 	if(tag_.find_first_not_of(' ') != tag_.npos){ //only draw tag if we have something other than spaces
-		painter.draw_string(r.center() - Point(((int)tag_.length() * 8 / 2), 2 * 16), style(), tag_);
+		const Point tag_pos = origin - Point(((int)tag_.length() * 8 / 2), 2 * 16);
+		painter.draw_string(tag_pos, style(), tag_);
+		marker_area += Rect { tag_pos, { (int)tag_.length() * 8, 16 } };
  	}
+	marker_area = marker_area.intersect(screen_rect());
 
 	if (mode_ == PROMPT) {
 		// Cross
-		display.fill_rectangle({ r.center() - Point(16, 1), { 32, 2 } }, Color::red());
-		display.fill_rectangle({ r.center() - Point(1, 16), { 2, 32 } }, Color::red());
+		display.fill_rectangle({ origin - Point(16, 1), { 32, 2 } }, Color::red());
+		display.fill_rectangle({ origin - Point(1, 16), { 2, 32 } }, Color::red());
 	} else if (angle_ < 360){
  		//if we have a valid angle draw bearing
-		draw_bearing(r.center(), angle_, 10, Color::red());
+		draw_bearing(origin, angle_, 10, Color::red());
  	}
  	else {
  		//draw a small cross
- 		display.fill_rectangle({ r.center() - Point(8, 1), { 16, 2 } }, Color::red());
- 		display.fill_rectangle({ r.center() - Point(1, 8), { 2, 16 } }, Color::red());
+ 		display.fill_rectangle({ origin - Point(8, 1), { 16, 2 } }, Color::red());
+ 		display.fill_rectangle({ origin - Point(1, 8), { 2, 16 } }, Color::red());
 	}
 }
 
+void GeoMap::paint(Painter& painter) {
+	const auto r = screen_rect();
+	
+	if (marker_only && !marker_area.is_empty())
+		draw_map(marker_area);
+	else
+		draw_map(r);
+	marker_only = false;
+	
+	draw_markers(painter, r.location() + marker_pos);
+}
+
 bool GeoMap::on_touch(const TouchEvent event) {
 	if ((event.type == TouchEvent::Type::Start) && (mode_ == PROMPT)) {
 		set_highlighted(true);
@@ -203,20 +298,29 @@ void GeoMap::move(const float lon, const float lat) {
 	Rect map_rect = screen_rect();
 	
 	// Using WGS 84/Pseudo-Mercator projection
-	x_pos = map_width * (lon_+180)/360  - (map_rect.width() / 2);
+	const int32_t x = map_width * (lon_+180)/360;
 
 	// Latitude calculation based on https://stackoverflow.com/a/10401734/2278659
 	double map_bottom = sin(-85.05 * pi / 180); // Map bitmap only goes from about -85 to 85 lat
 	double lat_rad = sin(lat * pi / 180);
 	double map_world_lon = map_width / (2 * pi); 
     double map_offset = (map_world_lon / 2 * log((1 + map_bottom) / (1 - map_bottom)));
-	y_pos = map_height - ((map_world_lon / 2 * log((1 + lat_rad) / (1 - lat_rad))) - map_offset) - 128; // Offset added for the GUI
+	const int32_t y = map_height - ((map_world_lon / 2 * log((1 + lat_rad) / (1 - lat_rad))) - map_offset);
+
+	// While the marker stays in the middle half of the view, leave the map
+	// where it is and only move the marker
+	const Point p { x - x_pos, y - y_pos };
+	const Rect inner { map_rect.width() / 4, map_rect.height() / 4, map_rect.width() / 2, map_rect.height() / 2 };
+	if ((mode_ == DISPLAY) && !marker_area.is_empty() && inner.contains(p)) {
+		marker_pos = p;
+		marker_only = true;
+		return;
+	}
 
-	// Cap position
-	if (x_pos > (map_width - map_rect.width()))
-		x_pos = map_width - map_rect.width();
-	if (y_pos > (map_height + map_rect.height()))
-		y_pos = map_height - map_rect.height();
+	x_pos = x - (map_rect.width() / 2);
+	y_pos = y - (map_rect.height() / 2);
+	marker_pos = { map_rect.width() / 2, map_rect.height() / 2 };
+	marker_only = false;
 }
 
 bool GeoMap::init() {
@@ -224,18 +328,47 @@ bool GeoMap::init() {
 	if (result.is_valid())
 		return false;
 	
-	map_file.read(&map_width, 2);
-	map_file.read(&map_height, 2);
+	uint16_t header[4];
+	map_file.read(header, 4);
 	
-	map_center_x = map_width >> 1;
-	map_center_y = map_height >> 1;
+	if (header[0] == 0) {
+		// Tiled
+		map_file.read(&header[2], 4);
+		if ((header[1] != tile_size) || !header[2])
+			return false;
+		
+		level_count = std::min((size_t)header[2], levels_max);
+		for (size_t i = 0; i < level_count; i++)
+			map_file.read(&levels[i], sizeof(MapLevel));
+		
+		tiled = true;
+		tile_cache = std::make_unique<std::array<CachedTile, tile_cache_size>>();
+	} else {
+		levels[0] = { header[0], header[1], 4 };
+		level_count = 1;
+	}
 	
-	lon_ratio = 180.0 / map_center_x;
-	lat_ratio = -90.0 / map_center_y;
+	set_zoom(0);
 	
 	return true;
 }
 
+void GeoMap::set_zoom(const size_t level) {
+	if (level >= level_count)
+		return;
+	
+	level_ = level;
+	map_width = levels[level_].width;
+	map_height = levels[level_].height;
+	
+	lon_ratio = 360.0 / map_width;
+	lat_ratio = -180.0 / map_height;
+	
+	// Recenter
+	marker_area = { };
+	move(lon_, lat_);
+}
+
 void GeoMap::set_mode(GeoMapMode mode) {
 	mode_ = mode;
 }
@@ -276,6 +409,19 @@ void GeoMapView::update_position(float lat, float lon, uint16_t angle) {
 void GeoMapView::setup() {
 	add_child(&geomap);
 	
+	if (geomap.zoom_levels() > 1) {
+		OptionsField::options_t zoom_options;
+		for (size_t level = 0; level < geomap.zoom_levels(); level++)
+			zoom_options.emplace_back("1:" + to_string_dec_uint(1 << level), level);
+		field_zoom.set_options(zoom_options);
+		add_child(&field_zoom);
+		
+		field_zoom.on_change = [this](size_t, OptionsField::value_t v) {
+			geomap.set_zoom(v);
+			geomap.set_dirty();
+		};
+	}
+	
 	geopos.set_altitude(altitude_);
 	geopos.set_lat(lat_);
 	geopos.set_lon(lon_);
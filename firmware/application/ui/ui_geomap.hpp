@@ -30,6 +30,9 @@
 
 #include "portapack.hpp"
 
+#include <array>
+#include <memory>
+
 namespace ui {
 
 enum GeoMapMode {
@@ -112,6 +115,13 @@ private:
 	};
 };
 
+/* ADSB/world_map.bin is either:
+ * - tiled: u16 0, u16 tile size, u16 level count, u16 0, then per level
+ *   { u16 width, u16 height, u32 offset }. Each level is half the size of
+ *   the previous one, stored as row-major tiles of tile_size x tile_size
+ *   RGB565 pixels (edge tiles padded), so a tile is one contiguous read.
+ * - the original scanline format: u16 width, u16 height, RGB565 rows.
+ */
 class GeoMap : public Widget {
 public:
 	std::function<void(float, float)> on_move { };
@@ -133,20 +143,56 @@ public:
  		angle_ = new_angle;
  	}
 
+	size_t zoom_levels() const {
+		return level_count;
+	}
+	void set_zoom(const size_t level);
+
 private:
+	static constexpr size_t tile_size = 32;
+	static constexpr size_t levels_max = 4;
+	static constexpr size_t tile_cache_size = 6;
+
+	struct MapLevel {
+		uint16_t width;
+		uint16_t height;
+		uint32_t offset;
+	};
+
+	struct CachedTile {
+		uint32_t key { 0xffffffff };
+		uint32_t last_used { 0 };
+		std::array<Color, tile_size * tile_size> pixels { };
+	};
+
 	void draw_bearing(const Point origin, const uint16_t angle, uint32_t size, const Color color);
+	void draw_markers(Painter& painter, const Point origin);
+	void draw_map(const Rect area);
+	void draw_map_lines(const Rect area);
+	const Color* tile(const uint32_t tx, const uint32_t ty);
 	
 	GeoMapMode mode_ { };
 	File map_file { };
+	bool tiled { false };
+	std::array<MapLevel, levels_max> levels { };
+	size_t level_count { 0 };
+	size_t level_ { 0 };
 	uint16_t map_width { }, map_height { };
-	int32_t map_center_x { }, map_center_y { };
 	float lon_ratio { }, lat_ratio { };
 	int32_t x_pos { }, y_pos { };
-	int32_t prev_x_pos { 0xFFFF }, prev_y_pos { 0xFFFF };
 	float lat_ { };
 	float lon_ { };
 	uint16_t angle_ { };
 	std::string tag_ { };
+
+	// When only the marker moved, just the area under the old one is
+	// redrawn. Any other repaint draws the whole map.
+	bool marker_only { false };
+	Point marker_pos { };
+	Rect marker_area { };
+
+	std::unique_ptr<std::array<CachedTile, tile_cache_size>> tile_cache { };
+	uint32_t tile_use_count { 0 };
 };
 
 class GeoMapView : public View {
@@ -212,6 +258,12 @@ private:
 		{ 20 * 8, 8, 8 * 8, 2 * 16 },
 		"OK"
 	};
+
+	OptionsField field_zoom {
+		{ 15 * 8, 0 * 16 },
+		4,
+		{ }
+	};
 };
 
 } /* namespace ui */
@@ -36,7 +36,17 @@ namespace ui {
 BasebandStatsView::BasebandStatsView() {
 	add_children({
 		&text_stats,
+		&text_stages_header,
+		&text_overruns,
 	});
+
+	for(size_t i=0; i<text_stages.size(); i++) {
+		text_stages[i].set_parent_rect({
+			0 * 8, static_cast<Coord>((2 + i) * 16),
+			30 * 8, 1 * 16
+		});
+		add_child(&text_stages[i]);
+	}
 }
 
 static std::string ticks_to_percent_string(const uint32_t ticks) {
@@ -59,4 +69,41 @@ void BasebandStatsView::on_statistics_update(const BasebandStatistics& statistic
 	text_stats.set(message);
 }
 
+static std::string cycles_to_percent_string(const uint32_t cycles, const uint32_t budget) {
+	if( budget == 0 ) {
+		return "  -.-";
+	}
+
+	const uint32_t percent_x10 = std::min<uint64_t>(static_cast<uint64_t>(cycles) * 1000 / budget, 9999);
+	return
+		to_string_dec_uint(percent_x10 / 10, 3) + "." +
+		to_string_dec_uint(percent_x10 % 10, 1, '0');
+}
+
+void BasebandStatsView::on_stage_statistics_update(const BasebandStageStatistics& statistics) {
+	static constexpr std::array<const char*, BasebandStageStatistics::StageCount> stage_names { {
+		"Execute ",
+		"Decimate",
+		"Filter  ",
+		"Demod   ",
+		"Audio   ",
+		"Spectrum",
+	} };
+
+	for(size_t i=0; i<statistics.stages.size(); i++) {
+		const auto& stage = statistics.stages[i];
+		text_stages[i].set(
+			std::string(stage_names[i])
+			+ " " + cycles_to_percent_string(stage.avg, statistics.budget)
+			+ " " + cycles_to_percent_string(stage.max, statistics.budget)
+			+ " " + to_string_dec_uint(stage.avg, 8)
+		);
+	}
+
+	text_overruns.set(
+		"Overruns " + to_string_dec_uint(statistics.overruns)
+		+ " of " + to_string_dec_uint(statistics.buffers) + " buffers"
+	);
+}
+
 } /* namespace ui */
@@ -28,6 +28,8 @@
 
 #include "message.hpp"
 
+#include <array>
+
 namespace ui {
 
 class BasebandStatsView : public View {
@@ -40,6 +42,18 @@ private:
 		"",
 	};
 
+	Text text_stages_header {
+		{  0 * 8, 1 * 16, 30 * 8, 1 * 16 },
+		"Stage     avg%  max%  avg cyc",
+	};
+
+	std::array<Text, BasebandStageStatistics::StageCount> text_stages { };
+
+	Text text_overruns {
+		{  0 * 8, (2 + BasebandStageStatistics::StageCount) * 16, 30 * 8, 1 * 16 },
+		"",
+	};
+
 	MessageHandlerRegistration message_handler_stats {
 		Message::ID::BasebandStatistics,
 		[this](const Message* const p) {
@@ -47,7 +61,15 @@ private:
 		}
 	};
 
+	MessageHandlerRegistration message_handler_stage_stats {
+		Message::ID::BasebandStageStatistics,
+		[this](const Message* const p) {
+			this->on_stage_statistics_update(static_cast<const BasebandStageStatisticsMessage*>(p)->statistics);
+		}
+	};
+
 	void on_statistics_update(const BasebandStatistics& statistics);
+	void on_stage_statistics_update(const BasebandStageStatistics& statistics);
 };
 
 } /* namespace ui */
@@ -38,6 +38,7 @@
 #include "ui_nrf_rx.hpp"
 #include "ui_aprs_tx.hpp"
 #include "ui_bht_tx.hpp"
+#include "ui_channel_monitor.hpp"
 #include "ui_coasterp.hpp"
 #include "ui_debug.hpp"
 #include "ui_encoders.hpp"
@@ -77,6 +78,7 @@
 #include "replay_app.hpp"
 #include "gps_sim_app.hpp"
 #include "soundboard_app.hpp"
+#include "subghz_app.hpp"
 #include "tpms_app.hpp"
 
 #include "core_control.hpp"
@@ -370,10 +372,12 @@ ReceiversMenuView::ReceiversMenuView(NavigationView& nav) {
 		{ "BTLE",		ui::Color::yellow(),	&bitmap_icon_btle,		[&nav](){ nav.push<BTLERxView>(); } },
 		{ "NRF", 		ui::Color::yellow(),	&bitmap_icon_nrf,		[&nav](){ nav.push<NRFRxView>(); } }, 
 		{ "Audio", 		ui::Color::green(),		&bitmap_icon_speaker,	[&nav](){ nav.push<AnalogAudioView>(); } },
+		{ "Ch.Monitor",	ui::Color::yellow(),	&bitmap_icon_scanner,	[&nav](){ nav.push<ChannelMonitorView>(); } },
 		{ "Analog TV", 	ui::Color::yellow(),	&bitmap_icon_sstv,		[&nav](){ nav.push<AnalogTvView>(); } },
 		{ "ERT Meter", 	ui::Color::green(), 	&bitmap_icon_ert,		[&nav](){ nav.push<ERTAppView>(); } },
 		{ "POCSAG", 	ui::Color::green(),		&bitmap_icon_pocsag,	[&nav](){ nav.push<POCSAGAppView>(); } },
 		{ "Radiosnde", 	ui::Color::green(),		&bitmap_icon_sonde,		[&nav](){ nav.push<SondeView>(); } },
+		{ "Sub-GHz", 	ui::Color::yellow(),	&bitmap_icon_remote,	[&nav](){ nav.push<SubGHzAppView>(); } },
 		{ "TPMS Cars", 	ui::Color::green(),		&bitmap_icon_tpms,		[&nav](){ nav.push<TPMSAppView>(); } },
 	});
 }
@@ -28,6 +28,7 @@ using namespace portapack;
 #include "io_wave.hpp"
 
 #include "baseband_api.hpp"
+#include "iq_bfp.hpp"
 #include "rtc_time.hpp"
 #include "string_format.hpp"
 #include "utility.hpp"
@@ -69,6 +70,7 @@ RecordView::RecordView(
 		&rect_background,
 		//&button_pitch_rssi,
 		&button_record,
+		&text_write_latency,
 		&text_record_filename,
 		&text_record_dropped,
 		&text_time_available,
@@ -106,6 +108,7 @@ void RecordView::set_sampling_rate(const size_t new_sampling_rate) {
 
 		button_record.hidden(sampling_rate == 0);
 		text_record_filename.hidden(sampling_rate == 0);
+		text_write_latency.hidden(sampling_rate == 0);
 		text_record_dropped.hidden(sampling_rate == 0);
 		text_time_available.hidden(sampling_rate == 0);
 		rect_background.hidden(sampling_rate != 0);
@@ -114,6 +117,40 @@ void RecordView::set_sampling_rate(const size_t new_sampling_rate) {
 	}
 }
 
+void RecordView::set_file_type(const FileType v) {
+	if( v != file_type ) {
+		stop();
+		file_type = v;
+		update_status_display();
+	}
+}
+
+CaptureConfig::Format RecordView::capture_format() const {
+	switch(file_type) {
+	case FileType::RawS8:
+		return CaptureConfig::Format::C8Direct;
+
+	case FileType::RawBFP:
+		return CaptureConfig::Format::BFP8;
+
+	default:
+		return CaptureConfig::Format::C16;
+	}
+}
+
+uint32_t RecordView::bytes_per_second() const {
+	switch(file_type) {
+	case FileType::RawS16:
+		return sampling_rate / 8 * 4;
+
+	case FileType::RawBFP:
+		return iq_bfp::encoded_bytes(sampling_rate / 8);
+
+	default:
+		return sampling_rate * 2;
+	}
+}
+
 bool RecordView::is_active() const {
 	return (bool)capture_thread;
 }
@@ -130,6 +167,7 @@ void RecordView::start() {
 	stop();
 
 	text_record_filename.set("");
+	text_write_latency.set("");
 	text_record_dropped.set("");
 
 	if( sampling_rate == 0 ) {
@@ -159,7 +197,9 @@ void RecordView::start() {
 		}
 		break;
 
+	case FileType::RawS8:
 	case FileType::RawS16:
+	case FileType::RawBFP:
 		{
 			const auto metadata_file_error = write_metadata_file(base_path.replace_extension(u".TXT"));
 			if( metadata_file_error.is_valid() ) {
@@ -168,7 +208,9 @@ void RecordView::start() {
 			}
 
 			auto p = std::make_unique<RawFileWriter>();
-			auto create_error = p->create(base_path.replace_extension(u".C16"));
+			auto create_error = p->create(base_path.replace_extension(
+				(file_type == FileType::RawS8) ? u".C8" : ((file_type == FileType::RawBFP) ? u".CBF" : u".C16")
+			));
 			if( create_error.is_valid() ) {
 				handle_error(create_error.value());
 			} else {
@@ -194,7 +236,12 @@ void RecordView::start() {
 			[](File::Error error) {
 				CaptureThreadDoneMessage message { error.code() };
 				EventDispatcher::send_message(message);
-			}
+			},
+			capture_format(),
+			std::min<File::Size>(
+				uint64_t(bytes_per_second()) * preallocate_seconds,
+				std::filesystem::space(u"").free
+			)
 		);
 	}
 
@@ -221,7 +268,8 @@ Optional<File::Error> RecordView::write_metadata_file(const std::filesystem::pat
 	if( create_error.is_valid() ) {
 		return create_error;
 	} else {
-		const auto error_line1 = file.write_line("sample_rate=" + to_string_dec_uint(sampling_rate / 8));
+		const auto file_sampling_rate = (file_type == FileType::RawS8) ? sampling_rate : (sampling_rate / 8);
+		const auto error_line1 = file.write_line("sample_rate=" + to_string_dec_uint(file_sampling_rate));
 		if( error_line1.is_valid() ) {
 			return error_line1;
 		}
@@ -242,6 +290,11 @@ void RecordView::update_status_display() {
 		const auto dropped_percent = std::min(99U, capture_thread->state().dropped_percent());
 		const auto s = to_string_dec_uint(dropped_percent, 2, ' ') + "\%";
 		text_record_dropped.set(s);
+
+		// Worst single buffer write so far
+		const auto& stats = capture_thread->write_stats();
+		const uint32_t latency_ms = uint64_t(stats.write_duration_max) * 1000U / halGetCounterFrequency();
+		text_write_latency.set(to_string_dec_uint(std::min(999U, latency_ms), 3, ' ') + "ms");
 	}
 	
 	/*if (pitch_rssi_enabled) {
@@ -250,8 +303,7 @@ void RecordView::update_status_display() {
 
 	if( sampling_rate ) {
 		const auto space_info = std::filesystem::space(u"");
-		const uint32_t bytes_per_second = file_type == FileType::WAV ? (sampling_rate * 2) : (sampling_rate / 8 * 4);
-		const uint32_t available_seconds = space_info.free / bytes_per_second;
+		const uint32_t available_seconds = space_info.free / bytes_per_second();
 		const uint32_t seconds = available_seconds % 60;
 		const uint32_t available_minutes = available_seconds / 60;
 		const uint32_t minutes = available_minutes % 60;
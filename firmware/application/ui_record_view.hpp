@@ -40,8 +40,10 @@ public:
 	std::function<void(std::string)> on_error { };
 
 	enum FileType {
+		RawS8 = 1,		// Full baseband rate, DMA-direct
 		RawS16 = 2,
 		WAV = 3,
+		RawBFP = 4,		// Decimated like RawS16, block floating point
 	};
 
 	RecordView(
@@ -56,6 +58,7 @@ public:
 	void focus() override;
 
 	void set_sampling_rate(const size_t new_sampling_rate);
+	void set_file_type(const FileType v);
 
 	void start();
 	void stop();
@@ -67,6 +70,8 @@ private:
 	void toggle();
 	//void toggle_pitch_rssi();
 	Optional<File::Error> write_metadata_file(const std::filesystem::path& filename);
+	CaptureConfig::Format capture_format() const;
+	uint32_t bytes_per_second() const;
 
 	void on_tick_second();
 	void update_status_display();
@@ -76,12 +81,15 @@ private:
 
 	//bool pitch_rssi_enabled = false;
 	const std::filesystem::path filename_stem_pattern;
-	const FileType file_type;
+	FileType file_type;
 	const size_t write_size;
 	const size_t buffer_count;
 	size_t sampling_rate { 0 };
 	SignalToken signal_token_tick_second { };
 
+	// Contiguous space reserved up front, unused space is freed on stop
+	static constexpr uint32_t preallocate_seconds = 10 * 60;
+
 	Rectangle rect_background {
 		Color::black()
 	};
@@ -106,6 +114,11 @@ private:
 		"",
 	};
 
+	Text text_write_latency {
+		{ 2 * 8, 0 * 16, 5 * 8, 16 },
+		"",
+	};
+
 	Text text_record_dropped {
 		{ 16 * 8, 0 * 16, 3 * 8, 16 },
 		"",
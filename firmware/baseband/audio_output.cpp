@@ -21,6 +21,7 @@
  */
 
 #include "audio_output.hpp"
+#include "stage_stats_collector.hpp"
 
 #include "portapack_shared_memory.hpp"
 
@@ -31,6 +32,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <array>
+#include <algorithm>
 
 void AudioOutput::configure(
 	const bool do_proc
@@ -43,44 +45,52 @@ void AudioOutput::configure(
 	const iir_biquad_config_t& deemph_config,
 	const float squelch_threshold
 ) {
-	hpf.configure(hpf_config);
-	deemph.configure(deemph_config);
+	filter.configure(0, hpf_config);
+	filter.configure(1, deemph_config);
 	squelch.set_threshold(squelch_threshold);
 }
 
 void AudioOutput::write(
 	const buffer_s16_t& audio
 ) {
-	std::array<float, 32> audio_f;
-	for(size_t i=0; i<audio.count; i++) {
-		audio_f[i] = audio.p[i] * ki;
-	}
-	write(buffer_f32_t {
-		audio_f.data(),
-		audio.count,
-		audio.sampling_rate
-	});
-}
+	const StageProbe probe { BasebandStageStatistics::AudioOutput };
 
-void AudioOutput::write(
-	const buffer_f32_t& audio
-) {
 	block_buffer.feed(
 		audio,
-		[this](const buffer_f32_t& buffer) {
+		[this](const buffer_s16_t& buffer) {
 			this->on_block(buffer);
 		}
 	);
 }
 
-void AudioOutput::on_block(
+void AudioOutput::write(
 	const buffer_f32_t& audio
+) {
+	const StageProbe probe { BasebandStageStatistics::AudioOutput };
+
+	/* Float demodulators are converted once here, the rest of the path is int16. */
+	std::array<int16_t, 32> audio_int;
+	for(size_t offset=0; offset<audio.count; offset+=audio_int.size()) {
+		const size_t count = std::min(audio.count - offset, audio_int.size());
+		for(size_t i=0; i<count; i++) {
+			const int32_t sample_int = audio.p[offset + i] * k;
+			audio_int[i] = __SSAT(sample_int, 16);
+		}
+		write(buffer_s16_t {
+			audio_int.data(),
+			count,
+			audio.sampling_rate
+		});
+	}
+}
+
+void AudioOutput::on_block(
+	const buffer_s16_t& audio
 ) {
 	if (do_processing) {
 		const auto audio_present_now = squelch.execute(audio);
 
-		hpf.execute_in_place(audio);
-		deemph.execute_in_place(audio);
+		filter.execute_in_place(audio);
 
 		audio_present_history = (audio_present_history << 1) | (audio_present_now ? 1 : 0);
 		audio_present = (audio_present_history != 0);
@@ -100,29 +110,24 @@ bool AudioOutput::is_squelched() {
 	return !audio_present;
 }
 
-void AudioOutput::fill_audio_buffer(const buffer_f32_t& audio, const bool send_to_fifo) {
-	std::array<int16_t, 32> audio_int;
-
+void AudioOutput::fill_audio_buffer(const buffer_s16_t& audio, const bool send_to_fifo) {
 	auto audio_buffer = audio::dma::tx_empty_buffer();
 	for(size_t i=0; i<audio_buffer.count; i++) {
-		const int32_t sample_int = audio.p[i] * k;
-		const int32_t sample_saturated = __SSAT(sample_int, 16);
-		audio_buffer.p[i].left = audio_buffer.p[i].right = sample_saturated;
-		audio_int[i] = sample_saturated;
+		audio_buffer.p[i].left = audio_buffer.p[i].right = audio.p[i];
 	}
 	if( stream && send_to_fifo ) {
-		stream->write(audio_int.data(), audio_buffer.count * sizeof(audio_int[0]));
+		stream->write(audio.p, audio_buffer.count * sizeof(audio.p[0]));
 	}
 
 	feed_audio_stats(audio);
 }
 
-void AudioOutput::feed_audio_stats(const buffer_f32_t& audio) {
+void AudioOutput::feed_audio_stats(const buffer_s16_t& audio) {
 	audio_stats.feed(
 		audio,
 		[](const AudioStatistics& statistics) {
 			const AudioStatisticsMessage audio_stats_message { statistics };
-			shared_memory.application_queue.push(audio_stats_message);
+			shared_memory.application_mailbox.post(audio_stats_message);
 		}
 	);
 }
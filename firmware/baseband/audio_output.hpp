@@ -56,12 +56,11 @@ public:
 
 private:
 	static constexpr float k = 32768.0f;
-	static constexpr float ki = 1.0f / k;
 
-	BlockDecimator<float, 32> block_buffer { 1 };	
+	BlockDecimator<int16_t, 32> block_buffer { 1 };	
 
-	IIRBiquadFilter hpf { };
-	IIRBiquadFilter deemph { };
+	/* Section 0 is the HPF, section 1 de-emphasis. */
+	IIRBiquadCascade<2> filter { };
 	FMSquelch squelch { };
 
 	std::unique_ptr<StreamInput> stream { };
@@ -73,9 +72,9 @@ private:
 	bool audio_present = false;
 	bool do_processing = true;
 
-	void on_block(const buffer_f32_t& audio);
-	void fill_audio_buffer(const buffer_f32_t& audio, const bool send_to_fifo);
-	void feed_audio_stats(const buffer_f32_t& audio);
+	void on_block(const buffer_s16_t& audio);
+	void fill_audio_buffer(const buffer_s16_t& audio, const bool send_to_fifo);
+	void feed_audio_stats(const buffer_s16_t& audio);
 };
 
 #endif/*__AUDIO_OUTPUT_H__*/
@@ -31,7 +31,7 @@
 class AudioStatsCollector {
 public:
 	template<typename Callback>
-	void feed(const buffer_f32_t& src, Callback callback) {
+	void feed(const buffer_s16_t& src, Callback callback) {
 		if( feed(src) ) {
 			callback(statistics);
 		}
@@ -46,17 +46,17 @@ public:
 
 private:
 	static constexpr float update_interval { 0.1f };
-	float squared_sum { 0 };
-	float max_squared { 0 };
+	uint64_t squared_sum { 0 };
+	uint32_t max_squared { 0 };
 	size_t count { 0 };
 
 	AudioStatistics statistics { };
 
-	void consume_audio_buffer(const buffer_f32_t& src);
+	void consume_audio_buffer(const buffer_s16_t& src);
 
 	bool update_stats(const size_t sample_count, const size_t sampling_rate);
 
-	bool feed(const buffer_f32_t& src);
+	bool feed(const buffer_s16_t& src);
 	bool mute(const size_t sample_count, const size_t sampling_rate);
 };
 
@@ -80,6 +80,7 @@ void _default_exit(void) {
 	shared_memory.application_queue.push(shutdown_message);
 
 	shared_memory.baseband_message = nullptr;
+	lpc43xx::creg::m4txevent::assert_event();
 
 	halt();
 }
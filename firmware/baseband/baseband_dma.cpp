@@ -90,7 +90,7 @@ constexpr size_t buffer_samples_log2n = 13;
 constexpr size_t buffer_samples = (1 << buffer_samples_log2n);
 constexpr size_t transfers_per_buffer_log2n = 2;
 constexpr size_t transfers_per_buffer = (1 << transfers_per_buffer_log2n);
-constexpr size_t transfer_samples = buffer_samples / transfers_per_buffer;
+static_assert(transfer_samples == buffer_samples / transfers_per_buffer, "DMA transfer size mismatch");
 constexpr size_t transfers_mask = transfers_per_buffer - 1;
 
 constexpr size_t buffer_bytes = buffer_samples * sizeof(baseband::sample_t);
@@ -103,8 +103,36 @@ static constexpr auto& gpdma_channel_sgpio = gpdma::channels[portapack::sgpio_gp
 
 static ThreadWait thread_wait;
 
+static baseband::sample_t* ring_base { nullptr };
+static baseband::Direction ring_direction { baseband::Direction::Receive };
+static size_t last_next_index { 0 };
+
+/* Memory address of each LLI's last completed transfer. */
+static std::array<uint32_t, transfers_per_buffer> buffer_address;
+
+static volatile uint32_t transfers_completed { 0 };
+static uint32_t transfers_returned { 0 };
+static size_t transfers_missed { 0 };
+
+static uint32_t ring_address(const size_t index) {
+	return reinterpret_cast<uint32_t>(&ring_base[index * transfer_samples]);
+}
+
 static void transfer_complete() {
 	const auto next_lli_index = gpdma_channel_sgpio.next_lli() - &lli_loop[0];
+	const size_t done_index = (next_lli_index + transfers_per_buffer - 2) & transfers_mask;
+	auto& lli = lli_loop[done_index];
+	if( ring_direction == Direction::Transmit ) {
+		buffer_address[done_index] = lli.srcaddr;
+	} else {
+		/* Back to the ring, so a destination given by set_next_destination()
+		 * is written once even if the thread falls behind and never repoints
+		 * this LLI. It is fetched again three transfers from now.
+		 */
+		buffer_address[done_index] = lli.destaddr;
+		lli.destaddr = ring_address(done_index);
+	}
+	transfers_completed = transfers_completed + 1;
 	thread_wait.wake_from_interrupt(next_lli_index);
 }
 
@@ -133,6 +161,8 @@ void configure(
 ) {
 	const auto peripheral = reinterpret_cast<uint32_t>(&LPC_SGPIO->REG_SS[0]);
 	const auto control_value = control(direction, gpdma::buffer_words(transfer_bytes, 4));
+	ring_base = buffer_base;
+	ring_direction = direction;
 	for(size_t i=0; i<lli_loop.size(); i++) {
 		const auto memory = reinterpret_cast<uint32_t>(&buffer_base[i * transfer_samples]);
 		lli_loop[i].srcaddr = (direction == Direction::Transmit) ? memory : peripheral;
@@ -144,6 +174,8 @@ void configure(
 
 void enable(const baseband::Direction direction) {
 	const auto gpdma_config = config(direction);
+	transfers_completed = 0;
+	transfers_returned = 0;
 	gpdma_channel_sgpio.configure(lli_loop[0], gpdma_config);
 	gpdma_channel_sgpio.enable();
 }
@@ -160,15 +192,41 @@ baseband::buffer_t wait_for_buffer() {
 	const auto next_index = thread_wait.sleep();
 	
 	if( next_index >= 0 ) {
+		/* Wakes while the thread is busy are lost, count those transfers. */
+		const uint32_t completed = transfers_completed;
+		transfers_missed = completed - transfers_returned - 1;
+		transfers_returned = completed;
+
+		last_next_index = next_index;
 		const size_t free_index = (next_index + transfers_per_buffer - 2) & transfers_mask;
-		const auto src = lli_loop[free_index].srcaddr;
-		const auto dst = lli_loop[free_index].destaddr;
-		const auto p = (src == reinterpret_cast<uint32_t>(&LPC_SGPIO->REG_SS[0])) ? dst : src;
-		return { reinterpret_cast<sample_t*>(p), transfer_samples };
+		return { reinterpret_cast<sample_t*>(buffer_address[free_index]), transfer_samples };
 	} else {
 		return { };
 	}
 }
 
+size_t missed_transfers() {
+	return transfers_missed;
+}
+
+bool set_next_destination(baseband::sample_t* const p) {
+	/* The LLI after next_lli() is not fetched until the transfer in progress
+	 * and the following one complete. If another transfer completed since
+	 * wait_for_buffer(), that LLI may be fetched at any moment, leave it be.
+	 */
+	const size_t index = (last_next_index + transfers_per_buffer - 2 + next_destination_lag) & transfers_mask;
+	if( static_cast<size_t>(gpdma_channel_sgpio.next_lli() - &lli_loop[0]) != last_next_index ) {
+		return false;
+	}
+	lli_loop[index].destaddr = p ? reinterpret_cast<uint32_t>(p) : ring_address(index);
+	return true;
+}
+
+void reset_destinations() {
+	for(size_t i=0; i<lli_loop.size(); i++) {
+		lli_loop[i].destaddr = ring_address(i);
+	}
+}
+
 } /* namespace dma */
 } /* namespace baseband */
@@ -31,6 +31,9 @@
 namespace baseband {
 namespace dma {
 
+/* Samples per DMA transfer, i.e. per buffer returned by wait_for_buffer(). */
+constexpr size_t transfer_samples = 2048;
+
 void init();
 void configure(
 	baseband::sample_t* const buffer_base,
@@ -44,6 +47,29 @@ void disable();
 
 baseband::buffer_t wait_for_buffer();
 
+/* Transfers that completed since the previous wait_for_buffer() without
+ * being returned, because the thread fell behind.
+ */
+size_t missed_transfers();
+
+/* Transfers between the buffer last returned by wait_for_buffer() and the
+ * one set_next_destination() points.
+ */
+constexpr size_t next_destination_lag = 3;
+
+/* Receive only. Points the transfer next_destination_lag after the buffer
+ * last returned by wait_for_buffer() at `p`, transfer_samples long and word
+ * aligned, instead of its slot in the ring. nullptr puts it back in the ring.
+ * Each transfer goes back to the ring once it completes, so `p` is written
+ * once. Returns false, changing nothing, if the thread fell behind and that
+ * transfer may already have started.
+ * wait_for_buffer() returns each buffer wherever its transfer was pointed.
+ */
+bool set_next_destination(baseband::sample_t* const p);
+
+/* Puts every transfer not yet started back in the ring. */
+void reset_destinations();
+
 } /* namespace dma */
 } /* namespace baseband */
 
@@ -30,7 +30,7 @@ void BasebandProcessor::feed_channel_stats(const buffer_c16_t& channel) {
 		channel,
 		[](const ChannelStatistics& statistics) {
 			const ChannelStatisticsMessage channel_stats_message { statistics };
-			shared_memory.application_queue.push(channel_stats_message);
+			shared_memory.application_mailbox.post(channel_stats_message);
 		}
 	);
 }
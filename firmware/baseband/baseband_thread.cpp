@@ -32,6 +32,7 @@
 using namespace lpc43xx;
 
 #include "portapack_shared_memory.hpp"
+#include "stage_stats_collector.hpp"
 
 #include "utility.hpp"
 
@@ -92,7 +93,14 @@ void BasebandThread::run() {
 			};
 
 			if( baseband_processor ) {
+				const auto execute_start = halGetCounterValue();
 				baseband_processor->execute(buffer);
+				stage_stats.process(buffer, halGetCounterValue() - execute_start,
+					[](const BasebandStageStatistics& statistics) {
+						const BasebandStageStatisticsMessage message { statistics };
+						shared_memory.application_mailbox.post(message);
+					}
+				);
 			}
 		}
 	}
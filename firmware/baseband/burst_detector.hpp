@@ -0,0 +1,103 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BURST_DETECTOR_H__
+#define __BURST_DETECTOR_H__
+
+#include "dsp_types.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <hal.h>
+
+/* Buffer-granular energy detector. Mean buffer power is compared against a
+ * tracked noise floor; a burst is flagged while power is above the floor by
+ * threshold_ratio, and held for hangover buffers after it drops.
+ */
+class BurstDetector {
+public:
+	constexpr BurstDetector(
+		const float threshold_ratio,
+		const size_t hangover
+	) : threshold_ratio { threshold_ratio },
+		hangover { hangover }
+	{
+	}
+
+	bool operator()(const float power) {
+		if( !initialized ) {
+			noise_floor = power;
+			initialized = true;
+		}
+
+		if( power > noise_floor * threshold_ratio ) {
+			hangover_count = hangover;
+		} else if( hangover_count > 0 ) {
+			hangover_count--;
+		}
+
+		/* Follow the floor down quickly and up slowly, and barely move it
+		 * while a burst is in progress.
+		 */
+		const float alpha = active() ? (1.0f / 1024.0f) :
+			((power < noise_floor) ? (1.0f / 4.0f) : (1.0f / 64.0f));
+		noise_floor += (power - noise_floor) * alpha;
+
+		return active();
+	}
+
+	bool active() const {
+		return hangover_count > 0;
+	}
+
+	static float power(const buffer_c8_t& buffer) {
+		/* Two complex8 samples per word: i0, q0, i1, q1. */
+		const uint32_t* p = reinterpret_cast<const uint32_t*>(buffer.p);
+		const uint32_t* const end = p + buffer.count / 2;
+		uint32_t sum = 0;
+		while(p < end) {
+			const uint32_t q1_i1_q0_i0 = *(p++);
+			const uint32_t i1_i0 = __SXTB16(q1_i1_q0_i0, 0);
+			const uint32_t q1_q0 = __SXTB16(q1_i1_q0_i0, 8);
+			sum = __SMLAD(i1_i0, i1_i0, sum);
+			sum = __SMLAD(q1_q0, q1_q0, sum);
+		}
+		return static_cast<float>(sum) / buffer.count;
+	}
+
+	static float power(const buffer_c16_t& buffer) {
+		auto src_p = buffer.p;
+		uint64_t sum = 0;
+		while(src_p < &buffer.p[buffer.count]) {
+			const uint32_t sample = *__SIMD32(src_p)++;
+			sum += static_cast<uint32_t>(__SMUAD(sample, sample));
+		}
+		return static_cast<float>(sum) / buffer.count;
+	}
+
+private:
+	const float threshold_ratio;
+	const size_t hangover;
+	size_t hangover_count { 0 };
+	float noise_floor { 0.0f };
+	bool initialized { false };
+};
+
+#endif/*__BURST_DETECTOR_H__*/
@@ -20,8 +20,11 @@
  */
 
 #include "channel_decimator.hpp"
+#include "stage_stats_collector.hpp"
 
 buffer_c16_t ChannelDecimator::execute_decimation(const buffer_c8_t& buffer) {
+	const StageProbe probe { BasebandStageStatistics::Decimation };
+
 	const buffer_c16_t work_baseband_buffer {
 		work_baseband.data(),
 		work_baseband.size()
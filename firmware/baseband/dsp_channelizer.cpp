@@ -0,0 +1,87 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_channelizer.hpp"
+#include "stage_stats_collector.hpp"
+
+#include "dsp_fft.hpp"
+#include "utility.hpp"
+
+#include <algorithm>
+
+#include <hal.h>
+
+namespace dsp {
+namespace channelize {
+
+void PolyphaseFFT::configure(const std::array<int16_t, taps_count>& taps) {
+	for(size_t p=0; p<bin_count; p++) {
+		for(size_t t=0; t<taps_per_branch; t++) {
+			taps_[p * taps_per_branch + t] = taps[t * bin_count + p];
+		}
+	}
+	std::fill(samples_.begin(), samples_.end(), complex16_t { 0, 0 });
+}
+
+size_t PolyphaseFFT::load(const buffer_c16_t& src) {
+	const size_t count = std::min(src.count, input_capacity) & ~(bin_count - 1);
+	std::copy(&src.p[0], &src.p[count], &samples_[history_count]);
+	return count / bin_count;
+}
+
+int PolyphaseFFT::filter(const size_t frame_index) {
+	const StageProbe probe { BasebandStageStatistics::ChannelFilter };
+
+	/* Branch p convolves its taps with every bin_count-th sample, starting
+	 * p samples back from the newest one in this frame. The branch outputs,
+	 * in bit-reversed order, are then FFTed into one sample per bin.
+	 */
+	const auto newest = &samples_[history_count + frame_index * bin_count + bin_count - 1];
+	const uint32_t* t_p = reinterpret_cast<const uint32_t*>(taps_.data());
+	for(size_t p=0; p<bin_count; p++) {
+		const uint32_t* z_p = reinterpret_cast<const uint32_t*>(newest - p);
+		int32_t real = 0;
+		int32_t imag = 0;
+		for(size_t t=0; t<taps_per_branch; t+=2) {
+			const uint32_t t1_t0 = *(t_p++);
+			const uint32_t z0 = *z_p;
+			z_p -= bin_count;
+			const uint32_t z1 = *z_p;
+			z_p -= bin_count;
+			real = __SMLABB(t1_t0, z0, real);
+			imag = __SMLABT(t1_t0, z0, imag);
+			real = __SMLATB(t1_t0, z1, real);
+			imag = __SMLATT(t1_t0, z1, imag);
+		}
+		frame[__RBIT(p) >> (32 - log_2(bin_count))] = {
+			static_cast<int16_t>(__SSAT(real >> 15, 16)),
+			static_cast<int16_t>(__SSAT(imag >> 15, 16))
+		};
+	}
+
+	return fft_c16_preswapped(frame);
+}
+
+void PolyphaseFFT::retire(const size_t frame_count) {
+	const auto end = &samples_[history_count + frame_count * bin_count];
+	std::copy(end - history_count, end, &samples_[0]);
+}
+
+} /* namespace channelize */
+} /* namespace dsp */
@@ -0,0 +1,85 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_CHANNELIZER_H__
+#define __DSP_CHANNELIZER_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+#include "dsp_types.hpp"
+
+namespace dsp {
+namespace channelize {
+
+/* Critically sampled polyphase FFT analysis filter bank. Splits a complex
+ * stream at fs into bin_count channels, each fs / bin_count wide and sampled
+ * at fs / bin_count. One frame (one output sample for every bin) is produced
+ * per bin_count input samples.
+ */
+class PolyphaseFFT {
+public:
+	static constexpr size_t bin_count = 32;
+	static constexpr size_t taps_per_branch = 12;
+	static constexpr size_t taps_count = bin_count * taps_per_branch;
+	static constexpr size_t input_capacity = 256;
+
+	using frame_t = std::array<complex16_t, bin_count>;
+
+	/* Prototype low-pass taps, normalized to 1 << 15 == 1.0 and designed
+	 * for a cutoff of half the bin spacing.
+	 */
+	void configure(const std::array<int16_t, taps_count>& taps);
+
+	/* Frame index of the channel centred at offset * (fs / bin_count). */
+	static constexpr size_t bin(const int32_t offset) {
+		return static_cast<size_t>(-offset) & (bin_count - 1);
+	}
+
+	/* Calls callback(frame, exponent) for every complete frame in src, where
+	 * the channel outputs are frame * 2^exponent.
+	 */
+	template<typename FrameCallback>
+	void execute(const buffer_c16_t& src, FrameCallback callback) {
+		const size_t frame_count = load(src);
+		for(size_t n=0; n<frame_count; n++) {
+			const int exponent = filter(n);
+			callback(frame, exponent);
+		}
+		retire(frame_count);
+	}
+
+private:
+	static constexpr size_t history_count = (taps_per_branch - 1) * bin_count;
+
+	/* Taps reordered by branch: taps_[p * taps_per_branch + t] = h[t * bin_count + p] */
+	alignas(4) std::array<int16_t, taps_count> taps_ { };
+	std::array<complex16_t, history_count + input_capacity> samples_ { };
+	frame_t frame { };
+
+	size_t load(const buffer_c16_t& src);
+	int filter(const size_t frame_index);
+	void retire(const size_t frame_count);
+};
+
+} /* namespace channelize */
+} /* namespace dsp */
+
+#endif/*__DSP_CHANNELIZER_H__*/
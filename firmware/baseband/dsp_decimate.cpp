@@ -20,6 +20,7 @@
  */
 
 #include "dsp_decimate.hpp"
+#include "stage_stats_collector.hpp"
 
 #include <hal.h>
 
@@ -207,6 +208,8 @@ buffer_c16_t FIRC8xR16x24FS4Decim4::execute(
 	const buffer_c8_t& src,
 	const buffer_c16_t& dst
 ) {
+	const StageProbe probe { BasebandStageStatistics::Decimation };
+
 	vec2_s16* const z = static_cast<vec2_s16*>(__builtin_assume_aligned(z_.data(), 4));
 	const vec2_s16* const t = static_cast<vec2_s16*>(__builtin_assume_aligned(taps_.data(), 4));
 	uint32_t* const d = static_cast<uint32_t*>(__builtin_assume_aligned(dst.p, 4));
@@ -263,6 +266,8 @@ buffer_c16_t FIRC8xR16x24FS4Decim8::execute(
 	const buffer_c8_t& src,
 	const buffer_c16_t& dst
 ) {
+	const StageProbe probe { BasebandStageStatistics::Decimation };
+
 	vec2_s16* const z = static_cast<vec2_s16*>(__builtin_assume_aligned(z_.data(), 4));
 	const vec2_s16* const t = static_cast<vec2_s16*>(__builtin_assume_aligned(taps_.data(), 4));
 	uint32_t* const d = static_cast<uint32_t*>(__builtin_assume_aligned(dst.p, 4));
@@ -318,6 +323,8 @@ buffer_c16_t FIRC16xR16x16Decim2::execute(
 	const buffer_c16_t& src,
 	const buffer_c16_t& dst
 ) {
+	const StageProbe probe { BasebandStageStatistics::Decimation };
+
 	vec2_s16* const z = static_cast<vec2_s16*>(__builtin_assume_aligned(z_.data(), 4));
 	const vec2_s16* const t = static_cast<vec2_s16*>(__builtin_assume_aligned(taps_.data(), 4));
 	uint32_t* const d = static_cast<uint32_t*>(__builtin_assume_aligned(dst.p, 4));
@@ -369,6 +376,8 @@ buffer_c16_t FIRC16xR16x32Decim8::execute(
 	const buffer_c16_t& src,
 	const buffer_c16_t& dst
 ) {
+	const StageProbe probe { BasebandStageStatistics::Decimation };
+
 	vec2_s16* const z = static_cast<vec2_s16*>(__builtin_assume_aligned(z_.data(), 4));
 	const vec2_s16* const t = static_cast<vec2_s16*>(__builtin_assume_aligned(taps_.data(), 4));
 	uint32_t* const d = static_cast<uint32_t*>(__builtin_assume_aligned(dst.p, 4));
@@ -414,6 +423,8 @@ buffer_c16_t FIRC16xR16x32Decim8::execute(
 }
 
 buffer_c16_t Complex8DecimateBy2CIC3::execute(const buffer_c8_t& src, const buffer_c16_t& dst) {
+	const StageProbe probe { BasebandStageStatistics::Decimation };
+
 	/* Decimates by two using a non-recursive third-order CIC filter.
 	 */
 
@@ -471,6 +482,8 @@ buffer_c16_t Complex8DecimateBy2CIC3::execute(const buffer_c8_t& src, const buff
 }
 
 buffer_c16_t TranslateByFSOver4AndDecimateBy2CIC3::execute(const buffer_c8_t& src, const buffer_c16_t& dst) {
+	const StageProbe probe { BasebandStageStatistics::Decimation };
+
 	/* Translates incoming complex<int8_t> samples by -fs/4,
 	 * decimates by two using a non-recursive third-order CIC filter.
 	 */
@@ -558,6 +571,8 @@ buffer_c16_t DecimateBy2CIC3::execute(
 	const buffer_c16_t& src,
 	const buffer_c16_t& dst
 ) {
+	const StageProbe probe { BasebandStageStatistics::Decimation };
+
 	/* Complex non-recursive 3rd-order CIC filter (taps 1,3,3,1).
 	 * Gain of 8.
 	 * Consumes 16 bytes (4 s16:s16 samples) per loop iteration,
@@ -616,6 +631,8 @@ buffer_s16_t FIR64AndDecimateBy2Real::execute(
 	const buffer_s16_t& src,
 	const buffer_s16_t& dst
 ) {
+	const StageProbe probe { BasebandStageStatistics::Decimation };
+
 	/* int16_t input (sample count "n" must be multiple of 4)
 	 * -> int16_t output, decimated by 2.
 	 * taps are normalized to 1 << 16 == 1.0.
@@ -658,6 +675,8 @@ buffer_c16_t FIRAndDecimateComplex::execute(
 	const buffer_c16_t& src,
 	const buffer_c16_t& dst
 ) {
+	const StageProbe probe { BasebandStageStatistics::ChannelFilter };
+
 	/* int16_t input (sample count "n" must be multiple of decimation_factor)
 	 * -> int16_t output, decimated by decimation_factor.
 	 * taps are normalized to 1 << 16 == 1.0.
@@ -768,6 +787,8 @@ buffer_s16_t DecimateBy2CIC4Real::execute(
 	const buffer_s16_t& src,
 	const buffer_s16_t& dst
 ) {
+	const StageProbe probe { BasebandStageStatistics::Decimation };
+
 	auto src_p = src.p;
 	auto dst_p = dst.p;
 	int32_t n = src.count;
@@ -20,6 +20,7 @@
  */
 
 #include "dsp_demodulate.hpp"
+#include "stage_stats_collector.hpp"
 
 #include "complex.hpp"
 #include "fxpt_atan2.hpp"
@@ -34,6 +35,8 @@ buffer_f32_t AM::execute(
 	const buffer_c16_t& src,
 	const buffer_f32_t& dst
 ) {
+	const StageProbe probe { BasebandStageStatistics::Demodulation };
+
 	const void* src_p = src.p;
 	const auto src_end = &src.p[src.count];
 	auto dst_p = dst.p;
@@ -53,6 +56,8 @@ buffer_f32_t SSB::execute(
 	const buffer_c16_t& src,
 	const buffer_f32_t& dst
 ) {
+	const StageProbe probe { BasebandStageStatistics::Demodulation };
+
 	const complex16_t* src_p = src.p;
 	const auto src_end = &src.p[src.count];
 	auto dst_p = dst.p;
@@ -88,6 +93,8 @@ buffer_f32_t FM::execute(
 	const buffer_c16_t& src,
 	const buffer_f32_t& dst
 ) {
+	const StageProbe probe { BasebandStageStatistics::Demodulation };
+
 	auto z = z_;
 
 	const void* src_p = src.p;
@@ -111,6 +118,8 @@ buffer_s16_t FM::execute(
 	const buffer_c16_t& src,
 	const buffer_s16_t& dst
 ) {
+	const StageProbe probe { BasebandStageStatistics::Demodulation };
+
 	auto z = z_;
 
 	const void* src_p = src.p;
@@ -24,22 +24,26 @@
 #include <cstdint>
 #include <array>
 
-bool FMSquelch::execute(const buffer_f32_t& audio) {
-	if( threshold_squared == 0.0f ) {
+FMSquelch::FMSquelch() {
+	non_audio_hpf.configure(0, non_audio_hpf_config);
+}
+
+bool FMSquelch::execute(const buffer_s16_t& audio) {
+	if( threshold_squared == 0 ) {
 		return true;
 	}
 
 	// TODO: No hard-coded array size.
-	std::array<float, N> squelch_energy_buffer;
-	const buffer_f32_t squelch_energy {
+	std::array<int16_t, N> squelch_energy_buffer;
+	const buffer_s16_t squelch_energy {
 		squelch_energy_buffer.data(),
 		squelch_energy_buffer.size()
 	};
 	non_audio_hpf.execute(audio, squelch_energy);
 
-	float non_audio_max_squared = 0;
+	uint32_t non_audio_max_squared = 0;
 	for(const auto sample : squelch_energy_buffer) {
-		const float sample_squared = sample * sample;
+		const uint32_t sample_squared = sample * sample;
 		if( sample_squared > non_audio_max_squared ) {
 			non_audio_max_squared = sample_squared;
 		}
@@ -49,5 +53,7 @@ bool FMSquelch::execute(const buffer_f32_t& audio) {
 }
 
 void FMSquelch::set_threshold(const float new_value) {
-	threshold_squared = new_value * new_value;
+	/* Threshold is relative to full scale, compare against int16 squared. */
+	const float threshold = new_value * 32768.0f;
+	threshold_squared = threshold * threshold;
 }
@@ -31,15 +31,17 @@
 
 class FMSquelch {
 public:
-	bool execute(const buffer_f32_t& audio);
+	FMSquelch();
+
+	bool execute(const buffer_s16_t& audio);
 
 	void set_threshold(const float new_value);
 
 private:
 	static constexpr size_t N = 32;
-	float threshold_squared { 0.0f };
+	uint32_t threshold_squared { 0 };
 
-	IIRBiquadFilter non_audio_hpf { non_audio_hpf_config };
+	IIRBiquadCascade<1> non_audio_hpf { };
 };
 
 #endif/*__DSP_SQUELCH_H__*/
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2015 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __ERT_DEMODULATOR_H__
+#define __ERT_DEMODULATOR_H__
+
+#include "dsp_types.hpp"
+
+#include "clock_recovery.hpp"
+#include "packet_builder.hpp"
+#include "baseband_packet.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+// ''.join(['%d%d' % (c, 1-c) for c in map(int, bin(0x1f2a60)[2:].zfill(21))])
+constexpr uint64_t scm_preamble_and_sync_manchester { 0b101010101001011001100110010110100101010101 };
+constexpr size_t scm_preamble_and_sync_length { 42 - 10 };
+constexpr size_t scm_payload_length_max { 150 };
+
+// ''.join(['%d%d' % (c, 1-c) for c in map(int, bin(0x555516a3)[2:].zfill(32))])
+constexpr uint64_t idm_preamble_and_sync_manchester { 0b0110011001100110011001100110011001010110011010011001100101011010 };
+constexpr size_t idm_preamble_and_sync_length { 64 - 16 };
+
+constexpr size_t idm_payload_length_max { 1408 };
+
+/* SCM and IDM meter packets from the magnitude of the raw baseband, pushed
+ * to the application as ERTPacketMessage. The sampling rate must be a
+ * multiple of twice the 32768 symbol/s Manchester rate.
+ */
+class ERTDemodulator {
+public:
+	ERTDemodulator(const uint32_t sampling_rate);
+
+	void execute(const buffer_c8_t& buffer) {
+		update_offset(buffer);
+		demodulate(buffer);
+	}
+
+	/* Tracks the DC offset, which has to keep up even while demodulate()
+	 * isn't being called.
+	 */
+	void update_offset(const buffer_c8_t& buffer);
+	void demodulate(const buffer_c8_t& buffer);
+
+private:
+	static constexpr float symbol_rate = 32768;
+
+	const size_t samples_per_half_symbol;
+	const float k;
+
+	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
+		symbol_rate * 2, symbol_rate, { 1.0f / 18.0f },
+		[this](const float symbol) { this->consume_symbol(symbol); }
+	};
+
+	void consume_symbol(const float symbol);
+	void scm_handler(const baseband::Packet& packet);
+	void idm_handler(const baseband::Packet& packet);
+
+	PacketBuilder<BitPattern32, NeverMatch, FixedLength, PacketHandler<ERTDemodulator, &ERTDemodulator::scm_handler>> scm_builder {
+		{ static_cast<uint32_t>(scm_preamble_and_sync_manchester), scm_preamble_and_sync_length, 1 },
+		{ },
+		{ scm_payload_length_max },
+		{ this }
+	};
+
+	PacketBuilder<BitPattern, NeverMatch, FixedLength, PacketHandler<ERTDemodulator, &ERTDemodulator::idm_handler>> idm_builder {
+		{ idm_preamble_and_sync_manchester, idm_preamble_and_sync_length, 1 },
+		{ },
+		{ idm_payload_length_max },
+		{ this }
+	};
+
+	/* Half-symbol magnitude sum, carried over when a buffer ends mid-way. */
+	float sum { 0.0f };
+	size_t sum_count { 0 };
+
+	float sum_half_period[2];
+	float sum_period[3];
+	float manchester[3];
+
+	const size_t average_window { 2048 };
+	int32_t average_i { 0 };
+	int32_t average_q { 0 };
+	size_t average_count { 0 };
+	float offset_i { 0.0f };
+	float offset_q { 0.0f };
+
+	float abs(const complex8_t& v);
+	void consume_half_period(const float sum);
+};
+
+#endif/*__ERT_DEMODULATOR_H__*/
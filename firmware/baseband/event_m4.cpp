@@ -104,6 +104,8 @@ void EventDispatcher::on_message(const Message* const message) {
 	default:
 		on_message_default(message);
 		shared_memory.baseband_message = nullptr;
+		// Wakes the M0, waiting in baseband::send_message().
+		creg::m4txevent::assert_event();
 		break;
 	}
 }
@@ -21,10 +21,9 @@
 
 #include "matched_filter.hpp"
 
-#include <algorithm>
 #include <cmath>
 
-#include "utility.hpp"
+#include <hal.h>
 
 namespace dsp {
 namespace matched_filter {
@@ -34,74 +33,71 @@ void MatchedFilter::configure(
 	const size_t taps_count,
 	const size_t decimation_factor
 ) {
-	samples_ = std::make_unique<samples_t>(taps_count);
-	taps_reversed_ = std::make_unique<taps_t>(taps_count);
+	samples_ = std::make_unique<packed_t>(taps_count * 2);
+	taps_reversed_ = std::make_unique<packed_t>(taps_count);
 	taps_count_ = taps_count;
+	write_index = 0;
 	decimation_factor_ = decimation_factor;
+	decimation_phase = 0;
 	output = 0;
-	std::reverse_copy(&taps[0], &taps[taps_count], &taps_reversed_[0]);
+
+	/* |re*tr + im*ti| <= 32768 * (|tr| + |ti|), summed over the taps. */
+	float taps_abs_sum = 0.0f;
+	for(size_t n=0; n<taps_count; n++) {
+		taps_abs_sum += std::abs(taps[n].real()) + std::abs(taps[n].imag());
+	}
+	const float taps_scale = (taps_abs_sum > 0.0f) ? (32000.0f / taps_abs_sum) : 1.0f;
+	taps_scale_inverse = 1.0f / taps_scale;
+
+	for(size_t n=0; n<taps_count; n++) {
+		const auto tap = taps[taps_count - 1 - n];
+		const complex16_t tap_q {
+			static_cast<int16_t>(std::lround(tap.real() * taps_scale)),
+			static_cast<int16_t>(std::lround(tap.imag() * taps_scale))
+		};
+		taps_reversed_[n] = tap_q.__rep();
+	}
 }
 
 bool MatchedFilter::execute_once(
 	const sample_t input
 ) {
-	samples_[taps_count_ - decimation_factor_ + decimation_phase] = input;
+	samples_[write_index] = input.__rep();
+	samples_[write_index + taps_count_] = input.__rep();
+	write_index = (write_index + 1 < taps_count_) ? (write_index + 1) : 0;
 
 	advance_decimation_phase();
 	if( is_new_decimation_cycle() ) {
-		float sr_tr = 0.0f;
-		float si_tr = 0.0f;
-		float si_ti = 0.0f;
-		float sr_ti = 0.0f;
-		for(size_t n=0; n<taps_count_; n++) {
-			const auto sample = samples_[n];
-			const auto tap = taps_reversed_[n];
-
-			sr_tr += sample.real() * tap.real();
-			si_ti += sample.imag() * tap.imag();
-			si_tr += sample.imag() * tap.real();
-			sr_ti += sample.real() * tap.imag();
-		}
+		// Oldest sample first, lining up with the reversed taps.
+		const uint32_t* const s = &samples_[write_index];
+		const uint32_t* const t = &taps_reversed_[0];
 
 		// N: complex multiple of samples and taps (conjugate, tap.i negated).
 		// P: complex multiply of samples and taps.
-		const auto r_n = sr_tr + si_ti;
-		const auto r_p = sr_tr - si_ti;
-		const auto i_n = si_tr - sr_ti;
-		const auto i_p = si_tr + sr_ti;
+		int32_t r_n = 0;
+		int32_t r_p = 0;
+		int32_t i_n = 0;
+		int32_t i_p = 0;
+		for(size_t n=0; n<taps_count_; n++) {
+			r_n = __SMLAD(s[n], t[n], r_n);		// sr * tr + si * ti
+			r_p = __SMLSD(s[n], t[n], r_p);		// sr * tr - si * ti
+			i_n = __SMLSDX(s[n], t[n], i_n);	// sr * ti - si * tr, sign doesn't matter
+			i_p = __SMLADX(s[n], t[n], i_p);	// sr * ti + si * tr
+		}
 
-		const auto mag_n = std::sqrt(r_n * r_n + i_n * i_n);
-		const auto mag_p = std::sqrt(r_p * r_p + i_p * i_p);
-		const auto diff = mag_p - mag_n;
-		output = diff;
+		const float r_n_f = r_n;
+		const float r_p_f = r_p;
+		const float i_n_f = i_n;
+		const float i_p_f = i_p;
+		const auto mag_n = std::sqrt(r_n_f * r_n_f + i_n_f * i_n_f);
+		const auto mag_p = std::sqrt(r_p_f * r_p_f + i_p_f * i_p_f);
+		output = (mag_p - mag_n) * taps_scale_inverse;
 
-		shift_by_decimation_factor();
 		return true;
 	} else {
 		return false;
 	}
 }
 
-void MatchedFilter::shift_by_decimation_factor() {
-	const sample_t* s = &samples_[decimation_factor_];
-	sample_t* t = &samples_[0];
-	
-	const size_t unroll_factor = 4;
-	size_t shift_count = (taps_count_ - decimation_factor_) / unroll_factor;	
-	while(shift_count > 0) {
-		*t++ = *s++;
-		*t++ = *s++;
-		*t++ = *s++;
-		*t++ = *s++;
-		shift_count--;
-	}
-
-	shift_count = (taps_count_ - decimation_factor_) % unroll_factor;
-	while(shift_count > 0) {
-		*t++ = *s++;
-		shift_count--;
-	}
-}
-
 } /* namespace matched_filter */
 } /* namespace dsp */
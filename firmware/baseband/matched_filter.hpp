@@ -23,9 +23,12 @@
 #define __MATCHED_FILTER_H__
 
 #include <cstddef>
+#include <cstdint>
 #include <complex>
 #include <memory>
 
+#include "complex.hpp"
+
 namespace dsp {
 namespace matched_filter {
 
@@ -33,14 +36,19 @@ namespace matched_filter {
 // combine a low-pass filter with a complex sinusoid that performs shifting of
 // the input signal to 0Hz/DC. This also means that the taps length must be
 // a multiple of the complex sinusoid period.
+//
+// Samples and taps are packed int16 pairs, so each tap is four dual 16-bit
+// MACs. Taps are scaled so no input can overflow the 32-bit accumulators.
+// The history is a mirrored circular buffer (each sample is stored twice,
+// taps_count apart), so the newest taps_count samples are always contiguous
+// and nothing has to be shifted. Only every decimation_factor'th output is
+// computed.
 
 class MatchedFilter {
 public:
-	using sample_t = std::complex<float>;
+	using sample_t = complex16_t;
 	using tap_t = std::complex<float>;
 
-	using taps_t = tap_t[];
-
 	template<class T>
 	MatchedFilter(
 		const T& taps,
@@ -64,17 +72,17 @@ public:
 	}
 
 private:
-	using samples_t = sample_t[];
+	using packed_t = uint32_t[];
 
-	std::unique_ptr<samples_t> samples_ { };
-	std::unique_ptr<taps_t> taps_reversed_ { };
+	std::unique_ptr<packed_t> samples_ { };
+	std::unique_ptr<packed_t> taps_reversed_ { };
+	float taps_scale_inverse { 1.0f };
 	size_t taps_count_ { 0 };
+	size_t write_index { 0 };
 	size_t decimation_factor_ { 1 };
 	size_t decimation_phase { 0 };
 	float output { 0 };
 
-	void shift_by_decimation_factor();
-
 	void advance_decimation_phase() {
 		decimation_phase = (decimation_phase + 1) % decimation_factor_;
 	}
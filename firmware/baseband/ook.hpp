@@ -56,6 +56,11 @@ public:
 		return symbol;
 	}
 
+	/* Forgets the decaying peak, so the next burst sets its own threshold. */
+	void reset() {
+		mag2_threshold = 0;
+	}
+
 private:
 	const uint32_t mag2_threshold_leak_factor;
 	uint32_t mag2_threshold = 0;
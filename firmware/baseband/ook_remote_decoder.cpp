@@ -0,0 +1,124 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ook_remote_decoder.hpp"
+
+#include "portapack_shared_memory.hpp"
+#include "message.hpp"
+
+#include <algorithm>
+
+void OOKRemoteDecoder::execute(const buffer_c16_t& channel) {
+	for(size_t i=0; i<channel.count; i+=channel_decimation) {
+		const bool sliced = slicer(channel.p[i]);
+
+		if( since_last_frame < repeat_holdoff ) {
+			since_last_frame++;
+		}
+
+		if( sliced == level ) {
+			if( run_length < run_length_max ) {
+				run_length++;
+			}
+
+			if( !level && (high_length > 0) ) {
+				const uint32_t gap_length = bit_count ? (short_estimate() * 8) : pulse_max;
+				if( run_length > gap_length ) {
+					end_frame();
+				}
+			}
+			continue;
+		}
+
+		if( level ) {
+			high_length = run_length;
+		} else if( high_length > 0 ) {
+			consume_pair(high_length, run_length);
+		}
+
+		level = sliced;
+		run_length = 1;
+	}
+}
+
+void OOKRemoteDecoder::idle(const buffer_c16_t& channel) {
+	if( high_length > 0 ) {
+		end_frame();
+	}
+	level = false;
+	run_length = 0;
+	slicer.reset();
+
+	since_last_frame = std::min<uint32_t>(since_last_frame + channel.count / channel_decimation, repeat_holdoff);
+}
+
+void OOKRemoteDecoder::consume_pair(const uint32_t high, const uint32_t low) {
+	high_length = 0;
+
+	const auto short_length = std::min(high, low);
+	const auto long_length = std::max(high, low);
+	const bool valid =
+		(short_length >= pulse_min) &&
+		(long_length <= pulse_max) &&
+		(long_length >= short_length * 2) &&
+		(long_length <= short_length * 5);
+
+	if( !valid ) {
+		end_frame();
+		return;
+	}
+
+	code = (code << 1) | ((high > low) ? 1 : 0);
+	bit_count++;
+	short_sum += short_length;
+
+	if( bit_count == bit_count_max ) {
+		end_frame();
+	}
+}
+
+/* The pulse before the gap has no low of its own to compare against, and may
+ * as well be a sync pulse; it's dropped.
+ */
+void OOKRemoteDecoder::end_frame() {
+	if( bit_count >= bit_count_min ) {
+		const bool repeat =
+			(code == last_code) &&
+			(bit_count == last_bit_count) &&
+			(since_last_frame < repeat_holdoff);
+		if( repeat ) {
+			if( !last_reported ) {
+				const OOKRemotePacketMessage message { code, bit_count, short_estimate() * 1000000 / sampling_rate };
+				shared_memory.application_queue.push(message);
+				last_reported = true;
+			}
+		} else {
+			last_reported = false;
+		}
+
+		last_code = code;
+		last_bit_count = bit_count;
+		since_last_frame = 0;
+	}
+
+	code = 0;
+	bit_count = 0;
+	short_sum = 0;
+	high_length = 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __OOK_REMOTE_DECODER_H__
+#define __OOK_REMOTE_DECODER_H__
+
+#include "dsp_types.hpp"
+
+#include "ook.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+/* Pulse-width coded OOK remotes and sensors (PT2262/EV1527 style), from a
+ * 307.2kHz channel. Each bit is a high/low pulse pair with a long:short ratio
+ * of 2 to 5, the longer high meaning 1. A gap of more than 8 short pulses
+ * ends the frame. There's no checksum to go by, so a code is only pushed as
+ * an OOKRemotePacketMessage once two frames in a row agree, and only once per
+ * run of repeats.
+ */
+class OOKRemoteDecoder {
+public:
+	void execute(const buffer_c16_t& channel);
+
+	/* Called instead of execute() while there's no signal: ends any frame in
+	 * progress, ages the repeat suppression and resets the slicer, so a weak
+	 * remote after a strong one isn't sliced against the strong one's peak.
+	 */
+	void idle(const buffer_c16_t& channel);
+
+private:
+	static constexpr size_t channel_decimation = 2;
+	static constexpr uint32_t sampling_rate = 307200 / channel_decimation;
+
+	static constexpr uint32_t pulse_min = sampling_rate * 80 / 1000000;
+	static constexpr uint32_t pulse_max = sampling_rate * 2500 / 1000000;
+	static constexpr uint32_t run_length_max = 65535;
+	static constexpr uint32_t repeat_holdoff = sampling_rate / 10;
+
+	static constexpr size_t bit_count_min = 12;
+	static constexpr size_t bit_count_max = 64;
+
+	OOKSlicerMagSquaredInt slicer { sampling_rate / 2000.0f };
+
+	bool level { false };
+	uint32_t run_length { 0 };
+	uint32_t high_length { 0 };
+
+	uint64_t code { 0 };
+	size_t bit_count { 0 };
+	uint32_t short_sum { 0 };
+
+	uint64_t last_code { 0 };
+	size_t last_bit_count { 0 };
+	bool last_reported { false };
+	uint32_t since_last_frame { repeat_holdoff };
+
+	uint32_t short_estimate() const {
+		return bit_count ? (short_sum / bit_count) : pulse_max;
+	}
+
+	void consume_pair(const uint32_t high, const uint32_t low);
+	void end_frame();
+};
+
+#endif/*__OOK_REMOTE_DECODER_H__*/
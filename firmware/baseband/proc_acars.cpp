@@ -65,14 +65,14 @@ void ACARSProcessor::execute(const buffer_c8_t& buffer) {
 	// }
 
 	packet_builder.execute(decoded_symbol); //euquiq this was commented
-}
+} */
 
 void ACARSProcessor::payload_handler(
 	const baseband::Packet& packet
 ) {
 	const ACARSPacketMessage message { packet };
 	shared_memory.application_queue.push(message);
-} */
+}
 
 int main() {
 	EventDispatcher event_dispatcher { std::make_unique<ACARSProcessor>() };
@@ -143,6 +143,8 @@ private:
 	*/
 
 
+	void payload_handler(const baseband::Packet& packet);
+
  	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
 		4800, 2400, { 0.0555f },
 		[this](const float raw_symbol) { 
@@ -150,21 +152,17 @@ private:
 			this->packet_builder.execute(sliced_symbol);
 		}
 	};
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder {
+	PacketBuilder<BitPattern32, NeverMatch, FixedLength, PacketHandler<ACARSProcessor, &ACARSProcessor::payload_handler>> packet_builder {
 		{ 0b011010000110100010000000, 24, 1 }, // SYN 01101000, SYN 01101000, SOH 10000000
 		//{ 0b1101010101010100011010000110100010000000, 40, 1 },	// + * SYN, SYN, SOH 7bits + parity, back to front
 		{ },
 		{ 128 },	//256 bytes = 2048bits
-		[this](const baseband::Packet& packet) {
-			const ACARSPacketMessage message { packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ this }
 	}; 
 
 	//baseband::Packet packet { };
 
 	//void consume_symbol(const float symbol);
-	//void payload_handler(const baseband::Packet& packet);
 };
 
 //#endif/*__PROC_ACARS_H__*/
@@ -22,128 +22,176 @@
 
 #include "proc_adsbrx.hpp"
 #include "portapack_shared_memory.hpp"
-#include "sine_table_int8.hpp"
 #include "event_m4.hpp"
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstdint>
 #include <cstddef>
 
 using namespace adsb;
-	
+
+ADSBRXProcessor::ADSBRXProcessor() {
+	for (size_t i = 0; i < bit_syndromes.size(); i++) {
+		ADSBFrame error_frame { };
+		const uint32_t bit = i + 5;
+		error_frame.flip_bit(bit);
+		bit_syndromes[i] = { error_frame.syndrome(), bit };
+	}
+
+	std::sort(bit_syndromes.begin(), bit_syndromes.end(),
+		[](const BitSyndrome& a, const BitSyndrome& b) { return a.syndrome < b.syndrome; });
+}
+
+/* Correlates the 8us preamble starting at `start`, pulses at 0, 1, 3.5 and
+ * 4.5us (samples 0, 2, 7, 9). Returns the pulse energy in excess of the
+ * gaps, or 0 if the shape doesn't match.
+ */
+int32_t ADSBRXProcessor::preamble_score(const uint32_t start) const {
+	// Most samples fail the first comparisons, don't fetch the rest for them
+	if (!((mag(start) > mag(start + 1)) && (mag(start + 1) < mag(start + 2))))
+		return 0;
+
+	uint32_t m[ADSB_PREAMBLE_LENGTH];
+	for (size_t i = 0; i < ADSB_PREAMBLE_LENGTH; i++)
+		m[i] = mag(start + i);
+
+	if (!((m[0] > m[1]) && (m[1] < m[2]) && (m[2] > m[3]) && (m[3] < m[0]) &&
+		(m[4] < m[0]) && (m[5] < m[0]) && (m[6] < m[0]) &&
+		(m[7] > m[8]) && (m[8] < m[9]) && (m[9] > m[6])))
+		return 0;
+
+	const uint32_t pulses = m[0] + m[2] + m[7] + m[9];
+	if (pulses < (pulse_level_min * 4))
+		return 0;
+
+	// No absolute gap limit: a strong frame over a weaker one's tail has the
+	// weak pulses in its gaps. The score and the CRC sort those out.
+	uint32_t gaps = m[1] + m[3] + m[4] + m[5] + m[6] + m[8];
+	for (size_t i = 10; i < ADSB_PREAMBLE_LENGTH; i++)
+		gaps += m[i];
+
+	// 4 pulse samples against 12 gap samples
+	return (int32_t)(pulses * 3) - (int32_t)gaps;
+}
+
+/* Slices the 112 bits following the preamble at `start`, and keeps the frame
+ * if its CRC checks, possibly after correcting DF17/18 bit errors. Short
+ * frames and frames with the address overlaid on the parity can't be checked
+ * here.
+ */
+bool ADSBRXProcessor::decode(const uint32_t start, ADSBFrame& frame) const {
+	const uint32_t data = start + ADSB_PREAMBLE_LENGTH;
+	uint8_t byte = 0;
+
+	frame.clear();
+	for (size_t bit = 0; bit < 112; bit++) {
+		// Pulse position: 1 is high then low, 0 is low then high
+		byte = (byte << 1) | ((mag(data + bit * 2) > mag(data + bit * 2 + 1)) ? 1 : 0);
+		if ((bit & 7) == 7)
+			frame.push_byte(byte);
+	}
+
+	if (frame.get_DF() < 16)
+		return false;
+
+	if (frame.syndrome() == 0)
+		return true;
+
+	if ((frame.get_DF() == 17) || (frame.get_DF() == 18))
+		return correct(frame);
+
+	return false;
+}
+
+int32_t ADSBRXProcessor::find_bit(const uint32_t syndrome) const {
+	const auto it = std::lower_bound(bit_syndromes.begin(), bit_syndromes.end(), syndrome,
+		[](const BitSyndrome& a, const uint32_t s) { return a.syndrome < s; });
+
+	if ((it == bit_syndromes.end()) || (it->syndrome != syndrome))
+		return -1;
+
+	return it->bit;
+}
+
+/* Syndromes add, so a two bit error's syndrome XORed with one of its bits'
+ * syndromes gives the other's. One table lookup per bit finds both.
+ */
+bool ADSBRXProcessor::correct(ADSBFrame& frame) const {
+	const uint32_t syndrome = frame.syndrome();
+
+	const auto single = find_bit(syndrome);
+	if (single >= 0) {
+		frame.flip_bit(single);
+		return true;
+	}
+
+	for (const auto& first : bit_syndromes) {
+		const auto second = find_bit(syndrome ^ first.syndrome);
+		if ((second >= 0) && ((uint32_t)second != first.bit)) {
+			frame.flip_bit(first.bit);
+			frame.flip_bit(second);
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void ADSBRXProcessor::execute(const buffer_c8_t& buffer) {
-	int8_t re, im;
-	float mag;
-	uint32_t c;
-	uint8_t level, bit, byte { };
-	//bool confidence;
-	bool first_in_window, last_in_window;
-	
 	// This is called at 2M/2048 = 977Hz
-	// One pulse = 500ns = 2 samples
-	// One bit = 2 pulses = 1us = 4 samples
+	// One pulse = 500ns = 1 sample
+	// One bit = 2 pulses = 1us = 2 samples
 	
 	if (!configured) return;
 	
 	for (size_t i = 0; i < buffer.count; i++) {
-		
-		// Compute sample's magnitude
-		re = buffer.p[i].real();
-		im = buffer.p[i].imag();
-		mag = __builtin_sqrtf((re * re) + (im * im)) * k;
-		
-		// Only used for preamble detection and visualisation
-		level = (mag < 0.3) ? 0 :		// Blank weak signals
-					(mag > prev_mag) ? 1 : 0;
-		
-		if (decoding) {
-			// Decode
-			
-			// 1 bit lasts 2 samples
-			if (sample_count & 1) {
-				if ((prev_mag < threshold_low) && (mag < threshold_low)) {
-					// Both under window, silence.
-					if (null_count > 3) {
-						const ADSBFrameMessage message(frame);
-						shared_memory.application_queue.push(message);
-							
-						decoding = false;
-					} else
-						null_count++;
-						
-					//confidence = false;
-					if (prev_mag > mag)
-						bit = 1;
-					else
-						bit = 0;
-					
-				} else {
-					
-					null_count = 0;
-				
-					first_in_window = ((prev_mag >= threshold_low) && (prev_mag <= threshold_high));
-					last_in_window = ((mag >= threshold_low) && (mag <= threshold_high));
-					
-					if ((first_in_window && !last_in_window) || (!first_in_window && last_in_window)) {
-						//confidence = true;
-						if (prev_mag > mag)
-							bit = 1;
-						else
-							bit = 0;
-					} else {
-						//confidence = false;
-						if (prev_mag > mag)
-							bit = 1;
-						else
-							bit = 0;
-					}
-				}
-				
-				byte = bit | (byte << 1);
-				bit_count++;
-				if (!(bit_count & 7)) {
-					// Got one byte
-					frame.push_byte(byte);
-				}
-			}
-			sample_count++;
-		} else {
-			// Look for preamble
-			
-			// Shift
-			for (c = 0; c < (ADSB_PREAMBLE_LENGTH - 1); c++)
-				shifter[c] = shifter[c + 1];
-			shifter[15] = std::make_pair(mag, level);
-			
-			// Compare
-			for (c = 0; c < ADSB_PREAMBLE_LENGTH; c++) {
-				if (shifter[c].second != adsb_preamble[c])
-					break;
-			}
-				
-			if (c == ADSB_PREAMBLE_LENGTH) {
-				decoding = true;
-				sample_count = 0;
-				null_count = 0;
-				bit_count = 0;
-				frame.clear();
-				
-				// Compute preamble pulses power to set thresholds
-				threshold = (shifter[0].first + shifter[2].first + shifter[7].first + shifter[9].first) / 4;
-				threshold_high = threshold * 1.414;		// +3dB
-				threshold_low = threshold * 0.707;		// -3dB
+		// Alpha max plus beta min magnitude, alpha = 1, beta = 3/8
+		const uint32_t re = abs(buffer.p[i].real());
+		const uint32_t im = abs(buffer.p[i].imag());
+		const uint32_t mag_max = std::max(re, im);
+		const uint32_t mag_min = std::min(re, im);
+		mag_history[sample_index & (history_size - 1)] = mag_max + (mag_min >> 2) + (mag_min >> 3);
+		sample_index++;
+
+		// Candidates are examined once the longest frame they could start
+		// has been received, so frames overlapping a failed one are still
+		// found.
+		const uint32_t start = sample_index - candidate_span;
+		if ((int32_t)(start - resume_index) < 0)
+			continue;
+
+		const auto score = preamble_score(start);
+		if (score <= 0)
+			continue;
+
+		// The pulses may straddle two samples, try the best aligned phase first
+		const auto score_late = preamble_score(start + 1);
+		const uint32_t candidates[2] = {
+			(score_late > score) ? start + 1 : start,
+			(score_late > score) ? start : start + 1
+		};
+		const size_t candidate_count = (score_late > 0) ? 2 : 1;
+
+		// Phases that fail aren't looked at again
+		ADSBFrame frame { };
+		resume_index = start + candidate_count;
+		for (size_t c = 0; c < candidate_count; c++) {
+			if (decode(candidates[c], frame)) {
+				const ADSBFrameMessage message(frame);
+				shared_memory.application_queue.push(message);
+				resume_index = candidates[c] + ADSB_PREAMBLE_LENGTH + frame_samples;
+				break;
 			}
 		}
-		
-		prev_mag = mag;
 	}
 }
 
 void ADSBRXProcessor::on_message(const Message* const message) {
 	if (message->id == Message::ID::ADSBConfigure) {
-		null_count = 0;
-		bit_count = 0;
-		sample_count = 0;
-		decoding = false;
+		sample_index = 0;
+		resume_index = 0;
+		mag_history.fill(0);
 		configured = true;
 	}
 }
@@ -29,36 +29,61 @@
 
 #include "adsb_frame.hpp"
 
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
 using namespace adsb;
 
 #define ADSB_PREAMBLE_LENGTH 16
 
 class ADSBRXProcessor : public BasebandProcessor {
 public:
+	ADSBRXProcessor();
+
 	void execute(const buffer_c8_t& buffer) override;
 	
 	void on_message(const Message* const message) override;
 
 private:
-	static constexpr float k = 1.0f / 128.0f;
-	
 	static constexpr size_t baseband_fs = 2000000;
-	
+
+	// One bit = 2 samples, 112 bits at most
+	static constexpr size_t frame_samples = 112 * 2;
+	// Preamble and frame, plus the later of the two candidate phases
+	static constexpr size_t candidate_span = ADSB_PREAMBLE_LENGTH + frame_samples + 1;
+	static constexpr size_t history_size = 256;
+	static_assert(history_size >= candidate_span, "ADS-B history too short for one frame");
+
+	// Pulses must clear 0.3 full scale, as weak signals aren't worth decoding
+	static constexpr uint32_t pulse_level_min = 38;
+
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 	
-	ADSBFrame frame { };
 	bool configured { false };
-	float prev_mag { 0 };
-	float threshold { }, threshold_low { }, threshold_high { };
-	size_t null_count { 0 }, bit_count { 0 }, sample_count { 0 };
-	std::pair<float, uint8_t> shifter[ADSB_PREAMBLE_LENGTH];
-	bool decoding { };
-	bool preamble { }, active { };
-    uint16_t bit_pos { 0 };
-    uint8_t cur_bit { 0 };
-	uint32_t sample { 0 };
-	int8_t re { }, im { };
+
+	// Magnitudes, circular, indexed by the free-running sample count
+	std::array<uint16_t, history_size> mag_history { };
+	uint32_t sample_index { 0 };
+	uint32_t resume_index { 0 };
+
+	struct BitSyndrome {
+		uint32_t syndrome;
+		uint32_t bit;
+	};
+	// Single bit error syndromes for bits 5-111 (the DF field is trusted),
+	// sorted by syndrome.
+	std::array<BitSyndrome, 112 - 5> bit_syndromes { };
+
+	uint32_t mag(const uint32_t index) const {
+		return mag_history[index & (history_size - 1)];
+	}
+
+	int32_t preamble_score(const uint32_t start) const;
+	bool decode(const uint32_t start, ADSBFrame& frame) const;
+	int32_t find_bit(const uint32_t syndrome) const;
+	bool correct(ADSBFrame& frame) const;
 };
 
 #endif
@@ -29,27 +29,66 @@
 
 AISProcessor::AISProcessor() {
 	decim_0.configure(taps_11k0_decim_0.taps, 33554432);
-	decim_1.configure(taps_11k0_decim_1.taps, 131072);
 }
 
 void AISProcessor::execute(const buffer_c8_t& buffer) {
 	/* 2.4576MHz, 2048 samples */
 
 	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
-	const auto decimator_out = decim_1_out;
 
-	/* 38.4kHz, 32 samples */
-	feed_channel_stats(decimator_out);
+	/* 307.2kHz, 256 samples, channels at -25kHz and +25kHz */
+	feed_channel_stats(decim_0_out);
+
+	mix(decim_0_out);
+
+	for(auto& demodulator : demodulators) {
+		demodulator.execute(demodulator.mixed_buffer);
+	}
+}
+
+/* Both products share the four multiplies: (x * p) and (x * conj(p)). */
+void AISProcessor::mix(const buffer_c16_t& src) {
+	auto& a = demodulators[0].mixed;
+	auto& b = demodulators[1].mixed;
+
+	auto phasor = mix_phasor;
+	for(size_t i=0; i<src.count; i++) {
+		const float xr = src.p[i].real();
+		const float xi = src.p[i].imag();
+		const float rc = xr * phasor.real();
+		const float rs = xr * phasor.imag();
+		const float ic = xi * phasor.real();
+		const float is = xi * phasor.imag();
+
+		a[i] = { static_cast<int16_t>(rc - is), static_cast<int16_t>(rs + ic) };
+		b[i] = { static_cast<int16_t>(rc + is), static_cast<int16_t>(ic - rs) };
 
-	for(size_t i=0; i<decimator_out.count; i++) {
-		if( mf.execute_once(decimator_out.p[i]) ) {
+		phasor *= mix_step;
+	}
+
+	// Keep rounding error from growing the phasor.
+	mix_phasor = phasor / std::abs(phasor);
+}
+
+AISProcessor::Demodulator::Demodulator(
+	const uint32_t channel
+) : channel { channel }
+{
+	decim_1.configure(taps_11k0_decim_1.taps, 131072);
+}
+
+void AISProcessor::Demodulator::execute(const buffer_c16_t& src) {
+	const auto decim_1_out = decim_1.execute(src, mixed_buffer);
+
+	/* 38.4kHz, 32 samples */
+	for(size_t i=0; i<decim_1_out.count; i++) {
+		if( mf.execute_once(decim_1_out.p[i]) ) {
 			clock_recovery(mf.get_output());
 		}
 	}
 }
 
-void AISProcessor::consume_symbol(
+void AISProcessor::Demodulator::consume_symbol(
 	const float raw_symbol
 ) {
 	const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
@@ -58,10 +97,10 @@ void AISProcessor::consume_symbol(
 	packet_builder.execute(decoded_symbol);
 }
 
-void AISProcessor::payload_handler(
+void AISProcessor::Demodulator::payload_handler(
 	const baseband::Packet& packet
 ) {
-	const AISPacketMessage message { packet };
+	const AISPacketMessage message { packet, channel };
 	shared_memory.application_queue.push(message);
 }
 
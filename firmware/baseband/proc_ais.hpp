@@ -39,9 +39,15 @@
 #include <cstdint>
 #include <cstddef>
 #include <bitset>
+#include <complex>
 
 #include "ais_baseband.hpp"
 
+/* Both AIS channels, 161.975MHz (87B, "A") and 162.025MHz (88B, "B"), are
+ * received at once. The radio is tuned so 162.000MHz lands at +fs/4; the
+ * first decimator passes both channels, each is then mixed to zero and run
+ * through its own decimator and demodulator.
+ */
 class AISProcessor : public BasebandProcessor {
 public:
 	AISProcessor();
@@ -50,6 +56,8 @@ public:
 
 private:
 	static constexpr size_t baseband_fs = 2457600;
+	static constexpr size_t decim_0_output_fs = baseband_fs / 8;
+	static constexpr float channel_offset = 25000.0f;
 
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
@@ -61,25 +69,55 @@ private:
 	};
 
 	dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
-	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
-	dsp::matched_filter::MatchedFilter mf { baseband::ais::square_taps_38k4_1t_p, 2 };
 
-	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
-		19200, 9600, { 0.0555f },
-		[this](const float symbol) { this->consume_symbol(symbol); }
+	struct Demodulator {
+		const uint32_t channel;
+
+		std::array<complex16_t, 256> mixed { };
+		const buffer_c16_t mixed_buffer {
+			mixed.data(),
+			mixed.size()
+		};
+
+		dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
+		dsp::matched_filter::MatchedFilter mf { baseband::ais::square_taps_38k4_1t_p, 2 };
+
+		clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
+			19200, 9600, { 0.0555f },
+			[this](const float symbol) { this->consume_symbol(symbol); }
+		};
+		symbol_coding::NRZIDecoder nrzi_decode { };
+
+		void payload_handler(const baseband::Packet& packet);
+
+		PacketBuilder<BitPattern32, BitPattern32, BitPattern32, PacketHandler<Demodulator, &Demodulator::payload_handler>> packet_builder {
+			{ 0b0101010101111110, 16, 1 },
+			{ 0b111110, 6 },
+			{ 0b01111110, 8 },
+			{ this }
+		};
+
+		Demodulator(const uint32_t channel);
+
+		Demodulator(const Demodulator&) = delete;
+		Demodulator& operator=(const Demodulator&) = delete;
+
+		void execute(const buffer_c16_t& src);
+		void consume_symbol(const float symbol);
 	};
-	symbol_coding::NRZIDecoder nrzi_decode { };
-	PacketBuilder<BitPattern, BitPattern, BitPattern> packet_builder {
-		{ 0b0101010101111110, 16, 1 },
-		{ 0b111110, 6 },
-		{ 0b01111110, 8 },
-		[this](const baseband::Packet& packet) {
-			this->payload_handler(packet);
-		}
+
+	std::array<Demodulator, 2> demodulators { {
+		{ 0 },
+		{ 1 },
+	} };
+
+	/* e^(j*2*pi*n*channel_offset/decim_0_output_fs), A uses it, B the conjugate. */
+	std::complex<float> mix_phasor { 1.0f, 0.0f };
+	const std::complex<float> mix_step {
+		std::polar(1.0f, 2.0f * pi * channel_offset / decim_0_output_fs)
 	};
 
-	void consume_symbol(const float symbol);
-	void payload_handler(const baseband::Packet& packet);
+	void mix(const buffer_c16_t& src);
 };
 
 #endif/*__PROC_AIS_H__*/
@@ -55,7 +55,7 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 		audio_spectrum.db[i] = std::max(0U, std::min(255U, v));
 	}
 	AudioSpectrumMessage message { &audio_spectrum };
-	shared_memory.application_queue.push(message);
+	shared_memory.application_mailbox.post(message);
 }
 
 void WidebandFMAudio::on_message(const Message* const message) {
@@ -25,6 +25,7 @@
 #include "portapack_shared_memory.hpp"
 
 #include "event_m4.hpp"
+#include "crc.hpp"
 
 void BTLERxProcessor::execute(const buffer_c8_t& buffer) {
 	if (!configured) return;
@@ -110,7 +111,6 @@ void BTLERxProcessor::execute(const buffer_c8_t& buffer) {
 				uint32_t calced_crc;
 				uint64_t packet_addr_l;
 				uint32_t result;
-				uint8_t crc[3];
 				uint8_t packet_header_arr[2];
 
 				packet_addr_l=0;
@@ -221,41 +221,10 @@ void BTLERxProcessor::execute(const buffer_c8_t& buffer) {
 
 				
 
-				if (packet_addr_l==0x8E89BED6)
-				{  
-				    crc[0]=crc[1]=crc[2]=0x55;
-				}
-				else 
-				{
-				    crc[0]=crc[1]=crc[2]=0;
-				}
-
-				uint8_t v, t, d, crc_length;
-				uint32_t crc_result=0;
-				crc_length = packet_length + 2;
-				int counter = 0;
-				while(crc_length--)
-				{
-				    uint8_t byte_temp5 = (uint8_t) (((packet_data[counter] * 0x0802LU & 0x22110LU) | (packet_data[counter] * 0x8020LU & 0x88440LU)) * 0x10101LU >> 16);
-				    d = byte_temp5;
-				    for(v = 0; v < 8; v++, d >>= 1)
-				    {
-				        t = crc[0] >> 7;
-				        crc[0] <<= 1;
-				        if(crc[1] & 0x80) crc[0] |= 1;
-				        crc[1] <<= 1;
-				        if(crc[2] & 0x80) crc[1] |= 1;
-				        crc[2] <<= 1;
-				        if(t != (d & 1))
-				        {
-				            crc[2] ^= 0x5B;
-				            crc[1] ^= 0x06;
-				        }
-				    }
-				    counter = counter + 1;
-				}
-				for (v=0;v<3;v++) crc_result=(crc_result<<8)|crc[v];
-				calced_crc = crc_result;
+				// CRC-24 over header and payload, seeded 0x555555 on the advertising channel.
+				TableCRC<24, 0x00065B> crc { (packet_addr_l == 0x8E89BED6) ? 0x555555U : 0U };
+				crc.process_bytes(packet_data, packet_length + 2);
+				calced_crc = crc.checksum();
 
 				packet_crc=0;
 				for (int c=0;c<3;c++) packet_crc=(packet_crc<<8)|packet_data[packet_length+2+c];
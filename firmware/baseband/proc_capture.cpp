@@ -25,6 +25,7 @@
 #include "dsp_fir_taps.hpp"
 
 #include "event_m4.hpp"
+#include "baseband_dma.hpp"
 
 #include "utility.hpp"
 
@@ -43,8 +44,22 @@ void CaptureProcessor::execute(const buffer_c8_t& buffer) {
 	const auto& channel = decimator_out;
 
 	if( stream ) {
-		const size_t bytes_to_write = sizeof(*decimator_out.p) * decimator_out.count;
-		const auto result = stream->write(decimator_out.p, bytes_to_write);
+		if( direct ) {
+			// This buffer is already in place if the DMA was pointed at the
+			// stream, point a later transfer at the next free space. If this
+			// thread fell behind, that waits for the next buffer.
+			const size_t transfer_bytes = sizeof(*buffer.p) * buffer.count;
+			stream->filled(transfer_bytes, 1 + baseband::dma::missed_transfers());
+			const auto p = static_cast<baseband::sample_t*>(stream->next_destination(transfer_bytes));
+			if( p && baseband::dma::set_next_destination(p) ) {
+				stream->assigned(baseband::dma::next_destination_lag);
+			}
+		} else if( encoded ) {
+			stream->write_encoded(decimator_out.p, decimator_out.count);
+		} else {
+			const size_t bytes_to_write = sizeof(*decimator_out.p) * decimator_out.count;
+			stream->write(decimator_out.p, bytes_to_write);
+		}
 	}
 
 	feed_channel_stats(channel);
@@ -93,7 +108,23 @@ void CaptureProcessor::samplerate_config(const SamplerateConfigMessage& message)
 }
 
 void CaptureProcessor::capture_config(const CaptureConfigMessage& message) {
+	if( direct ) {
+		/* The transfer in progress may still be landing in a stream buffer,
+		 * give it time to finish before the buffers go away.
+		 */
+		auto retired = std::move(stream);
+		direct = false;
+		baseband::dma::reset_destinations();
+		if( retired && baseband_fs ) {
+			chThdSleepMilliseconds(baseband::dma::transfer_samples * 2000 / baseband_fs + 1);
+		}
+	}
+
 	if( message.config ) {
+		// Format first, execute() may run as soon as the stream is set.
+		stream.reset();
+		direct = (message.config->format == CaptureConfig::Format::C8Direct);
+		encoded = (message.config->format == CaptureConfig::Format::BFP8);
 		stream = std::make_unique<StreamInput>(message.config);
 	} else {
 		stream.reset();
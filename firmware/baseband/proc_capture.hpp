@@ -64,6 +64,8 @@ private:
 	uint32_t channel_filter_stop_f = 0;
 
 	std::unique_ptr<StreamInput> stream { };
+	bool direct { false };
+	bool encoded { false };
 
 	SpectrumCollector channel_spectrum { };
 	size_t spectrum_interval_samples = 0;
@@ -49,7 +49,7 @@ void MicTXProcessor::execute(const buffer_c8_t& buffer){
 			} else {
 				power_acc_count = divider;
 				level_message.value = power_acc / (divider / 4);	// Why ?
-				shared_memory.application_queue.push(level_message);
+				shared_memory.application_mailbox.post(level_message);
 				power_acc = 0;
 			}
 		} else {
@@ -0,0 +1,191 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "proc_nfm_channelizer.hpp"
+#include "portapack_shared_memory.hpp"
+
+#include "dsp_fir_taps.hpp"
+#include "utility.hpp"
+
+#include "event_m4.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+void NarrowbandFMChannelizer::execute(const buffer_c8_t& buffer) {
+	if( !configured ) {
+		return;
+	}
+
+	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+
+	const auto audio_bin = (audio_channel >= 0) ? channel_bins[audio_channel] : 0;
+	size_t channel_samples = 0;
+	channelizer.execute(decim_0_out,
+		[this, audio_bin, &channel_samples](const Channelizer::frame_t& frame, const int exponent) {
+			this->feed_levels(frame, exponent);
+			channel[channel_samples++] = frame[audio_bin];
+		}
+	);
+
+	write_audio({ channel.data(), channel_samples, channel_fs });
+
+	if( frames >= report_frames ) {
+		report();
+	}
+}
+
+void NarrowbandFMChannelizer::feed_levels(const Channelizer::frame_t& frame, const int exponent) {
+	/* Normalize so a full-scale tone centred in a channel reads 1.0 */
+	const float scale = std::ldexp(1.0f, 2 * (exponent - 15 - static_cast<int>(log_2(Channelizer::bin_count))));
+
+	for(size_t c=0; c<channel_count; c++) {
+		const uint32_t sample = *reinterpret_cast<const uint32_t*>(&frame[channel_bins[c]]);
+		const float mag2 = static_cast<uint32_t>(__SMUAD(sample, sample)) * scale;
+		channel_max_mag2[c] = std::max(channel_max_mag2[c], mag2);
+	}
+	frames++;
+}
+
+void NarrowbandFMChannelizer::write_audio(const buffer_c16_t& channel_buffer) {
+	size_t audio_count = 0;
+	const auto resample = [this, &audio_count](const float sample) {
+		resampler(sample, [this, &audio_count](const float interpolated) {
+			if( audio_count < audio.size() ) {
+				audio[audio_count++] = interpolated;
+			}
+		});
+	};
+
+	if( audio_channel >= 0 ) {
+		const auto demodulated = demod.execute(channel_buffer, { demod_audio.data(), demod_audio.size() });
+		for(size_t i=0; i<demodulated.count; i++) {
+			resample(demodulated.p[i]);
+		}
+	} else {
+		for(size_t i=0; i<channel_buffer.count; i++) {
+			resample(0.0f);
+		}
+	}
+
+	audio_output.write(buffer_f32_t { audio.data(), audio_count, audio_fs });
+}
+
+void NarrowbandFMChannelizer::report() {
+	ChannelizerStatus status { };
+
+	for(size_t c=0; c<channels_max; c++) {
+		int32_t max_db = -128;
+		if( (c < channel_count) && (channel_max_mag2[c] > 0.0f) ) {
+			max_db = std::max(mag2_to_dbv_norm(channel_max_mag2[c]), -127.0f);
+			if( max_db > squelch_db ) {
+				status.squelch_open |= (1U << c);
+			}
+		}
+		status.max_db[c] = max_db;
+		channel_max_mag2[c] = 0.0f;
+	}
+	frames = 0;
+
+	audio_channel = select_audio_channel(status);
+	status.audio_channel = audio_channel;
+
+	const ChannelizerStatusMessage message { status };
+	shared_memory.application_mailbox.post(message);
+}
+
+int32_t NarrowbandFMChannelizer::select_audio_channel(const ChannelizerStatus& status) {
+	uint32_t candidates = status.squelch_open;
+	if( locked_channel >= 0 ) {
+		candidates &= (1U << locked_channel);
+	}
+
+	/* Stay on the current channel while it's open, and for a while after it
+	 * closes, so the other side of a conversation isn't missed.
+	 */
+	if( audio_channel >= 0 ) {
+		if( candidates & (1U << audio_channel) ) {
+			hang = hang_reports;
+			return audio_channel;
+		}
+		if( hang > 0 ) {
+			hang--;
+			return audio_channel;
+		}
+	}
+
+	int32_t strongest = -1;
+	for(size_t c=0; c<channel_count; c++) {
+		if( (candidates & (1U << c)) && ((strongest < 0) || (status.max_db[c] > status.max_db[strongest])) ) {
+			strongest = c;
+		}
+	}
+	hang = hang_reports;
+	return strongest;
+}
+
+void NarrowbandFMChannelizer::on_message(const Message* const message) {
+	switch(message->id) {
+	case Message::ID::ChannelizerConfigure:
+		configure(*reinterpret_cast<const ChannelizerConfigureMessage*>(message));
+		break;
+
+	default:
+		break;
+	}
+}
+
+void NarrowbandFMChannelizer::configure(const ChannelizerConfigureMessage& message) {
+	static_assert(
+		ChannelizerConfigureMessage::sampling_rate_per_spacing == Channelizer::bin_count * decim_0.decimation_factor,
+		"Channelizer bins must match the channel spacing"
+	);
+	channel_fs = message.channel_spacing;
+	baseband_fs = channel_fs * ChannelizerConfigureMessage::sampling_rate_per_spacing;
+	baseband_thread.set_sampling_rate(baseband_fs);
+
+	decim_0.configure(taps_200k_wfm_decim_0.taps, 33554432);
+	channelizer.configure(taps_channelizer_32x12.taps);
+	demod.configure(channel_fs, message.deviation);
+	resampler.configure(channel_fs, audio_fs);
+	audio_output.configure(message.audio_hpf_config, message.audio_deemph_config, 0.0f);
+
+	channel_count = std::min(message.channel_count, channels_max);
+	for(size_t c=0; c<channel_count; c++) {
+		channel_bins[c] = Channelizer::bin(static_cast<int32_t>(c) - static_cast<int32_t>(channel_count / 2));
+	}
+	channel_max_mag2.fill(0.0f);
+	report_frames = channel_fs * report_interval;
+	frames = 0;
+
+	squelch_db = message.squelch_db;
+	locked_channel = (message.audio_channel < static_cast<int32_t>(channel_count)) ? message.audio_channel : -1;
+	audio_channel = -1;
+	hang = 0;
+
+	configured = true;
+}
+
+int main() {
+	EventDispatcher event_dispatcher { std::make_unique<NarrowbandFMChannelizer>() };
+	event_dispatcher.run();
+	return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PROC_NFM_CHANNELIZER_H__
+#define __PROC_NFM_CHANNELIZER_H__
+
+#include "baseband_processor.hpp"
+#include "baseband_thread.hpp"
+#include "rssi_thread.hpp"
+
+#include "dsp_decimate.hpp"
+#include "dsp_channelizer.hpp"
+#include "dsp_demodulate.hpp"
+#include "linear_resampler.hpp"
+
+#include "audio_output.hpp"
+
+#include "message.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+/* Monitors up to 16 adjacent NFM channels at once. The baseband is decimated
+ * by 8 and split by a polyphase filter bank into 32 channels, one channel
+ * spacing apart. Every report interval each monitored channel's level is
+ * compared against the squelch, and audio follows the strongest open channel
+ * (or a fixed one) instead of retuning the radio.
+ */
+class NarrowbandFMChannelizer : public BasebandProcessor {
+public:
+	void execute(const buffer_c8_t& buffer) override;
+
+	void on_message(const Message* const message) override;
+
+private:
+	using Channelizer = dsp::channelize::PolyphaseFFT;
+
+	static constexpr size_t channels_max = ChannelizerConfigureMessage::channels_max;
+	static constexpr uint32_t audio_fs = 24000;
+	static constexpr float report_interval { 0.1f };
+	static constexpr size_t hang_reports = 5;
+
+	uint32_t baseband_fs = 0;
+	uint32_t channel_fs = 0;
+
+	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
+	RSSIThread rssi_thread { NORMALPRIO + 10 };
+
+	std::array<complex16_t, Channelizer::input_capacity> dst { };
+	const buffer_c16_t dst_buffer {
+		dst.data(),
+		dst.size()
+	};
+
+	/* One sample of the listened-to channel per channelizer frame. */
+	std::array<complex16_t, Channelizer::input_capacity / Channelizer::bin_count> channel { };
+	std::array<float, Channelizer::input_capacity / Channelizer::bin_count> demod_audio { };
+	std::array<float, 32> audio { };
+
+	dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
+	Channelizer channelizer { };
+	dsp::demodulate::FM demod { };
+	dsp::interpolation::LinearResampler resampler { };
+
+	AudioOutput audio_output { };
+
+	size_t channel_count { 0 };
+	std::array<size_t, channels_max> channel_bins { };
+	std::array<float, channels_max> channel_max_mag2 { };
+	size_t report_frames { 0 };
+	size_t frames { 0 };
+
+	int32_t squelch_db { 0 };
+	int32_t locked_channel { -1 };
+	int32_t audio_channel { -1 };
+	size_t hang { 0 };
+
+	bool configured { false };
+	void configure(const ChannelizerConfigureMessage& message);
+
+	void feed_levels(const Channelizer::frame_t& frame, const int exponent);
+	void write_audio(const buffer_c16_t& channel_buffer);
+	void report();
+	int32_t select_audio_channel(const ChannelizerStatus& status);
+};
+
+#endif/*__PROC_NFM_CHANNELIZER_H__*/
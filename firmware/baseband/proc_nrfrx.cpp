@@ -25,6 +25,7 @@
 #include "portapack_shared_memory.hpp"
 
 #include "event_m4.hpp"
+#include "crc.hpp"
 
 void NRFRxProcessor::execute(const buffer_c8_t& buffer) {
 	if (!configured) return;
@@ -169,29 +170,9 @@ void NRFRxProcessor::execute(const buffer_c8_t& buffer) {
 				}
 
 				/* calculate packet crc */
-				const uint8_t* data = packet_packed; 
-				size_t data_len =  7+packet_length;
-				bool bit;
-				uint8_t cc;
-				uint_fast16_t crc=0x3C18;
-				while (data_len--) {
-				cc = *data++;
-				for (uint8_t i = 0x80; i > 0; i >>= 1) 
-				{
-					bit = crc & 0x8000;
-					if (cc & i) 
-					{
-						bit = !bit;
-					}
-					crc <<= 1;
-					if (bit) 
-					{
-						crc ^= 0x1021;
-					}
-				}
-					crc &= 0xffff;
-				}
-				calced_crc = (uint16_t)(crc & 0xffff);
+				TableCRC<16, 0x1021> crc { 0x3C18 };
+				crc.process_bytes(packet_packed, 7 + packet_length);
+				calced_crc = crc.checksum();
 
 				/* extract crc */
 				for (int t=0;t<2;t++)
@@ -51,93 +51,119 @@ void POCSAGProcessor::execute(const buffer_c8_t& buffer) {
 			slicer_sr |= (audio_sample < 0);		// Do we need hysteresis ?
 		else
 			slicer_sr |= !(audio_sample < 0);
-			
-		// Detect transitions to adjust clock
-		if ((slicer_sr ^ (slicer_sr >> 1)) & 1) {
-			if (sphase < (0x8000u - sphase_delta_half))
-				sphase += sphase_delta_eighth;
-			else
-				sphase -= sphase_delta_eighth;
+		
+		for (auto& decoder : decoders) {
+			if (decoder.enabled)
+				process_sample(decoder);
 		}
+	}
+}
+
+void POCSAGProcessor::process_sample(Decoder& decoder) {
+	// Detect transitions to adjust clock
+	if ((slicer_sr ^ (slicer_sr >> 1)) & 1) {
+		if (decoder.sphase < (0x8000u - decoder.sphase_delta_half))
+			decoder.sphase += decoder.sphase_delta_eighth;
+		else
+			decoder.sphase -= decoder.sphase_delta_eighth;
+	}
+	
+	decoder.sphase += decoder.sphase_delta;
+	
+	// Symbol time elapsed
+	if (decoder.sphase >= 0x10000u) {
+		decoder.sphase &= 0xFFFFu;
 		
-		sphase += sphase_delta;
+		decoder.rx_data <<= 1;
+		decoder.rx_data |= (slicer_sr & 1);
 		
-		// Symbol time elapsed
-		if (sphase >= 0x10000u) {
-			sphase &= 0xFFFFu;
-			
-			rx_data <<= 1;
-			rx_data |= (slicer_sr & 1);
-			
-			switch (rx_state) {
-				
-				case WAITING:
-					if (rx_data == 0xAAAAAAAA) {
-						rx_state = PREAMBLE;
-						sync_timeout = 0;
-					}
-					break;
+		process_bit(decoder);
+	}
+}
+
+void POCSAGProcessor::process_bit(Decoder& decoder) {
+	switch (decoder.rx_state) {
+		
+		case WAITING:
+			if (decoder.rx_data == 0xAAAAAAAA) {
+				decoder.rx_state = PREAMBLE;
+				decoder.sync_timeout = 0;
+			}
+			break;
+		
+		case PREAMBLE:
+			if (decoder.sync_timeout < POCSAG_TIMEOUT) {
+				decoder.sync_timeout++;
+
+				if (decoder.rx_data == POCSAG_SYNCWORD) {
+					decoder.packet.clear();
+					decoder.codeword_count = 0;
+					decoder.rx_bit = 0;
+					decoder.msg_timeout = 0;
+					decoder.rx_state = SYNC;
+				}
 				
-				case PREAMBLE:
-					if (sync_timeout < POCSAG_TIMEOUT) {
-						sync_timeout++;
-
-						if (rx_data == POCSAG_SYNCWORD) {
-							packet.clear();
-							codeword_count = 0;
-							rx_bit = 0;
-							msg_timeout = 0;
-							rx_state = SYNC;
-						}
-						
-					} else {
-						// Timeout here is normal (end of message)
-						rx_state = WAITING;
-						//push_packet(pocsag::PacketFlag::TIMED_OUT);
-					}
-					break;
+			} else {
+				// Timeout here is normal (end of message)
+				decoder.rx_state = WAITING;
+				//push_packet(decoder, pocsag::PacketFlag::TIMED_OUT);
+			}
+			break;
+		
+		case SYNC:
+			if (decoder.msg_timeout < POCSAG_BATCH_LENGTH) {
+				decoder.msg_timeout++;
+				decoder.rx_bit++;
 				
-				case SYNC:
-					if (msg_timeout < POCSAG_BATCH_LENGTH) {
-						msg_timeout++;
-						rx_bit++;
-						
-						if (rx_bit >= 32) {
-							rx_bit = 0;
-							
-							// Got a complete codeword
-							
-							//pocsag_brute_repair(&s->l2.pocsag, &rx_data);
-							
-							packet.set(codeword_count, rx_data);
-							
-							if (codeword_count < 15) {
-								codeword_count++;
-							} else {
-								push_packet(pocsag::PacketFlag::NORMAL);
-								rx_state = PREAMBLE;
-								sync_timeout = 0;
-							}
-						}
+				if (decoder.rx_bit >= 32) {
+					decoder.rx_bit = 0;
+					
+					// Got a complete codeword
+					decoder.packet.set(decoder.codeword_count, correct(decoder.rx_data));
+					
+					if (decoder.codeword_count < 15) {
+						decoder.codeword_count++;
 					} else {
-						packet.set(0, codeword_count);	// Replace first codeword with count, for debug
-						push_packet(pocsag::PacketFlag::TIMED_OUT);
-						rx_state = WAITING;
+						push_packet(decoder, pocsag::PacketFlag::NORMAL);
+						decoder.rx_state = PREAMBLE;
+						decoder.sync_timeout = 0;
 					}
-					break;
-
-				default:
-					break;
+				}
+			} else {
+				decoder.packet.set(0, decoder.codeword_count);	// Replace first codeword with count, for debug
+				push_packet(decoder, pocsag::PacketFlag::TIMED_OUT);
+				decoder.rx_state = WAITING;
 			}
-		}
+			break;
+
+		default:
+			break;
 	}
 }
 
-void POCSAGProcessor::push_packet(pocsag::PacketFlag flag) {
-	packet.set_bitrate(bitrate);
-	packet.set_flag(flag);
-	packet.set_timestamp(Timestamp::now());
-	const POCSAGPacketMessage message(packet);
+// Codeword bits 31~1 are the BCH(31,21) code, MSB is x^30. Bit 0 is even parity.
+uint32_t POCSAGProcessor::correct(const uint32_t codeword) {
+	int recd[31];
+	
+	for (size_t j = 0; j < 31; j++)
+		recd[j] = (codeword >> (j + 1)) & 1;
+	
+	// Uncorrectable, pass it on as received
+	if (bch_code.decode(recd))
+		return codeword;
+	
+	uint32_t corrected = 0;
+	for (size_t j = 0; j < 31; j++)
+		corrected |= (uint32_t)recd[j] << (j + 1);
+	
+	return corrected | __builtin_parity(corrected);
+}
+
+void POCSAGProcessor::push_packet(Decoder& decoder, pocsag::PacketFlag flag) {
+	decoder.packet.set_bitrate(decoder.bitrate);
+	decoder.packet.set_flag(flag);
+	decoder.packet.set_timestamp(Timestamp::now());
+	const POCSAGPacketMessage message(decoder.packet);
 	shared_memory.application_queue.push(message);
 }
 
@@ -164,13 +190,17 @@ void POCSAGProcessor::configure(const POCSAGConfigureMessage& message) {
 	demod.configure(demod_input_fs, 4500);
 	//audio_output.configure(false);
 
-	bitrate = message.bitrate;
 	phase = message.phase;
-	sphase_delta = 0x10000u * bitrate / POCSAG_AUDIO_RATE;
-	sphase_delta_half = sphase_delta / 2;			// Just for speed
-	sphase_delta_eighth = sphase_delta / 8;
 	
-	rx_state = WAITING;
+	// UNKNOWN bit rate listens for all of them
+	for (auto& decoder : decoders) {
+		decoder.enabled = (message.bitrate == pocsag::BitRate::UNKNOWN) || (message.bitrate == decoder.bitrate);
+		decoder.sphase_delta = 0x10000u * decoder.bitrate / POCSAG_AUDIO_RATE;
+		decoder.sphase_delta_half = decoder.sphase_delta / 2;			// Just for speed
+		decoder.sphase_delta_eighth = decoder.sphase_delta / 8;
+		decoder.rx_state = WAITING;
+	}
+	
 	configured = true;
 }
 
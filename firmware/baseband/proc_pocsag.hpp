@@ -59,6 +59,32 @@ private:
 		//END_OF_MESSAGE = 69
 	};
 
+	// Clock recovery and batch state for one bit rate. All rates run on
+	// the same demodulated audio, so pages are caught whatever their rate.
+	struct Decoder {
+		const pocsag::BitRate bitrate;
+		bool enabled { true };
+
+		uint32_t sphase { 0 };
+		uint32_t sphase_delta { 0 };
+		uint32_t sphase_delta_half { 0 };
+		uint32_t sphase_delta_eighth { 0 };
+
+		uint32_t sync_timeout { 0 };
+		uint32_t msg_timeout { 0 };
+		uint32_t rx_data { 0 };
+		uint32_t rx_bit { 0 };
+		rx_states rx_state { WAITING };
+		uint32_t codeword_count { 0 };
+		pocsag::POCSAGPacket packet { };
+
+		Decoder(
+			const pocsag::BitRate bitrate
+		) : bitrate { bitrate }
+		{
+		}
+	};
+
 	static constexpr size_t baseband_fs = 3072000;
 
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
@@ -82,24 +108,26 @@ private:
 	
 	//AudioOutput audio_output { };
 
-	uint32_t sync_timeout { 0 };
-	uint32_t msg_timeout { 0 };
+	// BCH(31,21), corrects up to two bit errors per codeword
+	static constexpr std::array<int, 6> bch_code_p { { 1, 0, 1, 0, 0, 1 } };
+	BCHCode bch_code {
+		{ std::begin(bch_code_p), std::end(bch_code_p) },
+		5, 31, 21, 2
+	};
 
 	uint32_t slicer_sr { 0 };
-	uint32_t sphase { 0 };
-	uint32_t sphase_delta { 0 };
-	uint32_t sphase_delta_half { 0 };
-	uint32_t sphase_delta_eighth { 0 };
-	uint32_t rx_data { 0 };
-	uint32_t rx_bit { 0 };
 	bool configured = false;
-	rx_states rx_state { WAITING };
-	pocsag::BitRate bitrate { pocsag::BitRate::FSK1200 };
 	bool phase;
-	uint32_t codeword_count { 0 };
-	pocsag::POCSAGPacket packet { };
+	std::array<Decoder, 3> decoders { {
+		{ pocsag::BitRate::FSK512 },
+		{ pocsag::BitRate::FSK1200 },
+		{ pocsag::BitRate::FSK2400 }
+	} };
 	
-	void push_packet(pocsag::PacketFlag flag);
+	void process_sample(Decoder& decoder);
+	void process_bit(Decoder& decoder);
+	uint32_t correct(const uint32_t codeword);
+	void push_packet(Decoder& decoder, pocsag::PacketFlag flag);
 	void configure(const POCSAGConfigureMessage& message);
 	
 };
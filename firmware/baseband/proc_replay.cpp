@@ -51,9 +51,14 @@ void ReplayProcessor::execute(const buffer_c8_t& buffer) {
 	// 2048 samples * 2 bytes per sample = 4096 bytes
 	// Since we're oversampling by 4M/500k = 8, we only need 2048/8 = 256 samples from the file and duplicate them 8 times each
 	// So 256 * 4 bytes per sample (C16) = 1024 bytes from the file
+	// Block floating point files are decoded to the same 256 C16 samples
 	if( stream ) {
-		const size_t bytes_to_read = sizeof(*buffer.p) * 2 * (buffer.count / 8);	// *2 (C16), /8 (oversampling) should be == 1024
-		bytes_read += stream->read(iq_buffer.p, bytes_to_read);
+		if( encoded ) {
+			bytes_read += stream->read_decoded(iq_buffer.p, buffer.count / 8);
+		} else {
+			const size_t bytes_to_read = sizeof(*buffer.p) * 2 * (buffer.count / 8);	// *2 (C16), /8 (oversampling) should be == 1024
+			bytes_read += stream->read(iq_buffer.p, bytes_to_read);
+		}
 	}
 	
 	// Fill and "stretch"
@@ -114,6 +119,7 @@ void ReplayProcessor::samplerate_config(const SamplerateConfigMessage& message)
 void ReplayProcessor::replay_config(const ReplayConfigMessage& message) {
 	if( message.config ) {
 		
+		encoded = (message.config->format == ReplayConfig::Format::BFP8);
 		stream = std::make_unique<StreamOutput>(message.config);
 		
 		// Tell application that the buffers and FIFO pointers are ready, prefill
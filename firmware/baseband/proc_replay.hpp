@@ -58,6 +58,7 @@ private:
 	uint32_t channel_filter_stop_f = 0;
 
 	std::unique_ptr<StreamOutput> stream { };
+	bool encoded { false };
 
 	SpectrumCollector channel_spectrum { };
 	size_t spectrum_interval_samples = 0;
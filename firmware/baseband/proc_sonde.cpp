@@ -49,6 +49,16 @@ void SondeProcessor::execute(const buffer_c8_t& buffer) {
 	}
 }
 
+void SondeProcessor::meteomodem_handler(const baseband::Packet& packet) {
+	const SondePacketMessage message { sonde::Packet::Type::Meteomodem_unknown, packet };
+	shared_memory.application_queue.push(message);
+}
+
+void SondeProcessor::vaisala_handler(const baseband::Packet& packet) {
+	const SondePacketMessage message { sonde::Packet::Type::Vaisala_RS41_SG, packet };
+	shared_memory.application_queue.push(message);
+}
+
 int main() {
 	EventDispatcher event_dispatcher { std::make_unique<SondeProcessor>() };
 	event_dispatcher.run();
@@ -114,6 +114,9 @@ private:
 	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
 	dsp::matched_filter::MatchedFilter mf { baseband::ais::square_taps_38k4_1t_p, 2 };
 
+	void meteomodem_handler(const baseband::Packet& packet);
+	void vaisala_handler(const baseband::Packet& packet);
+
 	// Actually 4800bits/s but the Manchester coding doubles the symbol rate
 	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery_fsk_9600 {
 		19200, 9600, { 0.0555f },
@@ -122,14 +125,11 @@ private:
 			this->packet_builder_fsk_9600_Meteomodem.execute(sliced_symbol);
 		}
 	};
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_9600_Meteomodem {
+	PacketBuilder<BitPattern32, NeverMatch, FixedLength, PacketHandler<SondeProcessor, &SondeProcessor::meteomodem_handler>> packet_builder_fsk_9600_Meteomodem {
 		{ 0b00110011001100110101100110110011, 32, 1 },
 		{ },
 		{ 88 * 2 * 8 },
-		[this](const baseband::Packet& packet) {
-			const SondePacketMessage message { sonde::Packet::Type::Meteomodem_unknown, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ this }
 	};
 	
 	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery_fsk_4800 {
@@ -139,15 +139,12 @@ private:
 			this->packet_builder_fsk_4800_Vaisala.execute(sliced_symbol);
 		}
 	};
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_4800_Vaisala {
+	PacketBuilder<BitPattern32, NeverMatch, FixedLength, PacketHandler<SondeProcessor, &SondeProcessor::vaisala_handler>> packet_builder_fsk_4800_Vaisala {
 		{ 0b00001000011011010101001110001000, 32, 1 }, //euquiq Header detects 4 of 8 bytes 0x10B6CA11 /this is in raw format) (these bits are not passed at the beginning of packet)
 		//{ 0b0000100001101101010100111000100001000100011010010100100000011111, 64, 1 }, //euquiq whole header detection would be 8 bytes.
 		{ },
 		{ 320 * 8 },
-		[this](const baseband::Packet& packet) {
-			const SondePacketMessage message { sonde::Packet::Type::Vaisala_RS41_SG, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ this }
 	};
 };
 
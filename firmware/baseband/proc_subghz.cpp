@@ -0,0 +1,89 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "proc_subghz.hpp"
+
+#include "portapack_shared_memory.hpp"
+
+#include "dsp_fir_taps.hpp"
+
+#include "event_m4.hpp"
+
+#include <algorithm>
+
+SubGHzProcessor::SubGHzProcessor() {
+	decim_0.configure(taps_200k_decim_0.taps, 33554432);
+	decim_1.configure(taps_200k_decim_1.taps, 131072);
+	decim_2.configure(taps_200k_decim_1.taps, 131072);
+}
+
+void SubGHzProcessor::execute(const buffer_c8_t& buffer) {
+	/* 4.9152MHz, 2048 samples */
+
+	execute_raw(buffer);
+
+	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
+	const auto channel = decim_2.execute(decim_1_out, dst_buffer);
+
+	/* 307.2kHz, 128 samples */
+	feed_channel_stats(channel);
+
+	execute_channel(channel);
+}
+
+void SubGHzProcessor::execute_raw(const buffer_c8_t& buffer) {
+	ert.update_offset(buffer);
+
+	const bool was_active = raw_burst.active();
+	if( raw_burst(BurstDetector::power(buffer)) ) {
+		if( !was_active && raw_history_count ) {
+			ert.demodulate({ raw_history.data(), raw_history_count, buffer.sampling_rate });
+		}
+		ert.demodulate(buffer);
+		raw_history_count = 0;
+	} else {
+		raw_history_count = std::min(buffer.count, raw_history.size());
+		std::copy(&buffer.p[0], &buffer.p[raw_history_count], raw_history.begin());
+	}
+}
+
+void SubGHzProcessor::execute_channel(const buffer_c16_t& channel) {
+	const bool was_active = channel_burst.active();
+	if( channel_burst(BurstDetector::power(channel)) ) {
+		if( !was_active && channel_history_count ) {
+			const buffer_c16_t history { channel_history.data(), channel_history_count, channel.sampling_rate };
+			tpms.execute(history);
+			ook_remote.execute(history);
+		}
+		tpms.execute(channel);
+		ook_remote.execute(channel);
+		channel_history_count = 0;
+	} else {
+		ook_remote.idle(channel);
+		channel_history_count = std::min(channel.count, channel_history.size());
+		std::copy(&channel.p[0], &channel.p[channel_history_count], channel_history.begin());
+	}
+}
+
+int main() {
+	EventDispatcher event_dispatcher { std::make_unique<SubGHzProcessor>() };
+	event_dispatcher.run();
+	return 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PROC_SUBGHZ_H__
+#define __PROC_SUBGHZ_H__
+
+#include "baseband_processor.hpp"
+#include "baseband_thread.hpp"
+#include "rssi_thread.hpp"
+
+#include "channel_decimator.hpp"
+
+#include "burst_detector.hpp"
+#include "ert_demodulator.hpp"
+#include "tpms_demodulator.hpp"
+#include "ook_remote_decoder.hpp"
+
+#include "message.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+/* ERT meters, TPMS sensors and OOK remotes on one image. The radio is tuned
+ * so the target frequency lands at +fs/4. ERT works from the whole baseband,
+ * TPMS and OOK from a 307.2kHz channel at the target. Demodulators only run
+ * while their band has a burst above the noise floor; the buffer before the
+ * burst was detected is kept so the start of the preamble isn't lost.
+ */
+class SubGHzProcessor : public BasebandProcessor {
+public:
+	SubGHzProcessor();
+
+	void execute(const buffer_c8_t& buffer) override;
+
+private:
+	/* A multiple of the 65536 ERT half-symbol rate and of the 307.2kHz
+	 * TPMS channel rate.
+	 */
+	static constexpr size_t baseband_fs = 4915200;
+
+	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
+	RSSIThread rssi_thread { NORMALPRIO + 10 };
+
+	std::array<complex16_t, 512> dst { };
+	const buffer_c16_t dst_buffer {
+		dst.data(),
+		dst.size()
+	};
+
+	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };
+	dsp::decimate::FIRC16xR16x16Decim2 decim_1 { };
+	dsp::decimate::FIRC16xR16x16Decim2 decim_2 { };
+
+	BurstDetector raw_burst { 4.0f, 8 };
+	BurstDetector channel_burst { 4.0f, 8 };
+
+	std::array<complex8_t, 2048> raw_history { };
+	size_t raw_history_count { 0 };
+
+	std::array<complex16_t, 128> channel_history { };
+	size_t channel_history_count { 0 };
+
+	ERTDemodulator ert { baseband_fs };
+	TPMSDemodulator tpms { };
+	OOKRemoteDecoder ook_remote { };
+
+	void execute_raw(const buffer_c8_t& buffer);
+	void execute_channel(const buffer_c16_t& channel);
+};
+
+#endif/*__PROC_SUBGHZ_H__*/
@@ -65,6 +65,8 @@ private:
 	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
 	dsp::matched_filter::MatchedFilter mf { baseband::ais::square_taps_38k4_1t_p, 2 };
 
+	void payload_handler(const baseband::Packet& packet);
+
 	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery_fsk_9600 {
 		38400, 19192, { 0.00555f },
 		[this](const float raw_symbol) {
@@ -72,14 +74,11 @@ private:
 			this->packet_builder_fsk_9600_CC1101.execute(sliced_symbol);
 		}
 	};
-	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_9600_CC1101 {
+	PacketBuilder<BitPattern32, NeverMatch, FixedLength, PacketHandler<TestProcessor, &TestProcessor::payload_handler>> packet_builder_fsk_9600_CC1101 {
 		{ 0b01010110010110100101101001101010, 32, 1 },	// Manchester 0x1337
 		{ },
 		{ 22 * 8 },
-		[this](const baseband::Packet& packet) {
-			const TestAppPacketMessage message { packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ this }
 	};
 };
 
@@ -39,23 +39,7 @@ void TPMSProcessor::execute(const buffer_c8_t& buffer) {
 	/* 307.2kHz, 256 samples */
 	feed_channel_stats(decimator_out);
 
-	for(size_t i=0; i<decimator_out.count; i++) {
-		if( mf_38k4_1t_19k2.execute_once(decimator_out.p[i]) ) {
-			clock_recovery_fsk_19k2(mf_38k4_1t_19k2.get_output());
-		}
-	}
-
-	for(size_t i=0; i<decimator_out.count; i+=channel_decimation) {
-		const auto sliced = ook_slicer_5sps(decimator_out.p[i]);
-		slicer_history = (slicer_history << 1) | sliced;
-
-		clock_recovery_ook_8k192(slicer_history, [this](const bool symbol) {
-			this->packet_builder_ook_8k192_schrader.execute(symbol);
-		});
-		clock_recovery_ook_8k4(slicer_history, [this](const bool symbol) {
-			this->packet_builder_ook_8k4_schrader.execute(symbol);
-		});
-	}
+	demod.execute(decimator_out);
 }
 
 int main() {
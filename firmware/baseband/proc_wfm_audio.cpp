@@ -110,7 +110,7 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 					spectrum.db[i] = std::max(0U, std::min(255U, v));
 				}
 				AudioSpectrumMessage message { &spectrum };
-				shared_memory.application_queue.push(message);
+				shared_memory.application_mailbox.post(message);
 				audio_spectrum_state = IDLE;
 			}
 			break;
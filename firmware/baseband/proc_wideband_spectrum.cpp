@@ -22,11 +22,15 @@
 #include "proc_wideband_spectrum.hpp"
 
 #include "event_m4.hpp"
+#include "portapack_shared_memory.hpp"
+
+#include <hal.h>
 
 #include <cstdint>
 #include <cstddef>
 
 #include <array>
+#include <algorithm>
 
 void WidebandSpectrum::execute(const buffer_c8_t& buffer) {
 	// 2048 complex8_t samples per buffer.
@@ -34,16 +38,16 @@ void WidebandSpectrum::execute(const buffer_c8_t& buffer) {
 	
 	if (!configured) return;
 
+	if( sweep_state != SweepState::Off ) {
+		execute_sweep(buffer);
+		return;
+	}
+
 	if( phase == 0 ) {
 		std::fill(spectrum.begin(), spectrum.end(), 0);
 	}
 
-	for(size_t i=0; i<spectrum.size(); i++) {
-		// TODO: Removed window-presum windowing, due to lack of available code RAM.
-		// TODO: Apply window to improve spectrum bin sidelobes.
-		spectrum[i] += buffer.p[i +    0];
-		spectrum[i] += buffer.p[i + 1024];
-	}
+	fold(buffer);
 
 	if( phase == trigger ) {
 		const buffer_c16_t buffer_c16 {
@@ -61,6 +65,106 @@ void WidebandSpectrum::execute(const buffer_c8_t& buffer) {
 	}
 }
 
+void WidebandSpectrum::fold(const buffer_c8_t& buffer) {
+	// Folded without windowing; channel_spectrum applies the configured
+	// window to the folded block before the FFT.
+	static_assert(spectrum_fft_size * 2 == 2048, "Presum expects two spectrum blocks per buffer");
+	const uint32_t* src_0 = reinterpret_cast<const uint32_t*>(&buffer.p[0]);
+	const uint32_t* src_1 = reinterpret_cast<const uint32_t*>(&buffer.p[spectrum.size()]);
+	uint32_t* dst = reinterpret_cast<uint32_t*>(spectrum.data());
+	for(size_t i=0; i<spectrum.size(); i+=2) {
+		// Two complex8 samples per word: I0, Q0, I1, Q1.
+		const uint32_t w0 = *(src_0++);
+		const uint32_t w1 = *(src_1++);
+		const uint32_t sum_i = __SADD16(__SXTB16(w0, 0), __SXTB16(w1, 0));
+		const uint32_t sum_q = __SADD16(__SXTB16(w0, 8), __SXTB16(w1, 8));
+		dst[0] = __SADD16(dst[0], __PKHBT(sum_i, sum_q, 16));
+		dst[1] = __SADD16(dst[1], __PKHTB(sum_q, sum_i, 16));
+		dst += 2;
+	}
+}
+
+void WidebandSpectrum::execute_sweep(const buffer_c8_t& buffer) {
+	switch(sweep_state) {
+	case SweepState::Tuning:
+		if( !sweep_retune_sent ) {
+			send_retune();
+		} else if( ++sweep_phase >= std::max(sweep_settle_buffers * 4, sweep_retune_timeout_min) ) {
+			// Request or reply lost, ask again. A late reply to the first
+			// request is ignored once out of Tuning.
+			send_retune();
+		}
+		break;
+
+	case SweepState::Settling:
+		// Buffers straddling the retune, and the PLL settling time.
+		if( ++sweep_phase >= sweep_settle_buffers ) {
+			sweep_phase = 0;
+			sweep_state = SweepState::Capturing;
+		}
+		break;
+
+	case SweepState::Capturing:
+		std::fill(spectrum.begin(), spectrum.end(), 0);
+		fold(buffer);
+
+		// A block arriving while the last one is still in the FFT is
+		// skipped, the radio is still parked on the same slice.
+		if( channel_spectrum.feed_slice({ spectrum.data(), spectrum.size(), buffer.sampling_rate }, sweep_frequency) ) {
+			if( ++sweep_phase >= sweep_average_count ) {
+				sweep_slice = (sweep_slice + 1 < sweep_slice_count) ? (sweep_slice + 1) : 0;
+				request_retune();
+			}
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void WidebandSpectrum::request_retune() {
+	sweep_frequency = sweep_first_frequency + static_cast<int64_t>(sweep_step) * sweep_slice;
+	sweep_state = SweepState::Tuning;
+
+	send_retune();
+}
+
+void WidebandSpectrum::send_retune() {
+	sweep_phase = 0;
+
+	const SpectrumSweepRetuneMessage message { sweep_frequency };
+	sweep_retune_sent = shared_memory.application_queue.push(message);
+}
+
+void WidebandSpectrum::configure_sweep(const SpectrumSweepConfigMessage& message) {
+	sweep_state = SweepState::Off;
+
+	if( message.slice_count == 0 ) {
+		channel_spectrum.clear_slice_averaging();
+		phase = 0;
+		return;
+	}
+
+	sweep_first_frequency = message.first_frequency;
+	sweep_step = message.step;
+	sweep_slice_count = message.slice_count;
+	sweep_settle_buffers = message.settle_buffers;
+	sweep_average_count = std::max<uint32_t>(message.average_count, 1);
+	channel_spectrum.set_slice_averaging(sweep_average_count);
+
+	sweep_slice = 0;
+	request_retune();
+}
+
+void WidebandSpectrum::on_tuned(const SpectrumSweepTunedMessage& message) {
+	// Ignore a late reply to a request from a previous configuration.
+	if( (sweep_state == SweepState::Tuning) && (message.frequency == sweep_frequency) ) {
+		sweep_phase = 0;
+		sweep_state = (sweep_settle_buffers > 0) ? SweepState::Settling : SweepState::Capturing;
+	}
+}
+
 void WidebandSpectrum::on_message(const Message* const msg) {
 	const WidebandSpectrumConfigMessage message = *reinterpret_cast<const WidebandSpectrumConfigMessage*>(msg);
 	
@@ -68,6 +172,11 @@ void WidebandSpectrum::on_message(const Message* const msg) {
 	case Message::ID::UpdateSpectrum:
 	case Message::ID::SpectrumStreamingConfig:
 		channel_spectrum.on_message(msg);
+		// Streaming (re)configuration resets the averaging, sweep slices
+		// keep their own.
+		if( (msg->id == Message::ID::SpectrumStreamingConfig) && (sweep_state != SweepState::Off) ) {
+			channel_spectrum.set_slice_averaging(sweep_average_count);
+		}
 		break;
 		
 	case Message::ID::WidebandSpectrumConfig:
@@ -78,6 +187,14 @@ void WidebandSpectrum::on_message(const Message* const msg) {
 		configured = true;
 		break;
 
+	case Message::ID::SpectrumSweepConfig:
+		configure_sweep(*reinterpret_cast<const SpectrumSweepConfigMessage*>(msg));
+		break;
+
+	case Message::ID::SpectrumSweepTuned:
+		on_tuned(*reinterpret_cast<const SpectrumSweepTunedMessage*>(msg));
+		break;
+
 	default:
 		break;
 	}
@@ -48,11 +48,49 @@ private:
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20 };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
-	SpectrumCollector channel_spectrum { };
+	/* Presumming 2048 samples into 1024 bins gives the even bins of a
+	 * 2048-point transform, at the cost of a 1024-point one.
+	 */
+	static constexpr size_t spectrum_fft_size = 1024;
 
-	std::array<complex16_t, 256> spectrum { };
+	BasicSpectrumCollector<spectrum_fft_size> channel_spectrum { };
+
+	std::array<complex16_t, spectrum_fft_size> spectrum { };
 
 	size_t phase = 0, trigger = 127;
+
+	/* Sweep mode, see SpectrumSweepConfigMessage. The baseband thread
+	 * drives the sequence; Tuning is left when the application reports the
+	 * retune done. A request that couldn't be queued, or went unanswered
+	 * for a few settle periods, is sent again.
+	 */
+	enum class SweepState {
+		Off,
+		Tuning,
+		Settling,
+		Capturing,
+	};
+
+	volatile SweepState sweep_state { SweepState::Off };
+	int64_t sweep_first_frequency { 0 };
+	uint32_t sweep_step { 0 };
+	uint32_t sweep_slice_count { 0 };
+	uint32_t sweep_settle_buffers { 0 };
+	uint32_t sweep_average_count { 1 };
+
+	uint32_t sweep_slice { 0 };
+	uint32_t sweep_phase { 0 };
+	int64_t sweep_frequency { 0 };
+	bool sweep_retune_sent { false };
+
+	static constexpr uint32_t sweep_retune_timeout_min = 256;
+
+	void fold(const buffer_c8_t& buffer);
+	void execute_sweep(const buffer_c8_t& buffer);
+	void configure_sweep(const SpectrumSweepConfigMessage& message);
+	void on_tuned(const SpectrumSweepTunedMessage& message);
+	void request_retune();
+	void send_retune();
 };
 
 #endif/*__PROC_WIDEBAND_SPECTRUM_H__*/
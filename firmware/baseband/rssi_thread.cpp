@@ -64,7 +64,7 @@ void RSSIThread::run() {
 			buffer,
 			[](const RSSIStatistics& statistics) {
 				const RSSIStatisticsMessage message { statistics };
-				shared_memory.application_queue.push(message);
+				shared_memory.application_mailbox.post(message);
 			}
 		);
 	}
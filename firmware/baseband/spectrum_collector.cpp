@@ -20,6 +20,7 @@
  */
 
 #include "spectrum_collector.hpp"
+#include "stage_stats_collector.hpp"
 
 #include "dsp_fft.hpp"
 
@@ -30,8 +31,10 @@
 #include "event_m4.hpp"
 
 #include <algorithm>
+#include <cmath>
 
-void SpectrumCollector::on_message(const Message* const message) {
+template<size_t N>
+void BasicSpectrumCollector<N>::on_message(const Message* const message) {
 	switch(message->id) {
 	case Message::ID::UpdateSpectrum:
 		update();
@@ -46,26 +49,72 @@ void SpectrumCollector::on_message(const Message* const message) {
 	}
 }
 
-void SpectrumCollector::set_state(const SpectrumStreamingConfigMessage& message) {
+template<size_t N>
+void BasicSpectrumCollector<N>::set_state(const SpectrumStreamingConfigMessage& message) {
 	if( message.mode == SpectrumStreamingConfigMessage::Mode::Running ) {
+		configure(message);
 		start();
 	} else {
 		stop();
 	}
 }
 
-void SpectrumCollector::start() {
+template<size_t N>
+void BasicSpectrumCollector<N>::configure(const SpectrumStreamingConfigMessage& message) {
+	set_window(message.window);
+
+	streaming_averaging = message.averaging;
+	streaming_average_count = std::max<uint32_t>(message.average_count, 1);
+	averaging = streaming_averaging;
+	average_count = streaming_average_count;
+	average_frames = 0;
+	power.fill(0.0f);
+}
+
+/* Cosine-sum window coefficients: w[n] = a0 - a1*cos(2*pi*n/N) + a2*cos(4*pi*n/N) - ... */
+static constexpr std::array<std::array<float, 5>, 5> window_coefficients { {
+	{ { 1.0f } },										// Rectangular
+	{ { 0.54f, 0.46f } },								// Hamming
+	{ { 0.5f, 0.5f } },									// Hann
+	{ { 0.35875f, 0.48829f, 0.14128f, 0.01168f } },		// Blackman-Harris, 4 term, -92dB sidelobes
+	{ { 0.21557895f, 0.41663158f, 0.277263158f, 0.083578947f, 0.006947368f } },	// Flat top
+} };
+
+template<size_t N>
+void BasicSpectrumCollector<N>::set_window(const Window new_window) {
+	const auto index = std::min<size_t>(toUType(new_window), window_coefficients.size() - 1);
+	const auto& a = window_coefficients[index];
+
+	/* Built once per configuration, from the FFT's own cosine table. */
+	for(size_t n=0; n<window_table.size(); n++) {
+		float w = 0.0f;
+		for(size_t k=0; k<a.size(); k++) {
+			const float c = FFTSineTable<N>::cos(k * n) * (1.0f / 32767.0f);
+			w += (k & 1) ? -a[k] * c : a[k] * c;
+		}
+		window_table[n] = static_cast<int16_t>(std::max(-32767.0f, std::min(32767.0f, w * 32767.0f)));
+	}
+
+	/* Scale so a tone reads the same level whatever the window (coherent gain a0). */
+	window_gain = 1.0f / (a[0] * a[0]);
+	window = new_window;
+}
+
+template<size_t N>
+void BasicSpectrumCollector<N>::start() {
 	streaming = true;
 	ChannelSpectrumConfigMessage message { &fifo };
 	shared_memory.application_queue.push(message);
 }
 
-void SpectrumCollector::stop() {
+template<size_t N>
+void BasicSpectrumCollector<N>::stop() {
 	streaming = false;
 	fifo.reset_in();
 }
 
-void SpectrumCollector::set_decimation_factor(
+template<size_t N>
+void BasicSpectrumCollector<N>::set_decimation_factor(
 	const size_t decimation_factor
 ) {
 	channel_spectrum_decimator.set_factor(decimation_factor);
@@ -76,11 +125,14 @@ void SpectrumCollector::set_decimation_factor(
  * perform the deferred task on the buffer of data we prepared.
  */
 
-void SpectrumCollector::feed(
+template<size_t N>
+void BasicSpectrumCollector<N>::feed(
 	const buffer_c16_t& channel,
 	const uint32_t filter_pass_frequency,
 	const uint32_t filter_stop_frequency
 ) {
+	const StageProbe probe { BasebandStageStatistics::Spectrum };
+
 	// Called from baseband processing thread.
 	channel_filter_pass_frequency = filter_pass_frequency;
 	channel_filter_stop_frequency = filter_stop_frequency;
@@ -93,61 +145,139 @@ void SpectrumCollector::feed(
 	);
 }
 
-void SpectrumCollector::post_message(const buffer_c16_t& data) {
+template<size_t N>
+void BasicSpectrumCollector<N>::set_slice_averaging(const uint32_t count) {
+	averaging = Averaging::Welch;
+	average_count = std::max<uint32_t>(count, 1);
+	average_frames = 0;
+}
+
+template<size_t N>
+void BasicSpectrumCollector<N>::clear_slice_averaging() {
+	averaging = streaming_averaging;
+	average_count = streaming_average_count;
+	average_frames = 0;
+}
+
+template<size_t N>
+bool BasicSpectrumCollector<N>::feed_slice(
+	const buffer_c16_t& data,
+	const int64_t center_frequency
+) {
+	const StageProbe probe { BasebandStageStatistics::Spectrum };
+
+	// Called from baseband processing thread.
+	channel_filter_pass_frequency = 0;
+	channel_filter_stop_frequency = 0;
+
+	return post_message(data, center_frequency);
+}
+
+template<size_t N>
+bool BasicSpectrumCollector<N>::post_message(const buffer_c16_t& data, const int64_t center_frequency) {
 	// Called from baseband processing thread.
 	if( streaming && !channel_spectrum_request_update ) {
 		fft_swap(data, channel_spectrum);
 		channel_spectrum_sampling_rate = data.sampling_rate;
+		channel_spectrum_center_frequency = center_frequency;
 		channel_spectrum_request_update = true;
 		EventDispatcher::events_flag(EVT_MASK_SPECTRUM);
+		return true;
+	}
+	return false;
+}
+
+template<size_t N>
+void BasicSpectrumCollector<N>::apply_window() {
+	if( window == Window::Rectangular ) {
+		return;
+	}
+
+	/* Data is already in bit-reversed order. */
+	for(size_t j=0; j<N; j++) {
+		const size_t i = __RBIT(j) >> (32 - log_2(N));
+		const int32_t w = window_table[(i <= N / 2) ? i : (N - i)];
+		auto& s = channel_spectrum[j];
+		s = {
+			static_cast<int16_t>((s.real() * w) >> 15),
+			static_cast<int16_t>((s.imag() * w) >> 15)
+		};
+	}
+}
+
+/* Folds the latest frame into the averaged power, returns true when a
+ * spectrum is due to be reported.
+ */
+template<size_t N>
+bool BasicSpectrumCollector<N>::accumulate(const float mag2_scale) {
+	const bool first = (average_frames == 0);
+	const float alpha = 1.0f / average_count;
+
+	for(size_t i=0; i<N; i++) {
+		const auto s = channel_spectrum[i];
+		const uint32_t mag2 = static_cast<uint32_t>(s.real() * s.real()) + static_cast<uint32_t>(s.imag() * s.imag());
+		const float p = mag2 * mag2_scale;
+
+		switch(averaging) {
+		case Averaging::Welch:			power[i] = first ? p : (power[i] + p);				break;
+		case Averaging::PeakHold:		power[i] = first ? p : std::max(power[i], p);		break;
+		case Averaging::Exponential:	power[i] = first ? p : (power[i] + (p - power[i]) * alpha);	break;
+		default:						power[i] = p;										break;
+		}
+	}
+	average_frames++;
+
+	if( averaging == Averaging::Welch ) {
+		if( average_frames < average_count ) {
+			return false;
+		}
+		average_frames = 0;
 	}
+	return true;
 }
 
-template<typename T>
-static typename T::value_type spectrum_window_none(const T& s, const size_t i) {
-	static_assert(power_of_two(s.size()), "Array size must be power of 2");
-	return s[i];
-};
-
-template<typename T>
-static typename T::value_type spectrum_window_hamming_3(const T& s, const size_t i) {
-	static_assert(power_of_two(s.size()), "Array size must be power of 2");
-	constexpr size_t mask = s.size() - 1;
-	// Three point Hamming window.
-	return s[i] * 0.54f + (s[(i-1) & mask] + s[(i+1) & mask]) * -0.23f;
-};
-
-template<typename T>
-static typename T::value_type spectrum_window_blackman_3(const T& s, const size_t i) {
-	static_assert(power_of_two(s.size()), "Array size must be power of 2");
-	constexpr size_t mask = s.size() - 1;
-	// Three term Blackman window.
-	constexpr float alpha = 0.42f;
-	constexpr float beta = 0.5f * 0.5f;
-	constexpr float gamma = 0.08f * 0.05f;
-	return s[i] * alpha - (s[(i-1) & mask] + s[(i+1) & mask]) * beta + (s[(i-2) & mask] + s[(i+2) & mask]) * gamma;
-};
-
-void SpectrumCollector::update() {
+template<size_t N>
+void BasicSpectrumCollector<N>::update() {
 	// Called from idle thread (after EVT_MASK_SPECTRUM is flagged)
 	if( streaming && channel_spectrum_request_update ) {
 		/* Decimated buffer is full. Compute spectrum. */
-		fft_c_preswapped(channel_spectrum, 0, 8);
-
-		ChannelSpectrum spectrum;
-		spectrum.sampling_rate = channel_spectrum_sampling_rate;
-		spectrum.channel_filter_pass_frequency = channel_filter_pass_frequency;
-		spectrum.channel_filter_stop_frequency = channel_filter_stop_frequency;
-		for(size_t i=0; i<spectrum.db.size(); i++) {
-			const auto corrected_sample = spectrum_window_hamming_3(channel_spectrum, i);
-			const auto mag2 = magnitude_squared(corrected_sample * (1.0f / 32768.0f));
-			const float db = mag2_to_dbv_norm(mag2);
-			constexpr float mag_scale = 5.0f;
-			const unsigned int v = (db * mag_scale) + 255.0f;
-			spectrum.db[i] = std::max(0U, std::min(255U, v));
+		apply_window();
+		const auto exponent = fft_c16_preswapped(channel_spectrum);
+
+		/* Back to the scale of the unnormalized 256-point transform, relative
+		 * to 32768. A tone reads the same level whatever N, the noise floor
+		 * drops with the finer bins.
+		 */
+		constexpr int n_shift = static_cast<int>(log_2(N)) - 8;
+		const float mag2_scale = std::ldexp(window_gain, 2 * (exponent - n_shift) - 30);
+
+		if( accumulate(mag2_scale) ) {
+			ChannelSpectrum spectrum;
+			spectrum.sampling_rate = channel_spectrum_sampling_rate;
+			spectrum.channel_filter_pass_frequency = channel_filter_pass_frequency;
+			spectrum.channel_filter_stop_frequency = channel_filter_stop_frequency;
+			spectrum.center_frequency = channel_spectrum_center_frequency;
+
+			const float power_scale = (averaging == Averaging::Welch) ? (1.0f / average_count) : 1.0f;
+			constexpr size_t bins_per_db = N / std::tuple_size<decltype(spectrum.db)>::value;
+			for(size_t i=0; i<spectrum.db.size(); i++) {
+				// Peak of the N-point bins centered on each output bin.
+				float power_max = 0.0f;
+				for(size_t j=0; j<bins_per_db; j++) {
+					const size_t n = (i * bins_per_db + j - bins_per_db / 2) & (N - 1);
+					power_max = std::max(power_max, power[n]);
+				}
+				const float db = mag2_to_dbv_norm(power_max * power_scale);
+				constexpr float mag_scale = 5.0f;
+				const unsigned int v = (db * mag_scale) + 255.0f;
+				spectrum.db[i] = std::max(0U, std::min(255U, v));
+			}
+			fifo.in(spectrum);
 		}
-		fifo.in(spectrum);
 	}
 
 	channel_spectrum_request_update = false;
 }
+
+template class BasicSpectrumCollector<256>;
+template class BasicSpectrumCollector<1024>;
@@ -32,7 +32,13 @@
 
 #include "message.hpp"
 
-class SpectrumCollector {
+/* Collects channel samples and computes an N-point windowed spectrum,
+ * optionally averaged over several frames, reduced to the 256 bins of
+ * ChannelSpectrum by taking the peak of each group of N/256 bins. N > 256
+ * gives a finer resolution bandwidth for the same display.
+ */
+template<size_t N>
+class BasicSpectrumCollector {
 public:
 	void on_message(const Message* const message);
 
@@ -44,25 +50,62 @@ public:
 		const uint32_t filter_stop_frequency
 	);
 
+	/* Sweep mode: each block is transformed as-is (no decimation), and
+	 * `count` blocks are averaged into one spectrum, tagged with the
+	 * frequency they were captured at. Returns false if the block was not
+	 * taken because the previous one is still being transformed.
+	 * clear_slice_averaging() goes back to the streaming configuration's
+	 * averaging when the sweep stops.
+	 */
+	void set_slice_averaging(const uint32_t count);
+	void clear_slice_averaging();
+	bool feed_slice(
+		const buffer_c16_t& data,
+		const int64_t center_frequency
+	);
+
 private:
-	BlockDecimator<complex16_t, 256> channel_spectrum_decimator { 1 };
+	BlockDecimator<complex16_t, N> channel_spectrum_decimator { 1 };
 	ChannelSpectrum fifo_data[1 << ChannelSpectrumConfigMessage::fifo_k] { };
 	ChannelSpectrumFIFO fifo { fifo_data, ChannelSpectrumConfigMessage::fifo_k };
 
 	volatile bool channel_spectrum_request_update { false };
 	bool streaming { false };
-	std::array<std::complex<float>, 256> channel_spectrum { };
+	std::array<complex16_t, N> channel_spectrum { };
 	uint32_t channel_spectrum_sampling_rate { 0 };
 	uint32_t channel_filter_pass_frequency { 0 };
 	uint32_t channel_filter_stop_frequency { 0 };
+	int64_t channel_spectrum_center_frequency { 0 };
+
+	using Window = SpectrumStreamingConfigMessage::Window;
+	using Averaging = SpectrumStreamingConfigMessage::Averaging;
 
-	void post_message(const buffer_c16_t& data);
+	/* Periodic window, w[n] == w[N - n], so only [0, N/2] is kept. Q15. */
+	std::array<int16_t, N / 2 + 1> window_table { };
+	Window window { Window::Rectangular };
+	float window_gain { 1.0f };
+
+	/* Power per FFT bin, relative to full scale, averaged over frames. */
+	std::array<float, N> power { };
+	Averaging averaging { Averaging::None };
+	uint32_t average_count { 1 };
+	uint32_t average_frames { 0 };
+	Averaging streaming_averaging { Averaging::None };
+	uint32_t streaming_average_count { 1 };
+
+	bool post_message(const buffer_c16_t& data, const int64_t center_frequency = 0);
 
 	void set_state(const SpectrumStreamingConfigMessage& message);
+	void configure(const SpectrumStreamingConfigMessage& message);
+	void set_window(const Window new_window);
 	void start();
 	void stop();
 
+	void apply_window();
+	bool accumulate(const float mag2_scale);
 	void update();
 };
 
+using SpectrumCollector = BasicSpectrumCollector<256>;
+
 #endif/*__SPECTRUM_COLLECTOR_H__*/
@@ -0,0 +1,71 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "stage_stats_collector.hpp"
+
+#include <algorithm>
+
+StageStatsCollector stage_stats;
+
+bool StageStatsCollector::process(const buffer_c8_t& buffer, const uint32_t execute_cycles) {
+	pending[Stage::Execute] = execute_cycles;
+
+	for(size_t i=0; i<pending.size(); i++) {
+		auto& accumulator = accumulators[i];
+		accumulator.min = std::min(accumulator.min, pending[i]);
+		accumulator.max = std::max(accumulator.max, pending[i]);
+		accumulator.sum += pending[i];
+		pending[i] = 0;
+	}
+
+	if( buffer.sampling_rate ) {
+		budget = static_cast<uint64_t>(halGetCounterFrequency()) * buffer.count / buffer.sampling_rate;
+		if( execute_cycles > budget ) {
+			overruns++;
+		}
+	}
+	buffers++;
+
+	samples += buffer.count;
+
+	const size_t report_samples = buffer.sampling_rate * report_interval;
+	const auto report_delta = samples - samples_last_report;
+	return report_delta >= report_samples;
+}
+
+BasebandStageStatistics StageStatsCollector::capture_statistics() {
+	BasebandStageStatistics statistics;
+
+	for(size_t i=0; i<accumulators.size(); i++) {
+		auto& accumulator = accumulators[i];
+		statistics.stages[i].min = accumulator.min;
+		statistics.stages[i].avg = accumulator.sum / buffers;
+		statistics.stages[i].max = accumulator.max;
+		accumulator = { };
+	}
+	statistics.budget = budget;
+	statistics.buffers = buffers;
+	statistics.overruns = overruns;
+
+	buffers = 0;
+	overruns = 0;
+	samples_last_report = samples;
+
+	return statistics;
+}
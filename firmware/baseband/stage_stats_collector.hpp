@@ -0,0 +1,115 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __STAGE_STATS_COLLECTOR_H__
+#define __STAGE_STATS_COLLECTOR_H__
+
+#include "hal.h"
+
+#include "dsp_types.hpp"
+#include "message.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+/* Accumulates DWT cycle counts for the stages of BasebandProcessor::execute().
+ * Stages are timed by StageProbe; the baseband thread times execute() itself
+ * and calls process() once per buffer. Counts are wall-clock cycles, so they
+ * include any interrupts taken while the stage ran.
+ */
+class StageStatsCollector {
+public:
+	using Stage = BasebandStageStatistics::Stage;
+
+	/* Returns false if the stage is already being timed further up the call
+	 * stack (e.g. ChannelDecimator calling the CIC decimators), so the outer
+	 * probe alone accounts for it.
+	 */
+	bool enter(const Stage stage) {
+		const uint32_t mask = 1U << stage;
+		if( active & mask ) {
+			return false;
+		}
+		active |= mask;
+		return true;
+	}
+
+	void leave(const Stage stage, const uint32_t cycles) {
+		active &= ~(1U << stage);
+		pending[stage] += cycles;
+	}
+
+	template<typename Callback>
+	void process(const buffer_c8_t& buffer, const uint32_t execute_cycles, Callback callback) {
+		if( process(buffer, execute_cycles) ) {
+			callback(capture_statistics());
+		}
+	}
+
+private:
+	struct Accumulator {
+		uint32_t min { UINT32_MAX };
+		uint32_t max { 0 };
+		uint64_t sum { 0 };
+	};
+
+	static constexpr float report_interval { 1.0f };
+	size_t samples { 0 };
+	size_t samples_last_report { 0 };
+	uint32_t active { 0 };
+	std::array<uint32_t, Stage::StageCount> pending { };
+	std::array<Accumulator, Stage::StageCount> accumulators { };
+	uint32_t budget { 0 };
+	uint32_t buffers { 0 };
+	uint32_t overruns { 0 };
+
+	bool process(const buffer_c8_t& buffer, const uint32_t execute_cycles);
+	BasebandStageStatistics capture_statistics();
+};
+
+extern StageStatsCollector stage_stats;
+
+/* Times its enclosing scope as one stage. */
+class StageProbe {
+public:
+	explicit StageProbe(
+		const StageStatsCollector::Stage stage
+	) : stage { stage },
+		timing { stage_stats.enter(stage) },
+		start { halGetCounterValue() }
+	{
+	}
+
+	~StageProbe() {
+		if( timing ) {
+			stage_stats.leave(stage, halGetCounterValue() - start);
+		}
+	}
+
+	StageProbe(const StageProbe&) = delete;
+	StageProbe& operator=(const StageProbe&) = delete;
+
+private:
+	const StageStatsCollector::Stage stage;
+	const bool timing;
+	const uint32_t start;
+};
+
+#endif/*__STAGE_STATS_COLLECTOR_H__*/
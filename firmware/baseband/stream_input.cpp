@@ -24,6 +24,8 @@
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
+#include <algorithm>
+
 StreamInput::StreamInput(CaptureConfig* const config) :
 	fifo_buffers_empty { buffers_empty.data(), buffer_count_max_log2 },
 	fifo_buffers_full { buffers_full.data(), buffer_count_max_log2 },
@@ -74,3 +76,99 @@ size_t StreamInput::write(const void* const data, const size_t length) {
 
 	return written;
 }
+
+size_t StreamInput::write_encoded(const complex16_t* const samples, const size_t count) {
+	size_t written = 0;
+
+	for(size_t n=0; n<count; n+=iq_bfp::block_samples_max) {
+		const auto block_count = std::min(count - n, iq_bfp::block_samples_max);
+		const auto block_bytes = iq_bfp::encode_block(&samples[n], block_count, block.data());
+
+		const size_t space = active_buffer ? (active_buffer->capacity() - active_buffer->size()) : 0;
+		if( (space < block_bytes) && fifo_buffers_empty.is_empty() ) {
+			config->baseband_bytes_received += block_bytes;
+			config->baseband_bytes_dropped += block_bytes;
+			continue;
+		}
+
+		written += write(block.data(), block_bytes);
+	}
+
+	return written;
+}
+
+void* StreamInput::next_destination(const size_t length) {
+	if( reserved ) {
+		return reserved;
+	}
+	if( (destinations_in - destinations_out) >= destinations_max ) {
+		return nullptr;
+	}
+
+	if( !active_buffer ) {
+		if( !fifo_buffers_empty.out(active_buffer) ) {
+			return nullptr;
+		}
+		active_offset = 0;
+	}
+
+	reserved = static_cast<uint8_t*>(active_buffer->data()) + active_offset;
+	active_offset += length;
+	if( active_offset >= active_buffer->capacity() ) {
+		active_buffer = nullptr;
+	}
+	return reserved;
+}
+
+void StreamInput::assigned(const size_t transfers_ahead) {
+	destinations[destinations_in % destinations_max] = { reserved, transfers_filled + transfers_ahead };
+	destinations_in++;
+	reserved = nullptr;
+}
+
+void StreamInput::filled(const size_t length, const size_t transfers) {
+	transfers_filled += transfers;
+
+	// The transfers before the first assigned destination went to the ring,
+	// not to the application. They aren't dropped samples.
+	size_t counted = transfers;
+	if( !streaming ) {
+		if( destinations_out == destinations_in ) {
+			return;
+		}
+		const auto& first = destinations[destinations_out % destinations_max];
+		if( static_cast<int32_t>(transfers_filled - first.transfer) < 0 ) {
+			return;
+		}
+		streaming = true;
+		counted = transfers_filled - first.transfer + 1;
+	}
+
+	// Each space is retired once, by transfer count rather than by address,
+	// so a buffer can't reach the application twice.
+	size_t retired = 0;
+	while( destinations_out != destinations_in ) {
+		const auto& destination = destinations[destinations_out % destinations_max];
+		if( static_cast<int32_t>(transfers_filled - destination.transfer) < 0 ) {
+			break;
+		}
+		retire(destination.p, length);
+		destinations_out++;
+		retired++;
+	}
+
+	config->baseband_bytes_received += counted * length;
+	config->baseband_bytes_dropped += (counted - retired) * length;
+}
+
+void StreamInput::retire(const void* const p, const size_t length) {
+	const size_t offset = static_cast<const uint8_t*>(p) - data.get();
+	const size_t end = (offset % config->write_size) + length;
+	if( end >= config->write_size ) {
+		auto buffer = &buffers[offset / config->write_size];
+		buffer->set_size(config->write_size);
+		// Cannot fail, the FIFO holds every buffer.
+		fifo_buffers_full.in(buffer);
+		creg::m4txevent::assert_event();
+	}
+}
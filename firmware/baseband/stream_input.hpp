@@ -24,6 +24,7 @@
 
 #include "message.hpp"
 #include "fifo.hpp"
+#include "iq_bfp.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -41,6 +42,26 @@ public:
 
 	size_t write(const void* const data, const size_t length);
 
+	/* Block floating point capture, samples are encoded in blocks of up to
+	 * iq_bfp::block_samples_max. A block that does not fit in the free
+	 * buffer space is dropped whole, so the stream stays decodable.
+	 * Returns the number of bytes written.
+	 */
+	size_t write_encoded(const complex16_t* const samples, const size_t count);
+
+	/* DMA-direct capture, the baseband DMA fills the stream buffers in place.
+	 * next_destination() returns the next `length` bytes of buffer space
+	 * (nullptr if none is free), the same space until assigned() records that
+	 * the transfer `transfers_ahead` after the last one filled was pointed at
+	 * it. filled() counts `transfers` completed transfers of `length` bytes,
+	 * retires the space assigned to them, and passes each buffer to the
+	 * application once it is full. The other transfers landed outside the
+	 * stream and are dropped, counting from the first assigned one.
+	 */
+	void* next_destination(const size_t length);
+	void assigned(const size_t transfers_ahead);
+	void filled(const size_t length, const size_t transfers);
+
 private:
 	static constexpr size_t buffer_count_max_log2 = 3;
 	static constexpr size_t buffer_count_max = 1U << buffer_count_max_log2;
@@ -51,8 +72,25 @@ private:
 	std::array<StreamBuffer*, buffer_count_max> buffers_empty { };
 	std::array<StreamBuffer*, buffer_count_max> buffers_full { };
 	StreamBuffer* active_buffer { nullptr };
+	size_t active_offset { 0 };
+
+	struct Destination {
+		const void* p;
+		size_t transfer;
+	};
+	static constexpr size_t destinations_max = 4;
+	std::array<Destination, destinations_max> destinations { };
+	size_t destinations_in { 0 };
+	size_t destinations_out { 0 };
+	void* reserved { nullptr };
+	size_t transfers_filled { 0 };
+	bool streaming { false };
+
+	std::array<uint8_t, iq_bfp::block_bytes_max> block { };
 	CaptureConfig* const config { nullptr };
 	std::unique_ptr<uint8_t[]> data { };
+
+	void retire(const void* const p, const size_t length);
 };
 
 #endif/*__STREAM_INPUT_H__*/
@@ -25,6 +25,8 @@
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
+#include <algorithm>
+
 StreamOutput::StreamOutput(ReplayConfig* const config) :
 	fifo_buffers_empty { buffers_empty.data(), buffer_count_max_log2 },
 	fifo_buffers_full { buffers_full.data(), buffer_count_max_log2 },
@@ -75,3 +77,59 @@ size_t StreamOutput::read(void* const data, const size_t length) {
 
 	return read;
 }
+
+bool StreamOutput::fill_block(size_t& bytes_read) {
+	const auto& header = *reinterpret_cast<const iq_bfp::Header*>(block.data());
+
+	while( block_fill < iq_bfp::header_bytes ) {
+		const auto n = read(&block[block_fill], iq_bfp::header_bytes - block_fill);
+		block_fill += n;
+		bytes_read += n;
+		if( block_fill < iq_bfp::header_bytes ) {
+			return false;
+		}
+		if( !iq_bfp::is_valid(header) ) {
+			// Not a block header, slide along a byte to find one.
+			block[0] = block[1];
+			block_fill = 1;
+		}
+	}
+
+	const auto block_bytes = iq_bfp::block_bytes(header.count);
+	const auto n = read(&block[block_fill], block_bytes - block_fill);
+	block_fill += n;
+	bytes_read += n;
+	return (block_fill == block_bytes);
+}
+
+size_t StreamOutput::read_decoded(complex16_t* const samples, const size_t count) {
+	const auto& header = *reinterpret_cast<const iq_bfp::Header*>(block.data());
+	const auto mantissas = reinterpret_cast<const int8_t*>(&block[iq_bfp::header_bytes]);
+	size_t bytes_read = 0;
+	size_t n = 0;
+
+	while( n < count ) {
+		const bool complete = (block_fill >= iq_bfp::header_bytes) && (block_fill == iq_bfp::block_bytes(header.count));
+		if( !complete || (block_index >= header.count) ) {
+			if( complete ) {
+				block_fill = 0;
+				block_index = 0;
+			}
+			if( !fill_block(bytes_read) ) {
+				break;
+			}
+		}
+
+		const auto exponent = header.exponent;
+		const auto block_end = std::min(block_index + (count - n), static_cast<size_t>(header.count));
+		for(; block_index<block_end; block_index++) {
+			samples[n++] = iq_bfp::decode_sample(&mantissas[block_index * 2], exponent);
+		}
+	}
+
+	for(; n<count; n++) {
+		samples[n] = { 0, 0 };
+	}
+
+	return bytes_read;
+}
@@ -25,6 +25,7 @@
 
 #include "message.hpp"
 #include "fifo.hpp"
+#include "iq_bfp.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -42,6 +43,12 @@ public:
 
 	size_t read(void* const data, const size_t length);
 
+	/* Decodes block floating point samples (iq_bfp.hpp). Blocks may span
+	 * several reads, samples missing because of an underrun are zeroed.
+	 * Returns the number of bytes read from the stream.
+	 */
+	size_t read_decoded(complex16_t* const samples, const size_t count);
+
 private:
 	static constexpr size_t buffer_count_max_log2 = 3;
 	static constexpr size_t buffer_count_max = 1U << buffer_count_max_log2;
@@ -54,6 +61,11 @@ private:
 	StreamBuffer* active_buffer { nullptr };
 	ReplayConfig* const config { nullptr };
 	std::unique_ptr<uint8_t[]> data { };
+	std::array<uint8_t, iq_bfp::block_bytes_max> block { };
+	size_t block_fill { 0 };
+	size_t block_index { 0 };
+
+	bool fill_block(size_t& bytes_read);
 };
 
 #endif/*__STREAM_OUTPUT_H__*/
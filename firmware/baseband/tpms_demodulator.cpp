@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2015 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "tpms_demodulator.hpp"
+
+#include "portapack_shared_memory.hpp"
+#include "message.hpp"
+
+void TPMSDemodulator::execute(const buffer_c16_t& channel) {
+	/* 307.2kHz */
+
+	for(size_t i=0; i<channel.count; i++) {
+		if( mf_38k4_1t_19k2.execute_once(channel.p[i]) ) {
+			clock_recovery_fsk_19k2(mf_38k4_1t_19k2.get_output());
+		}
+	}
+
+	for(size_t i=0; i<channel.count; i+=channel_decimation) {
+		const auto sliced = ook_slicer_5sps(channel.p[i]);
+		slicer_history = (slicer_history << 1) | sliced;
+
+		clock_recovery_ook_8k192(slicer_history, [this](const bool symbol) {
+			this->packet_builder_ook_8k192_schrader.execute(symbol);
+		});
+		clock_recovery_ook_8k4(slicer_history, [this](const bool symbol) {
+			this->packet_builder_ook_8k4_schrader.execute(symbol);
+		});
+	}
+}
+
+void TPMSDemodulator::fsk_19k2_schrader_handler(const baseband::Packet& packet) {
+	const TPMSPacketMessage message { tpms::SignalType::FSK_19k2_Schrader, packet };
+	shared_memory.application_queue.push(message);
+}
+
+void TPMSDemodulator::ook_8k192_schrader_handler(const baseband::Packet& packet) {
+	const TPMSPacketMessage message { tpms::SignalType::OOK_8k192_Schrader, packet };
+	shared_memory.application_queue.push(message);
+}
+
+void TPMSDemodulator::ook_8k4_schrader_handler(const baseband::Packet& packet) {
+	const TPMSPacketMessage message { tpms::SignalType::OOK_8k4_Schrader, packet };
+	shared_memory.application_queue.push(message);
+}
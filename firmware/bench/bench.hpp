@@ -0,0 +1,186 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace bench {
+
+/* FNV-1a over the raw bytes of a block's output. */
+class Hash {
+public:
+	template<typename T>
+	void feed(const T* const p, const size_t count) {
+		const auto bytes = reinterpret_cast<const uint8_t*>(p);
+		for(size_t i=0; i<count * sizeof(T); i++) {
+			value_ = (value_ ^ bytes[i]) * 16777619U;
+		}
+	}
+
+	uint32_t value() const {
+		return value_;
+	}
+
+private:
+	uint32_t value_ { 2166136261U };
+};
+
+static inline uint64_t cycles_now() {
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+class Suite {
+public:
+	/* M4 time available for one 2048-sample buffer at 20Msps. */
+	static constexpr double buffer_budget_ns = 102400.0;
+
+	Suite(
+		const size_t buffer_samples,
+		const size_t repeat
+	) : buffer_samples { buffer_samples },
+		repeat { repeat }
+	{
+	}
+
+	/* Factory builds fresh block state, so each pass starts from reset. The
+	 * body processes baseband buffer n and folds the output into the hash.
+	 * The best of `repeat` timed passes is reported.
+	 */
+	template<typename Factory, typename Body>
+	void run(
+		const char* const name,
+		const size_t buffer_count,
+		Factory factory,
+		Body body
+	) {
+		Result result { name, 0, std::numeric_limits<double>::max(), 0 };
+
+		{
+			Hash hash;
+			auto state = factory();
+			for(size_t n=0; n<buffer_count; n++) {
+				body(*state, n, hash);
+			}
+			result.hash = hash.value();
+		}
+
+		for(size_t r=0; r<repeat; r++) {
+			Hash hash;
+			auto state = factory();
+
+			const auto t0 = std::chrono::steady_clock::now();
+			const auto c0 = cycles_now();
+			for(size_t n=0; n<buffer_count; n++) {
+				body(*state, n, hash);
+			}
+			const auto c1 = cycles_now();
+			const auto t1 = std::chrono::steady_clock::now();
+
+			const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / buffer_count;
+			if( ns < result.ns_per_buffer ) {
+				result.ns_per_buffer = ns;
+				result.cycles_per_buffer = static_cast<double>(c1 - c0) / buffer_count;
+			}
+		}
+
+		results.push_back(result);
+	}
+
+	void print() const {
+		printf("%-24s %12s %16s %10s %10s\n", "block", "ns/sample", "cycles/buffer", "budget%", "hash");
+		for(const auto& r : results) {
+			printf("%-24s %12.3f %16.0f %9.2f%%   %08x\n",
+				r.name.c_str(),
+				r.ns_per_buffer / buffer_samples,
+				r.cycles_per_buffer,
+				r.ns_per_buffer * 100.0 / buffer_budget_ns,
+				r.hash
+			);
+		}
+	}
+
+	bool write_golden(const char* const path) const {
+		FILE* const f = fopen(path, "w");
+		if( !f ) {
+			fprintf(stderr, "cannot write %s\n", path);
+			return false;
+		}
+		for(const auto& r : results) {
+			fprintf(f, "%s %08x\n", r.name.c_str(), r.hash);
+		}
+		fclose(f);
+		return true;
+	}
+
+	bool check_golden(const char* const path) const {
+		FILE* const f = fopen(path, "r");
+		if( !f ) {
+			fprintf(stderr, "cannot read %s\n", path);
+			return false;
+		}
+
+		bool ok = true;
+		char name[64];
+		uint32_t hash;
+		while( fscanf(f, "%63s %x", name, &hash) == 2 ) {
+			for(const auto& r : results) {
+				if( (r.name == name) && (r.hash != hash) ) {
+					fprintf(stderr, "%s: output hash %08x, golden %08x\n", name, r.hash, hash);
+					ok = false;
+				}
+			}
+		}
+		fclose(f);
+
+		printf("\ngolden vectors: %s\n", ok ? "match" : "MISMATCH");
+		return ok;
+	}
+
+private:
+	struct Result {
+		std::string name;
+		uint32_t hash;
+		double ns_per_buffer;
+		double cycles_per_buffer;
+	};
+
+	const size_t buffer_samples;
+	const size_t repeat;
+	std::vector<Result> results { };
+};
+
+} /* namespace bench */
+
+#endif/*__BENCH_H__*/
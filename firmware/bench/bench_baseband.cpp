@@ -0,0 +1,1016 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Replays C8 IQ (as written by the capture app, or synthesized) through the
+ * baseband DSP blocks and reports throughput plus a hash of each block's
+ * output. The hashes act as golden vectors: a DSP change that is meant to be
+ * bit-exact must not change them.
+ *
+ * Timings are normalized to the 2048-sample baseband buffer handed to
+ * BasebandProcessor::execute(), whatever the rate the block itself runs at.
+ * The M4 budget for one such buffer at 20 Msps is 102.4us (see
+ * proc_wideband_spectrum.cpp); host figures are only meaningful relative to
+ * each other, e.g. before/after a change.
+ */
+
+#include "bench.hpp"
+
+#include "host_stubs.hpp"
+
+#include "channel_decimator.hpp"
+#include "dsp_decimate.hpp"
+#include "dsp_demodulate.hpp"
+#include "dsp_fft.hpp"
+#include "dsp_fir_taps.hpp"
+#include "dsp_iir_config.hpp"
+#include "matched_filter.hpp"
+#include "proc_nfm_audio.hpp"
+#include "proc_nfm_channelizer.hpp"
+#include "proc_wideband_spectrum.hpp"
+#include "proc_adsbrx.hpp"
+#include "proc_pocsag.hpp"
+#include "proc_ais.hpp"
+#include "proc_subghz.hpp"
+#include "ais_packet.hpp"
+#include "audio_dma.hpp"
+#include "portapack_shared_memory.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace bench;
+
+namespace {
+
+constexpr size_t buffer_samples = 2048;
+constexpr uint32_t nfm_baseband_fs = 3072000;
+
+std::vector<complex8_t> load_c8(const char* const path) {
+	std::vector<complex8_t> samples;
+
+	FILE* const f = fopen(path, "rb");
+	if( !f ) {
+		fprintf(stderr, "cannot open %s\n", path);
+		return samples;
+	}
+
+	std::array<int8_t, 4096> chunk;
+	size_t n;
+	while( (n = fread(chunk.data(), 1, chunk.size(), f)) >= 2 ) {
+		for(size_t i=0; i+1<n; i+=2) {
+			samples.emplace_back(chunk[i + 0], chunk[i + 1]);
+		}
+	}
+	fclose(f);
+
+	samples.resize(samples.size() - (samples.size() % buffer_samples));
+	return samples;
+}
+
+/* NFM carrier at +fs/4, as the receiver sees it with the LO offset applied by
+ * ReceiverModel::tuning_offset(). 1kHz tone at 2.5kHz deviation, plus a little
+ * noise from a fixed-seed LCG so the output is reproducible.
+ */
+std::vector<complex8_t> synthesize_nfm(const size_t buffer_count) {
+	std::vector<complex8_t> samples(buffer_count * buffer_samples);
+
+	constexpr float fs = nfm_baseband_fs;
+	constexpr float carrier = fs / 4;
+	constexpr float tone = 1000.0f;
+	constexpr float deviation = 2500.0f;
+	constexpr float amplitude = 96.0f;
+	constexpr float two_pi = 6.28318530718f;
+
+	double phase = 0.0;
+	uint32_t lcg = 1;
+	for(size_t n=0; n<samples.size(); n++) {
+		const double t = n / static_cast<double>(fs);
+		const double f = carrier + deviation * std::sin(two_pi * tone * t);
+		phase += two_pi * f / fs;
+		if( phase > two_pi ) {
+			phase -= two_pi;
+		}
+
+		lcg = lcg * 1664525U + 1013904223U;
+		const int noise_i = static_cast<int8_t>(lcg >> 24) / 16;
+		const int noise_q = static_cast<int8_t>(lcg >> 16) / 16;
+
+		samples[n] = {
+			static_cast<int8_t>(std::lround(amplitude * std::cos(phase)) + noise_i),
+			static_cast<int8_t>(std::lround(amplitude * std::sin(phase)) + noise_q)
+		};
+	}
+
+	return samples;
+}
+
+/* A frame synthesize_adsb() sent, before any bit errors. Alone, it must
+ * decode. Of an overlapped pair, the weak frame under may not, and the
+ * strong frame over it usually does: the weak pulses under its start add
+ * bit errors, sometimes more than the CRC corrects.
+ */
+struct ADSBSent {
+	enum class Overlap { None, Under, Over };
+
+	adsb::ADSBFrame frame;
+	Overlap overlap;
+	bool complete;
+};
+
+/* DF17 frames at 2Msps, one every 1500 samples, every fourth overlapped by
+ * a stronger one 100us in, and every third with one or two pulse pairs
+ * corrupted. Pulses alternate between sample-aligned and straddling two
+ * samples.
+ */
+std::vector<complex8_t> synthesize_adsb(const size_t buffer_count, std::vector<ADSBSent>& sent) {
+	std::vector<float> envelope(buffer_count * buffer_samples, 0.0f);
+
+	uint32_t lcg = 1;
+	auto random = [&lcg]() {
+		lcg = lcg * 1664525U + 1013904223U;
+		return lcg >> 8;
+	};
+
+	auto add_frame = [&](const size_t at, const float amplitude, const size_t n, const ADSBSent::Overlap overlap) {
+		adsb::ADSBFrame frame { };
+		frame.push_byte((17 << 3) | 5);
+		for(size_t i=1; i<11; i++) {
+			frame.push_byte(random());
+		}
+		frame.make_CRC();
+
+		// Decoded once the longest frame it could start is in.
+		sent.push_back({ frame, overlap, at + 2 * 240 < envelope.size() });
+
+		const size_t flips = (n % 3) ? 0 : ((n % 2) + 1);
+		for(size_t i=0; i<flips; i++) {
+			frame.flip_bit(8 + random() % 104);
+		}
+
+		std::array<uint8_t, 16 + 224> chips { };
+		for(const auto p : { 0, 2, 7, 9 }) {
+			chips[p] = 1;
+		}
+		const auto data = frame.get_raw_data();
+		for(size_t bit=0; bit<112; bit++) {
+			const bool one = (data[bit >> 3] << (bit & 7)) & 0x80;
+			chips[16 + bit * 2 + (one ? 0 : 1)] = 1;
+		}
+
+		const float late = (n & 1) ? 0.35f : 0.0f;
+		for(size_t i=0; i<chips.size(); i++) {
+			if( chips[i] && (at + i + 1 < envelope.size()) ) {
+				envelope[at + i] += amplitude * (1.0f - late);
+				envelope[at + i + 1] += amplitude * late;
+			}
+		}
+	};
+
+	size_t n = 0;
+	for(size_t at=200; at + 400 < envelope.size(); at+=1500, n++) {
+		if( (n % 4) == 3 ) {
+			add_frame(at, 80.0f, n, ADSBSent::Overlap::Under);
+			add_frame(at + 200, 100.0f, n + 1, ADSBSent::Overlap::Over);
+		} else {
+			add_frame(at, 80.0f, n, ADSBSent::Overlap::None);
+		}
+	}
+
+	std::vector<complex8_t> samples(envelope.size());
+	constexpr float two_pi = 6.28318530718f;
+	for(size_t i=0; i<samples.size(); i++) {
+		const float phase = two_pi * 0.01f * i;
+		const int noise_i = static_cast<int8_t>(random()) / 16;
+		const int noise_q = static_cast<int8_t>(random() >> 8) / 16;
+		samples[i] = {
+			static_cast<int8_t>(std::lround(std::min(envelope[i], 120.0f) * std::cos(phase)) + noise_i),
+			static_cast<int8_t>(std::lround(std::min(envelope[i], 120.0f) * std::sin(phase)) + noise_q)
+		};
+	}
+
+	return samples;
+}
+
+/* POCSAG codeword: 21 bits of data, BCH(31,21) parity, even parity. */
+uint32_t pocsag_codeword(const uint32_t data) {
+	uint32_t remainder = (data & 0x1fffff) << 10;
+	for(int bit=30; bit>=10; bit--) {
+		if( remainder & (1U << bit) ) {
+			remainder ^= 0x769U << (bit - 10);
+		}
+	}
+	const uint32_t codeword = (((data & 0x1fffff) << 10) | remainder) << 1;
+	return codeword | __builtin_parity(codeword);
+}
+
+/* POCSAG batches at 2400, 1200 then 512bps, round robin, FSK at 4.5kHz
+ * deviation on a +fs/4 carrier. Short preambles keep the batches coming.
+ * Every second codeword has one or two bit errors for the BCH decoder.
+ */
+std::vector<complex8_t> synthesize_pocsag(const size_t buffer_count) {
+	std::vector<complex8_t> samples(buffer_count * buffer_samples);
+
+	constexpr float fs = nfm_baseband_fs;
+	constexpr float carrier = fs / 4;
+	constexpr float deviation = 4500.0f;
+	constexpr float amplitude = 96.0f;
+	constexpr float two_pi = 6.28318530718f;
+
+	uint32_t lcg = 1;
+	auto random = [&lcg]() {
+		lcg = lcg * 1664525U + 1013904223U;
+		return lcg >> 8;
+	};
+
+	std::vector<uint32_t> words;
+	std::vector<uint32_t> rates;
+	size_t length = 0;
+	for(size_t batch=0; length<samples.size(); batch++) {
+		const uint32_t rate = (batch % 3 == 0) ? 2400 : ((batch % 3 == 1) ? 1200 : 512);
+		words = { 0xAAAAAAAA, 0xAAAAAAAA, POCSAG_SYNCWORD };
+		for(size_t i=0; i<16; i++) {
+			uint32_t codeword = pocsag_codeword(random());
+			if( i & 1 ) {
+				codeword ^= 1U << (random() % 32);
+				if( i & 2 ) {
+					codeword ^= 1U << (random() % 32);
+				}
+			}
+			words.push_back(codeword);
+		}
+		words.push_back(0xAAAAAAAA);
+
+		for(const auto word : words) {
+			for(int bit=31; bit>=0; bit--) {
+				const size_t bit_samples = fs / rate;
+				for(size_t i=0; i<bit_samples; i++) {
+					rates.push_back(((word >> bit) & 1) ? 1 : 0);
+				}
+			}
+		}
+		length = rates.size();
+	}
+
+	double phase = 0.0;
+	for(size_t n=0; n<samples.size(); n++) {
+		const double f = carrier + (rates[n] ? -deviation : deviation);
+		phase += two_pi * f / fs;
+		if( phase > two_pi ) {
+			phase -= two_pi;
+		}
+
+		const int noise_i = static_cast<int8_t>(random()) / 16;
+		const int noise_q = static_cast<int8_t>(random() >> 8) / 16;
+		samples[n] = {
+			static_cast<int8_t>(std::lround(amplitude * std::cos(phase)) + noise_i),
+			static_cast<int8_t>(std::lround(amplitude * std::sin(phase)) + noise_q)
+		};
+	}
+
+	return samples;
+}
+
+/* AIS HDLC frame for a random type 1 position report, as NRZI line levels:
+ * training, start flag, bit-stuffed data and FCS, end flag.
+ */
+std::vector<uint8_t> ais_frame(const std::function<uint32_t()>& random) {
+	std::vector<uint8_t> data(21);
+	for(auto& byte : data) {
+		byte = random();
+	}
+	data[0] = (data[0] & 0xc0) | 0x20;		// message_id 1, first six bits sent
+
+	/* FCS: CRC-16-CCITT over the bits as sent, complemented. */
+	uint16_t fcs = 0xffff;
+	for(const auto byte : data) {
+		for(int bit=7; bit>=0; bit--) {
+			const bool b = ((byte >> bit) & 1) ^ ((fcs >> 15) & 1);
+			fcs = (fcs << 1) ^ (b ? 0x1021 : 0);
+		}
+	}
+	fcs ^= 0xffff;
+
+	std::vector<uint8_t> bits;
+	for(size_t i=0; i<24; i++) {
+		bits.push_back(i & 1);
+	}
+	for(int bit=7; bit>=0; bit--) {
+		bits.push_back((0x7e >> bit) & 1);
+	}
+
+	size_t ones = 0;
+	auto put_stuffed = [&bits, &ones](const uint8_t bit) {
+		bits.push_back(bit);
+		ones = bit ? (ones + 1) : 0;
+		if( ones == 5 ) {
+			bits.push_back(0);
+			ones = 0;
+		}
+	};
+	for(const auto byte : data) {
+		for(int bit=7; bit>=0; bit--) {
+			put_stuffed((byte >> bit) & 1);
+		}
+	}
+	for(int bit=15; bit>=0; bit--) {
+		put_stuffed((fcs >> bit) & 1);
+	}
+
+	for(int bit=7; bit>=0; bit--) {
+		bits.push_back((0x7e >> bit) & 1);
+	}
+	for(size_t i=0; i<8; i++) {
+		bits.push_back(1);
+	}
+
+	/* NRZI: a zero is sent as a change of level. */
+	std::vector<uint8_t> levels;
+	uint8_t level = 0;
+	for(const auto bit : bits) {
+		level ^= (bit ? 0 : 1);
+		levels.push_back(level);
+	}
+	return levels;
+}
+
+/* AIS on both channels, 25kHz either side of +fs/4 at 2.4576Msps: 9600bps
+ * FSK at 2400Hz deviation. The two channels' frames overlap in time.
+ */
+std::vector<complex8_t> synthesize_ais(const size_t buffer_count) {
+	std::vector<complex8_t> samples(buffer_count * buffer_samples);
+
+	constexpr float fs = 2457600.0f;
+	constexpr size_t bit_samples = 256;
+	constexpr float deviation = 2400.0f;
+	constexpr float amplitude = 48.0f;
+	constexpr float two_pi = 6.28318530718f;
+
+	uint32_t lcg = 3;
+	const std::function<uint32_t()> random = [&lcg]() {
+		lcg = lcg * 1664525U + 1013904223U;
+		return lcg >> 8;
+	};
+
+	std::array<std::vector<int8_t>, 2> symbols;
+	for(size_t c=0; c<2; c++) {
+		auto& s = symbols[c];
+		// Idle carrier for a while, B starts later so frames partly overlap.
+		s.assign(bit_samples * (16 + c * 120), 0);
+		while( s.size() < samples.size() ) {
+			for(const auto level : ais_frame(random)) {
+				s.insert(s.end(), bit_samples, level ? 1 : -1);
+			}
+			s.insert(s.end(), bit_samples * 40, 0);
+		}
+	}
+
+	std::array<double, 2> phase { 0.0, 0.0 };
+	for(size_t n=0; n<samples.size(); n++) {
+		float i = 0.0f;
+		float q = 0.0f;
+		for(size_t c=0; c<2; c++) {
+			const float carrier = fs / 4 + ((c == 0) ? -25000.0f : 25000.0f);
+			if( symbols[c][n] ) {
+				phase[c] += two_pi * (carrier + symbols[c][n] * deviation) / fs;
+				if( phase[c] > two_pi ) {
+					phase[c] -= two_pi;
+				}
+				i += amplitude * std::cos(phase[c]);
+				q += amplitude * std::sin(phase[c]);
+			}
+		}
+
+		const int noise_i = static_cast<int8_t>(random()) / 16;
+		const int noise_q = static_cast<int8_t>(random() >> 8) / 16;
+		samples[n] = {
+			static_cast<int8_t>(std::lround(i) + noise_i),
+			static_cast<int8_t>(std::lround(q) + noise_q)
+		};
+	}
+
+	return samples;
+}
+
+constexpr uint32_t subghz_baseband_fs = 4915200;
+
+/* A PT2262 frame, as trits '0', '1' and 'F', sent as high/low pulse pairs
+ * and read by OOKRemoteDecoder as two bits each: "00", "11" and "01".
+ */
+uint32_t pt2262_code(const char* const trits) {
+	uint32_t code = 0;
+	for(const char* t=trits; *t; t++) {
+		code = (code << 2) | ((*t == '0') ? 0b00 : ((*t == '1') ? 0b11 : 0b01));
+	}
+	return code;
+}
+
+/* SCM fields, laid out after the sync word as ert::Packet reads them. */
+struct ERTSCM {
+	uint32_t id;
+	uint32_t commodity_type;
+	uint32_t consumption;
+};
+
+std::vector<uint8_t> ert_scm_bits(const ERTSCM& scm) {
+	std::vector<uint8_t> bits;
+	auto put = [&bits](const uint32_t value, const size_t length) {
+		for(size_t i=length; i>0; i--) {
+			bits.push_back((value >> (i - 1)) & 1);
+		}
+	};
+	put(scm.id >> 24, 2);
+	put(0, 3);
+	put(scm.commodity_type, 4);
+	put(0, 2);
+	put(scm.consumption, 24);
+	put(scm.id, 24);
+
+	/* BCH parity, polynomial 0x6f63. */
+	uint32_t crc = 0;
+	for(const auto bit : bits) {
+		const bool feedback = ((crc >> 15) & 1) ^ bit;
+		crc = ((crc << 1) ^ (feedback ? 0x6f63 : 0)) & 0xffff;
+	}
+	put(crc, 16);
+	return bits;
+}
+
+const std::array<const char*, 2> subghz_pt2262_trits { { "0F1F0011FF10", "1F00F1F0F011" } };
+const ERTSCM subghz_scm { 0x2a5c3f1, 4, 123456 };
+
+/* SubGHz at +fs/4: a strong PT2262 remote, four frames of 350us short
+ * pulses, then one 22dB weaker sending just the two frames the decoder needs
+ * to agree, then an ERT SCM burst 300kHz above, 16384bps Manchester at one
+ * half-bit per 150 samples.
+ */
+std::vector<complex8_t> synthesize_subghz(const size_t buffer_count) {
+	constexpr double fs = subghz_baseband_fs;
+	constexpr double two_pi = 6.28318530717958647692;
+	constexpr size_t ook_short = fs * 350e-6;
+	constexpr size_t scm_half_bit = 150;
+
+	std::vector<complex8_t> samples;
+
+	uint32_t lcg = 5;
+	double phase = 0.0;
+	auto emit = [&](const size_t count, const double frequency, const double amplitude) {
+		for(size_t i=0; i<count; i++) {
+			phase += two_pi * frequency / fs;
+			if( phase > two_pi ) {
+				phase -= two_pi;
+			}
+			lcg = lcg * 1664525U + 1013904223U;
+			const int noise_i = static_cast<int8_t>(lcg >> 8) / 32;
+			const int noise_q = static_cast<int8_t>(lcg >> 16) / 32;
+			samples.push_back({
+				static_cast<int8_t>(std::lround(amplitude * std::cos(phase)) + noise_i),
+				static_cast<int8_t>(std::lround(amplitude * std::sin(phase)) + noise_q)
+			});
+		}
+	};
+
+	emit(buffer_samples * 40, 0, 0);
+
+	const std::array<double, 2> pt2262_amplitude { { 100.0, 8.0 } };
+	const std::array<size_t, 2> pt2262_frames { { 4, 2 } };
+	for(size_t remote=0; remote<subghz_pt2262_trits.size(); remote++) {
+		const auto amplitude = pt2262_amplitude[remote];
+		auto pair = [&](const size_t high, const size_t low) {
+			emit(ook_short * high, fs / 4, amplitude);
+			emit(ook_short * low, fs / 4, 0);
+		};
+		for(size_t frame=0; frame<pt2262_frames[remote]; frame++) {
+			for(const char* t=subghz_pt2262_trits[remote]; *t; t++) {
+				pair((*t == '1') ? 3 : 1, (*t == '1') ? 1 : 3);
+				pair((*t == '0') ? 1 : 3, (*t == '0') ? 3 : 1);
+			}
+			pair(1, 31);
+		}
+		emit(buffer_samples * 120, 0, 0);
+	}
+
+	std::vector<uint8_t> scm_bits;
+	for(size_t i=21; i>0; i--) {
+		scm_bits.push_back((0x1f2a60 >> (i - 1)) & 1);
+	}
+	const auto payload = ert_scm_bits(subghz_scm);
+	scm_bits.insert(scm_bits.end(), payload.begin(), payload.end());
+	for(const auto bit : scm_bits) {
+		emit(scm_half_bit, 300000, bit ? 40 : 0);
+		emit(scm_half_bit, 300000, bit ? 0 : 40);
+	}
+
+	emit(std::max(buffer_count * buffer_samples, samples.size() + buffer_samples * 40) - samples.size(), 0, 0);
+	samples.resize(samples.size() - (samples.size() % buffer_samples));
+	return samples;
+}
+
+buffer_c8_t baseband_buffer(std::vector<complex8_t>& samples, const size_t index) {
+	return { &samples[index * buffer_samples], buffer_samples, nfm_baseband_fs };
+}
+
+/* Each baseband buffer folded to N samples, as WidebandSpectrum does. */
+template<size_t N>
+std::vector<std::array<complex16_t, N>> presum_c8(std::vector<complex8_t>& samples, const size_t buffer_count) {
+	std::vector<std::array<complex16_t, N>> blocks(buffer_count);
+	for(size_t n=0; n<buffer_count; n++) {
+		const auto src = baseband_buffer(samples, n);
+		auto& dst = blocks[n];
+		dst.fill({ 0, 0 });
+		for(size_t i=0; i<src.count; i++) {
+			const auto s = src.p[i];
+			auto& d = dst[i & (N - 1)];
+			d = { static_cast<int16_t>(d.real() + s.real()), static_cast<int16_t>(d.imag() + s.imag()) };
+		}
+	}
+	return blocks;
+}
+
+template<size_t N>
+void bench_fft_c16(Suite& suite, const char* const name, std::vector<complex8_t>& samples, const size_t buffer_count) {
+	const auto presum_blocks = presum_c8<N>(samples, buffer_count);
+	struct State {
+		std::array<complex16_t, N> data { };
+	};
+	suite.run(name, buffer_count,
+		[]() { return std::make_unique<State>(); },
+		[&](State& s, const size_t n, Hash& hash) {
+			auto presum = presum_blocks[n];
+			fft_swap(buffer_c16_t { presum.data(), presum.size() }, s.data);
+			const int exponent = fft_c16_preswapped(s.data);
+			hash.feed(s.data.data(), s.data.size());
+			hash.feed(&exponent, 1);
+		}
+	);
+}
+
+void usage() {
+	fprintf(stderr,
+		"usage: baseband_bench [options] [capture.C8]\n"
+		"  -n <count>      synthesized buffer count (default 1024)\n"
+		"  -r <count>      timing repetitions (default 5)\n"
+		"  -g <file>       compare output hashes against golden file\n"
+		"  -w <file>       write output hashes to golden file\n"
+	);
+}
+
+} /* namespace */
+
+int main(int argc, char* argv[]) {
+	size_t buffer_count = 1024;
+	size_t repeat = 5;
+	const char* input_path = nullptr;
+	const char* golden_read_path = nullptr;
+	const char* golden_write_path = nullptr;
+
+	for(int i=1; i<argc; i++) {
+		const bool has_value = (i + 1) < argc;
+		if( !strcmp(argv[i], "-n") && has_value ) {
+			buffer_count = strtoul(argv[++i], nullptr, 0);
+		} else if( !strcmp(argv[i], "-r") && has_value ) {
+			repeat = strtoul(argv[++i], nullptr, 0);
+		} else if( !strcmp(argv[i], "-g") && has_value ) {
+			golden_read_path = argv[++i];
+		} else if( !strcmp(argv[i], "-w") && has_value ) {
+			golden_write_path = argv[++i];
+		} else if( argv[i][0] != '-' ) {
+			input_path = argv[i];
+		} else {
+			usage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	auto samples = input_path ? load_c8(input_path) : synthesize_nfm(buffer_count);
+	buffer_count = samples.size() / buffer_samples;
+	if( buffer_count == 0 ) {
+		fprintf(stderr, "no complete %zu-sample buffers in input\n", buffer_samples);
+		return EXIT_FAILURE;
+	}
+
+	printf("%s: %zu buffers of %zu C8 samples, %zu repetitions\n\n",
+		input_path ? input_path : "synthesized NFM", buffer_count, buffer_samples, repeat);
+
+	Suite suite { buffer_samples, repeat };
+
+	/* Wideband front-end, as used by the AM/WFM-era processors. */
+	suite.run("ChannelDecimator/32", buffer_count,
+		[]() { return std::make_unique<ChannelDecimator>(ChannelDecimator::DecimationFactor::By32); },
+		[&](ChannelDecimator& decimator, const size_t n, Hash& hash) {
+			const auto out = decimator.execute(baseband_buffer(samples, n));
+			hash.feed(out.p, out.count);
+		}
+	);
+
+	/* First stage of the NFM/AIS/ERT/TPMS decimation chains. */
+	struct Decim0 {
+		dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
+		std::array<complex16_t, 256> dst { };
+	};
+	suite.run("FIRC8xR16x24FS4Decim8", buffer_count,
+		[]() {
+			auto s = std::make_unique<Decim0>();
+			s->decim_0.configure(taps_11k0_decim_0.taps, 33554432);
+			return s;
+		},
+		[&](Decim0& s, const size_t n, Hash& hash) {
+			const auto out = s.decim_0.execute(baseband_buffer(samples, n), { s.dst.data(), s.dst.size() });
+			hash.feed(out.p, out.count);
+		}
+	);
+
+	/* FM discriminator alone, fed with the real NFM channel (the channel
+	 * filter output is precomputed so only the demodulator is timed).
+	 */
+	std::vector<complex16_t> channel;
+	{
+		dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
+		dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
+		dsp::decimate::FIRAndDecimateComplex channel_filter { };
+		decim_0.configure(taps_11k0_decim_0.taps, 33554432);
+		decim_1.configure(taps_11k0_decim_1.taps, 131072);
+		channel_filter.configure(taps_11k0_channel.taps, 2);
+
+		std::array<complex16_t, 512> dst { };
+		const buffer_c16_t dst_buffer { dst.data(), dst.size() };
+		for(size_t n=0; n<buffer_count; n++) {
+			const auto decim_0_out = decim_0.execute(baseband_buffer(samples, n), dst_buffer);
+			const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
+			const auto channel_out = channel_filter.execute(decim_1_out, dst_buffer);
+			channel.insert(channel.end(), channel_out.p, channel_out.p + channel_out.count);
+		}
+	}
+	const size_t channel_per_buffer = channel.size() / buffer_count;
+
+	struct Demod {
+		dsp::demodulate::FM demod { };
+		std::array<int16_t, 32> audio { };
+	};
+	suite.run("demodulate::FM", buffer_count,
+		[]() {
+			auto s = std::make_unique<Demod>();
+			s->demod.configure(nfm_baseband_fs / 8 / 8 / 2, 2500);
+			return s;
+		},
+		[&](Demod& s, const size_t n, Hash& hash) {
+			const buffer_c16_t src { &channel[n * channel_per_buffer], channel_per_buffer, nfm_baseband_fs / 128 };
+			const auto out = s.demod.execute(src, buffer_s16_t { s.audio.data(), s.audio.size() });
+			hash.feed(out.p, out.count);
+		}
+	);
+
+	/* Matched filter alone on the same channel samples, with 16 taps of
+	 * two periods of a complex tone, decimating by 8 as TPMS and ACARS do.
+	 */
+	struct MF {
+		static std::array<std::complex<float>, 16> taps() {
+			std::array<std::complex<float>, 16> t;
+			for(size_t i=0; i<t.size(); i++) {
+				t[i] = std::polar(1.0f / t.size(), 2.0f * static_cast<float>(pi) * i / 8);
+			}
+			return t;
+		}
+
+		dsp::matched_filter::MatchedFilter mf { taps(), 8 };
+	};
+	suite.run("MatchedFilter/16", buffer_count,
+		[]() { return std::make_unique<MF>(); },
+		[&](MF& s, const size_t n, Hash& hash) {
+			for(size_t i=0; i<channel_per_buffer; i++) {
+				if( s.mf.execute_once(channel[n * channel_per_buffer + i]) ) {
+					const int32_t output = std::lround(s.mf.get_output());
+					hash.feed(&output, 1);
+				}
+			}
+		}
+	);
+
+	/* Spectrum transforms, one per baseband buffer, on the wideband input
+	 * presummed to the transform size. cycles/buffer is cycles per transform.
+	 */
+	const auto presum_256 = presum_c8<256>(samples, buffer_count);
+	struct FFTFloat256 {
+		std::array<std::complex<float>, 256> data { };
+	};
+	suite.run("fft_c_preswapped/256", buffer_count,
+		[]() { return std::make_unique<FFTFloat256>(); },
+		[&](FFTFloat256& s, const size_t n, Hash& hash) {
+			auto presum = presum_256[n];
+			fft_swap(buffer_c16_t { presum.data(), presum.size() }, s.data);
+			fft_c_preswapped(s.data, 0, 8);
+			hash.feed(s.data.data(), s.data.size());
+		}
+	);
+
+	bench_fft_c16<256>(suite, "fft_c16_preswapped/256", samples, buffer_count);
+	bench_fft_c16<512>(suite, "fft_c16_preswapped/512", samples, buffer_count);
+	bench_fft_c16<1024>(suite, "fft_c16_preswapped/1024", samples, buffer_count);
+
+	/* Complete NFM receive path, including squelch, audio filters, CTCSS,
+	 * channel statistics and spectrum collection.
+	 */
+	suite.run("NarrowbandFMAudio", buffer_count,
+		[]() {
+			auto p = std::make_unique<NarrowbandFMAudio>();
+			const NBFMConfigureMessage message {
+				taps_11k0_decim_0,
+				taps_11k0_decim_1,
+				taps_11k0_channel,
+				2,
+				2500,
+				audio_24k_hpf_300hz_config,
+				audio_24k_deemph_300_6_config,
+				0
+			};
+			p->on_message(&message);
+			return p;
+		},
+		[&](NarrowbandFMAudio& p, const size_t n, Hash& hash) {
+			p.execute(baseband_buffer(samples, n));
+			const auto audio = audio::dma::tx_empty_buffer();
+			hash.feed(audio.p, audio.count);
+			host::drain_application_queue();
+		}
+	);
+
+	/* Sixteen 12.5kHz NFM channels monitored at once, listening to the
+	 * strongest open one.
+	 */
+	suite.run("NarrowbandFMChannelizer", buffer_count,
+		[]() {
+			auto p = std::make_unique<NarrowbandFMChannelizer>();
+			const ChannelizerConfigureMessage message {
+				12500,
+				16,
+				2500,
+				audio_24k_hpf_300hz_config,
+				audio_24k_deemph_300_6_config,
+				-60,
+				-1
+			};
+			p->on_message(&message);
+			return p;
+		},
+		[&](NarrowbandFMChannelizer& p, const size_t n, Hash& hash) {
+			p.execute(baseband_buffer(samples, n));
+			const auto audio = audio::dma::tx_empty_buffer();
+			hash.feed(audio.p, audio.count);
+			host::drain_application_queue();
+		}
+	);
+
+	/* Sweep mode, ten 20MHz slices 10MHz apart, with the application's
+	 * retune acknowledged as soon as it is requested.
+	 */
+	struct Sweep {
+		WidebandSpectrum processor { };
+		ChannelSpectrumFIFO* fifo { nullptr };
+	};
+
+	suite.run("WidebandSpectrumSweep", buffer_count,
+		[]() {
+			auto s = std::make_unique<Sweep>();
+			const WidebandSpectrumConfigMessage config { 20000000, 0 };
+			s->processor.on_message(&config);
+			const SpectrumStreamingConfigMessage streaming {
+				SpectrumStreamingConfigMessage::Mode::Running,
+				SpectrumStreamingConfigMessage::Window::Hamming
+			};
+			s->processor.on_message(&streaming);
+			const SpectrumSweepConfigMessage sweep { 2400000000, 10000000, 10, 1, 1 };
+			s->processor.on_message(&sweep);
+			return s;
+		},
+		[&](Sweep& s, const size_t n, Hash& hash) {
+			s.processor.execute(baseband_buffer(samples, n));
+			const UpdateSpectrumMessage update;
+			s.processor.on_message(&update);
+
+			shared_memory.application_queue.handle([&s](Message* const p) {
+				if( p->id == Message::ID::ChannelSpectrumConfig ) {
+					s.fifo = reinterpret_cast<const ChannelSpectrumConfigMessage*>(p)->fifo;
+				} else if( p->id == Message::ID::SpectrumSweepRetune ) {
+					const SpectrumSweepTunedMessage tuned {
+						reinterpret_cast<const SpectrumSweepRetuneMessage*>(p)->frequency
+					};
+					s.processor.on_message(&tuned);
+				}
+			});
+
+			ChannelSpectrum spectrum;
+			while( s.fifo && s.fifo->out(spectrum) ) {
+				hash.feed(spectrum.db.data(), spectrum.db.size());
+				hash.feed(&spectrum.center_frequency, 1);
+			}
+			host::drain_application_queue();
+		}
+	);
+
+	/* ADS-B, on its own synthesized 2Msps input. The budget is ten times
+	 * the 20Msps one shown.
+	 */
+	std::vector<ADSBSent> adsb_sent;
+	auto adsb_samples = synthesize_adsb(buffer_count, adsb_sent);
+	std::vector<adsb::ADSBFrame> adsb_decoded;
+	suite.run("ADSBRX", buffer_count,
+		[&]() {
+			adsb_decoded.clear();
+			auto p = std::make_unique<ADSBRXProcessor>();
+			const ADSBConfigureMessage message { 1 };
+			p->on_message(&message);
+			return p;
+		},
+		[&](ADSBRXProcessor& p, const size_t n, Hash& hash) {
+			p.execute(baseband_buffer(adsb_samples, n));
+			shared_memory.application_queue.handle([&](Message* const m) {
+				if( m->id == Message::ID::ADSBFrame ) {
+					const auto frame = reinterpret_cast<const ADSBFrameMessage*>(m)->frame;
+					hash.feed(frame.get_raw_data(), 14);
+					adsb_decoded.push_back(frame);
+				}
+			});
+		}
+	);
+
+	/* POCSAG, all three bit rates decoded at once. A 2400bps batch takes
+	 * about 250ms, so run long enough to see one of each rate.
+	 */
+	const size_t pocsag_buffer_count = std::max<size_t>(buffer_count, 4096);
+	auto pocsag_samples = synthesize_pocsag(pocsag_buffer_count);
+	suite.run("POCSAG", pocsag_buffer_count,
+		[]() {
+			auto p = std::make_unique<POCSAGProcessor>();
+			const POCSAGConfigureMessage message { pocsag::BitRate::UNKNOWN, false };
+			p->on_message(&message);
+			return p;
+		},
+		[&](POCSAGProcessor& p, const size_t n, Hash& hash) {
+			p.execute(baseband_buffer(pocsag_samples, n));
+			shared_memory.application_queue.handle([&hash](Message* const m) {
+				if( m->id == Message::ID::POCSAGPacket ) {
+					const auto& packet = reinterpret_cast<const POCSAGPacketMessage*>(m)->packet;
+					const uint32_t bitrate = packet.bitrate();
+					hash.feed(&bitrate, 1);
+					for(size_t i=0; i<16; i++) {
+						const uint32_t codeword = packet[i];
+						hash.feed(&codeword, 1);
+					}
+				}
+			});
+		}
+	);
+
+	/* AIS, both channels decoded at once. */
+	auto ais_samples = synthesize_ais(buffer_count);
+	suite.run("AIS", buffer_count,
+		[]() {
+			return std::make_unique<AISProcessor>();
+		},
+		[&](AISProcessor& p, const size_t n, Hash& hash) {
+			p.execute(baseband_buffer(ais_samples, n));
+			shared_memory.application_queue.handle([&hash](Message* const m) {
+				if( m->id == Message::ID::AISPacket ) {
+					const auto message = reinterpret_cast<const AISPacketMessage*>(m);
+					const ais::Packet packet { message->packet };
+					const uint32_t header[] { message->channel, packet.is_valid(), static_cast<uint32_t>(packet.length()) };
+					hash.feed(header, 3);
+					for(size_t i=0; i<packet.length(); i+=8) {
+						const uint8_t byte = packet.read(i, 8);
+						hash.feed(&byte, 1);
+					}
+				}
+			});
+		}
+	);
+
+	/* SubGHz receiver, OOK remotes and ERT from one stream. The decoded
+	 * codes are checked as well as hashed.
+	 */
+	auto subghz_samples = synthesize_subghz(buffer_count);
+	const size_t subghz_buffer_count = subghz_samples.size() / buffer_samples;
+	std::vector<uint32_t> subghz_ook_codes;
+	std::vector<std::vector<uint8_t>> subghz_scms;
+	suite.run("SubGHz", subghz_buffer_count,
+		[&]() {
+			subghz_ook_codes.clear();
+			subghz_scms.clear();
+			return std::make_unique<SubGHzProcessor>();
+		},
+		[&](SubGHzProcessor& p, const size_t n, Hash& hash) {
+			p.execute({ &subghz_samples[n * buffer_samples], buffer_samples, subghz_baseband_fs });
+			shared_memory.application_queue.handle([&](Message* const m) {
+				if( m->id == Message::ID::OOKRemotePacket ) {
+					const auto message = reinterpret_cast<const OOKRemotePacketMessage*>(m);
+					const uint32_t fields[] { static_cast<uint32_t>(message->code), static_cast<uint32_t>(message->bit_count), message->short_pulse_us };
+					hash.feed(fields, 3);
+					subghz_ook_codes.push_back((message->bit_count == 24) ? message->code : ~0U);
+				}
+				if( m->id == Message::ID::ERTPacket ) {
+					const auto message = reinterpret_cast<const ERTPacketMessage*>(m);
+					const auto& packet = message->packet;
+					const uint32_t fields[] { static_cast<uint32_t>(message->type), static_cast<uint32_t>(packet.size()) };
+					hash.feed(fields, 2);
+					// Manchester, as ert::Packet decodes it: the first half-bit.
+					std::vector<uint8_t> bits;
+					for(size_t i=0; (i + 1)<packet.size(); i+=2) {
+						const uint8_t bit = packet[i];
+						bits.push_back((packet[i] != packet[i + 1]) ? bit : 2);
+					}
+					hash.feed(bits.data(), bits.size());
+					if( message->type == ert::Packet::Type::SCM ) {
+						subghz_scms.push_back(bits);
+					}
+				}
+			});
+		}
+	);
+
+	/* Decoded frames come out in the order sent, as sent, with a clean CRC.
+	 * Every lone frame decodes, and nine in ten of those sent over another.
+	 * Only where frames overlap may one be miscorrected into another code.
+	 */
+	size_t adsb_next = 0;
+	size_t adsb_missed = 0;
+	size_t adsb_bad = 0;
+	size_t adsb_over_sent = 0;
+	size_t adsb_over_decoded = 0;
+	auto adsb_skip_to = [&](const size_t i) {
+		for(; adsb_next<i; adsb_next++) {
+			const auto& sent = adsb_sent[adsb_next];
+			adsb_missed += (sent.complete && (sent.overlap == ADSBSent::Overlap::None)) ? 1 : 0;
+			adsb_over_sent += (sent.complete && (sent.overlap == ADSBSent::Overlap::Over)) ? 1 : 0;
+		}
+	};
+	for(auto& frame : adsb_decoded) {
+		size_t i = adsb_next;
+		while( (i < adsb_sent.size()) && memcmp(adsb_sent[i].frame.get_raw_data(), frame.get_raw_data(), 14) ) {
+			i++;
+		}
+		if( frame.syndrome() != 0 ) {
+			adsb_bad++;
+		} else if( i == adsb_sent.size() ) {
+			const bool in_overlap = (adsb_next < adsb_sent.size()) && (adsb_sent[adsb_next].overlap != ADSBSent::Overlap::None);
+			adsb_bad += in_overlap ? 0 : 1;
+		} else {
+			adsb_skip_to(i);
+			adsb_over_sent += (adsb_sent[i].overlap == ADSBSent::Overlap::Over) ? 1 : 0;
+			adsb_over_decoded += (adsb_sent[i].overlap == ADSBSent::Overlap::Over) ? 1 : 0;
+			adsb_next = i + 1;
+		}
+	}
+	adsb_skip_to(adsb_sent.size());
+	const bool adsb_ok = (adsb_missed == 0) && (adsb_bad == 0) && (adsb_over_decoded * 10 >= adsb_over_sent * 9);
+
+	bool decoded_ok = (subghz_ook_codes.size() == subghz_pt2262_trits.size()) && (subghz_scms.size() == 1);
+	for(size_t i=0; decoded_ok && (i<subghz_ook_codes.size()); i++) {
+		decoded_ok &= (subghz_ook_codes[i] == pt2262_code(subghz_pt2262_trits[i]));
+	}
+	const auto scm_bits = ert_scm_bits(subghz_scm);
+	for(const auto& bits : subghz_scms) {
+		decoded_ok &= (bits.size() >= scm_bits.size()) && std::equal(scm_bits.begin(), scm_bits.end(), bits.begin());
+	}
+
+	suite.print();
+
+	bool ok = true;
+	if( !adsb_ok ) {
+		fprintf(stderr, "ADSBRX: decoded %zu frames, %zu lone ones missed, %zu of %zu overlapping, %zu not as sent\n",
+			adsb_decoded.size(), adsb_missed, adsb_over_decoded, adsb_over_sent, adsb_bad);
+		ok = false;
+	}
+	if( !decoded_ok ) {
+		fprintf(stderr, "SubGHz: decoded %zu OOK codes and %zu SCM packets, not the ones sent\n",
+			subghz_ook_codes.size(), subghz_scms.size());
+		ok = false;
+	}
+	if( golden_write_path ) {
+		ok &= suite.write_golden(golden_write_path);
+	}
+	if( golden_read_path ) {
+		ok &= suite.check_golden(golden_read_path);
+	}
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
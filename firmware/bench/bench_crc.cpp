@@ -0,0 +1,123 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Throughput of the bitwise CRC<> against TableCRC<> (byte-at-a-time and
+ * slice-by-4) for the protocol checksums in the tree. Each variant's
+ * checksum is compared against the bitwise one, so a table generation bug
+ * shows up as a mismatch rather than just a number.
+ *
+ *   crc_bench [-n bytes] [-r repetitions]
+ */
+
+#include "bench.hpp"
+
+#include "crc.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+template<typename Engine>
+void run(
+	const char* const name,
+	Engine engine,
+	const std::vector<uint8_t>& data,
+	const size_t repeat,
+	const uint32_t reference
+) {
+	double best = std::numeric_limits<double>::max();
+	uint32_t checksum = 0;
+
+	for(size_t r=0; r<repeat; r++) {
+		engine.reset();
+		const auto c0 = bench::cycles_now();
+		engine.process_bytes(data.data(), data.size());
+		checksum = engine.checksum();
+		const auto c1 = bench::cycles_now();
+
+		const double cycles = static_cast<double>(c1 - c0);
+		if( cycles < best ) {
+			best = cycles;
+		}
+	}
+
+	printf("%-28s %12.3f %12.2f   %08x %s\n",
+		name,
+		data.size() / best,
+		best / data.size(),
+		checksum,
+		(checksum == reference) ? "" : "MISMATCH"
+	);
+}
+
+template<size_t Width, uint32_t Polynomial, bool RevIn, bool RevOut>
+void compare(
+	const char* const name,
+	const uint32_t initial,
+	const uint32_t final_xor,
+	const std::vector<uint8_t>& data,
+	const size_t repeat
+) {
+	CRC<Width, RevIn, RevOut> reference { Polynomial, initial, final_xor };
+	reference.process_bytes(data.data(), data.size());
+	const auto expected = reference.checksum();
+
+	const std::string s { name };
+	run((s + " bitwise").c_str(), CRC<Width, RevIn, RevOut> { Polynomial, initial, final_xor }, data, repeat, expected);
+	run((s + " table").c_str(), TableCRC<Width, Polynomial, RevIn, RevOut, 1> { initial, final_xor }, data, repeat, expected);
+	run((s + " slice-by-4").c_str(), TableCRC<Width, Polynomial, RevIn, RevOut, 4> { initial, final_xor }, data, repeat, expected);
+}
+
+} /* namespace */
+
+int main(int argc, char* argv[]) {
+	size_t length = 65536;
+	size_t repeat = 9;
+
+	for(int i=1; i<argc; i++) {
+		const bool has_value = (i + 1) < argc;
+		if( !strcmp(argv[i], "-n") && has_value ) {
+			length = strtoul(argv[++i], nullptr, 0);
+		} else if( !strcmp(argv[i], "-r") && has_value ) {
+			repeat = strtoul(argv[++i], nullptr, 0);
+		} else {
+			fprintf(stderr, "usage: crc_bench [-n bytes] [-r repetitions]\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::vector<uint8_t> data(length);
+	uint32_t lfsr = 0x12345678;
+	for(auto& v : data) {
+		lfsr = lfsr * 1664525U + 1013904223U;
+		v = lfsr >> 24;
+	}
+
+	printf("%zu bytes, best of %zu\n\n", length, repeat);
+	printf("%-28s %12s %12s   %8s\n", "crc", "bytes/cycle", "cycles/byte", "checksum");
+
+	compare<32, 0x04c11db7, true, true>("CRC-32 (PNG)", 0xffffffff, 0xffffffff, data, repeat);
+	compare<24, 0xFFF409, false, false>("CRC-24 (ADS-B)", 0, 0, data, repeat);
+	compare<24, 0x00065B, false, false>("CRC-24 (BTLE)", 0x555555, 0, data, repeat);
+	compare<16, 0x1021, false, false>("CRC-16 (AIS)", 0xffff, 0xffff, data, repeat);
+	compare<16, 0x1021, true, true>("CRC-16 (AX.25)", 0xffff, 0xffff, data, repeat);
+
+	return EXIT_SUCCESS;
+}
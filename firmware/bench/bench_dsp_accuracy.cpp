@@ -0,0 +1,182 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Accuracy of the fixed-point DSP blocks against double-precision
+ * references. Each check prints its error figures and fails if they fall
+ * outside the bounds the block was designed to, so a scaling or rounding
+ * regression fails the run rather than just moving a hash.
+ *
+ *   dsp_accuracy_bench
+ */
+
+#include "bench.hpp"
+
+#include "dsp_fft.hpp"
+#include "dsp_iir.hpp"
+#include "dsp_iir_config.hpp"
+
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+bool report(const char* const name, const char* const metric, const double value, const bool ok) {
+	printf("%-28s %-16s %10.2f   %s\n", name, metric, value, ok ? "ok" : "FAIL");
+	return ok;
+}
+
+/* DFT(input) from fft_c16_preswapped() against a direct double DFT. The
+ * input has both signs in both halves, so normalization errors that leak
+ * between the packed real and imaginary halves show up as noise.
+ */
+template<size_t N>
+bool check_fft_c16(const char* const name, const double amplitude, const double min_snr_db, const double max_spur_db) {
+	constexpr double two_pi = 6.28318530717958647692;
+
+	std::vector<std::complex<double>> x(N);
+	std::array<complex16_t, N> input;
+	uint32_t lcg = 7;
+	for(size_t n=0; n<N; n++) {
+		lcg = lcg * 1664525U + 1013904223U;
+		const double noise = ((lcg >> 24) & 0x0f) - 7.5;
+		const double phase = two_pi * 37.3 * n / N;
+		const int16_t re = std::lround(amplitude * std::cos(phase) + noise);
+		const int16_t im = std::lround(amplitude * std::sin(phase) - noise);
+		input[n] = { re, im };
+		x[n] = { static_cast<double>(re), static_cast<double>(im) };
+	}
+
+	std::array<complex16_t, N> data;
+	fft_swap(buffer_c16_t { input.data(), input.size() }, data);
+	const int exponent = fft_c16_preswapped(data);
+	const double scale = std::ldexp(1.0, exponent);
+
+	double signal_power = 0.0;
+	double error_power = 0.0;
+	double peak_power = 0.0;
+	double spur_power = 0.0;
+	for(size_t k=0; k<N; k++) {
+		std::complex<double> ref { 0.0, 0.0 };
+		for(size_t n=0; n<N; n++) {
+			ref += x[n] * std::polar(1.0, -two_pi * ((k * n) % N) / N);
+		}
+		const std::complex<double> out { data[k].real() * scale, data[k].imag() * scale };
+		const double e = std::norm(out - ref);
+		signal_power += std::norm(ref);
+		error_power += e;
+		peak_power = std::max(peak_power, std::norm(ref));
+		spur_power = std::max(spur_power, e);
+	}
+
+	const double snr_db = 10.0 * std::log10(signal_power / error_power);
+	const double spur_db = 10.0 * std::log10(spur_power / peak_power);
+
+	bool ok = true;
+	ok &= report(name, "SNR dB", snr_db, snr_db >= min_snr_db);
+	ok &= report(name, "worst error dBc", spur_db, spur_db <= max_spur_db);
+	return ok;
+}
+
+/* IIRBiquadCascade against the same sections in transposed direct form
+ * II double precision, from the same float coefficients. Errors are in
+ * int16 LSBs of the output, so the final rounding alone is 0.29 rms.
+ */
+template<size_t N>
+bool check_iir_cascade(
+	const char* const name,
+	const std::array<const iir_biquad_config_t*, N>& configs,
+	const double max_rms_lsb,
+	const double max_peak_lsb
+) {
+	constexpr double two_pi = 6.28318530717958647692;
+	constexpr double fs = 48000.0;
+	constexpr size_t block = 32;
+	constexpr size_t count = 48000 * 4;
+
+	IIRBiquadCascade<N> cascade;
+	for(size_t i=0; i<N; i++) {
+		cascade.configure(i, *configs[i]);
+	}
+
+	std::array<std::array<double, 2>, N> state { };
+	std::array<int16_t, block> in;
+	std::array<int16_t, block> out;
+	uint32_t lcg = 11;
+	double error_sum = 0;
+	double error_peak = 0;
+
+	for(size_t n0=0; n0<count; n0+=block) {
+		for(size_t i=0; i<block; i++) {
+			const size_t n = n0 + i;
+			lcg = lcg * 1664525U + 1013904223U;
+			const double noise = static_cast<int32_t>(lcg >> 17) - 16384;
+			in[i] = std::lround(
+				2000.0 +
+				6000.0 * std::sin(two_pi * 200.0 * n / fs) +
+				6000.0 * std::sin(two_pi * 1000.0 * n / fs) +
+				noise / 2
+			);
+		}
+
+		cascade.execute(buffer_s16_t { in.data(), in.size() }, buffer_s16_t { out.data(), out.size() });
+
+		for(size_t i=0; i<block; i++) {
+			double y = in[i];
+			for(size_t k=0; k<N; k++) {
+				const auto& c = *configs[k];
+				const double x = y;
+				y = c.b[0] * x + state[k][0];
+				state[k][0] = c.b[1] * x - c.a[1] * y + state[k][1];
+				state[k][1] = c.b[2] * x - c.a[2] * y;
+			}
+			const double e = std::abs(out[i] - y);
+			error_sum += e * e;
+			error_peak = std::max(error_peak, e);
+		}
+	}
+
+	const double error_rms = std::sqrt(error_sum / count);
+
+	bool ok = true;
+	ok &= report(name, "rms error LSB", error_rms, error_rms <= max_rms_lsb);
+	ok &= report(name, "peak error LSB", error_peak, error_peak <= max_peak_lsb);
+	return ok;
+}
+
+} /* namespace */
+
+int main() {
+	bool ok = true;
+
+	/* Small input, normalized up (shift > 0). */
+	ok &= check_fft_c16<256>("fft_c16/256 amplitude 100", 100.0, 50.0, -60.0);
+	ok &= check_fft_c16<1024>("fft_c16/1024 amplitude 100", 100.0, 50.0, -60.0);
+	/* Full scale input, normalized down (shift < 0). */
+	ok &= check_fft_c16<1024>("fft_c16/1024 amplitude 30000", 30000.0, 50.0, -60.0);
+
+	/* AudioOutput's NFM filter, and each section alone. */
+	ok &= check_iir_cascade<2>("iir 48k hpf 30Hz + deemph", { &audio_48k_hpf_30hz_config, &audio_48k_deemph_300_6_config }, 0.35, 1.0);
+	ok &= check_iir_cascade<1>("iir 48k hpf 30Hz", { &audio_48k_hpf_30hz_config }, 0.35, 1.0);
+	ok &= check_iir_cascade<1>("iir 48k deemph 300Hz", { &audio_48k_deemph_300_6_config }, 0.35, 1.0);
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,334 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Symbol throughput of PacketBuilder with each decoder's matchers, against a
+ * reference builder that calls its handler through std::function and counts
+ * pattern errors with popcount, as PacketBuilder used to. The symbol stream
+ * is noise with a packet every few hundred symbols. Both builders must find
+ * the same packets, so a matcher bug shows up as a mismatch.
+ *
+ *   packet_builder_bench [-n symbols] [-r repetitions]
+ */
+
+#include "bench.hpp"
+
+#include "packet_builder.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+namespace {
+
+struct ReferencePattern {
+	uint64_t code;
+	size_t code_length;
+	size_t maximum_hanning_distance;
+
+	bool operator()(const BitHistory& history, const size_t) const {
+		const uint64_t mask = (1ULL << code_length) - 1ULL;
+		const auto delta_bits = (history.value() ^ code) & mask;
+		return static_cast<size_t>(__builtin_popcountll(delta_bits)) <= maximum_hanning_distance;
+	}
+};
+
+template<typename UnstuffMatcher, typename EndMatcher>
+class ReferencePacketBuilder {
+public:
+	ReferencePacketBuilder(
+		const ReferencePattern preamble,
+		const UnstuffMatcher unstuff,
+		const EndMatcher end,
+		std::function<void(const baseband::Packet&)> payload_handler
+	) : payload_handler { std::move(payload_handler) },
+		preamble(preamble),
+		unstuff(unstuff),
+		end(end)
+	{
+	}
+
+	void execute(const uint_fast8_t symbol) {
+		bit_history.add(symbol);
+
+		if( !in_payload ) {
+			in_payload = preamble(bit_history, packet.size());
+			return;
+		}
+
+		if( !unstuff(bit_history, packet.size()) ) {
+			packet.add(symbol);
+		}
+
+		if( end(bit_history, packet.size()) ) {
+			if( payload_handler ) {
+				payload_handler(packet);
+			}
+			reset_state();
+		} else if( packet.size() >= packet.capacity() ) {
+			reset_state();
+		}
+	}
+
+private:
+	const std::function<void(const baseband::Packet&)> payload_handler;
+
+	BitHistory bit_history { };
+	ReferencePattern preamble;
+	UnstuffMatcher unstuff;
+	EndMatcher end;
+
+	bool in_payload { false };
+	baseband::Packet packet { };
+
+	void reset_state() {
+		packet.clear();
+		in_payload = false;
+	}
+};
+
+struct NeverMatchReference {
+	bool operator()(const BitHistory&, const size_t) const {
+		return false;
+	}
+};
+
+/* Hashing every packet bit would swamp the builder's own cost, so timed
+ * passes only count packets and the contents are compared in a separate pass.
+ */
+struct Counter {
+	bool hash_contents { false };
+	bench::Hash hash { };
+	size_t packets { 0 };
+
+	void handler(const baseband::Packet& packet) {
+		if( hash_contents ) {
+			const auto size = packet.size();
+			hash.feed(&size, 1);
+			for(size_t i=0; i<size; i++) {
+				const uint8_t bit = packet[i];
+				hash.feed(&bit, 1);
+			}
+		}
+		packets++;
+	}
+};
+
+using CounterHandler = PacketHandler<Counter, &Counter::handler>;
+
+class SymbolStream {
+public:
+	SymbolStream(
+		const size_t length
+	) {
+		symbols.reserve(length + 4096);
+	}
+
+	uint32_t random() {
+		lfsr = lfsr * 1664525U + 1013904223U;
+		return lfsr >> 16;
+	}
+
+	void noise(const size_t count) {
+		for(size_t i=0; i<count; i++) {
+			symbols.push_back(random() & 1);
+		}
+	}
+
+	void code(const uint64_t value, const size_t length) {
+		for(size_t i=length; i>0; i--) {
+			symbols.push_back((value >> (i - 1)) & 1);
+		}
+	}
+
+	/* HDLC-style: a zero after five ones, then the closing flag. */
+	void stuffed(const size_t count) {
+		size_t ones = 0;
+		for(size_t i=0; i<count; i++) {
+			const uint8_t bit = random() & 1;
+			symbols.push_back(bit);
+			ones = bit ? (ones + 1) : 0;
+			if( ones == 5 ) {
+				symbols.push_back(0);
+				ones = 0;
+			}
+		}
+		code(0b01111110, 8);
+	}
+
+	std::vector<uint8_t> symbols { };
+
+private:
+	uint32_t lfsr { 0x12345678 };
+};
+
+template<typename New, typename Reference>
+void run(
+	const char* const name,
+	const std::vector<uint8_t>& symbols,
+	const size_t repeat,
+	New make_new,
+	Reference make_reference
+) {
+	auto time = [&](auto make, Counter& counter) {
+		counter.hash_contents = true;
+		auto builder = make(counter);
+		for(const auto symbol : symbols) {
+			builder->execute(symbol);
+		}
+		const auto hash = counter.hash;
+
+		double best = std::numeric_limits<double>::max();
+		for(size_t r=0; r<repeat; r++) {
+			counter = { };
+			auto builder = make(counter);
+			const auto c0 = bench::cycles_now();
+			for(const auto symbol : symbols) {
+				builder->execute(symbol);
+			}
+			const auto c1 = bench::cycles_now();
+			best = std::min(best, static_cast<double>(c1 - c0));
+		}
+		counter.hash = hash;
+		return best;
+	};
+
+	Counter reference_counter;
+	Counter new_counter;
+	const auto reference_cycles = time(make_reference, reference_counter);
+	const auto new_cycles = time(make_new, new_counter);
+
+	const bool match =
+		(new_counter.packets == reference_counter.packets) &&
+		(new_counter.hash.value() == reference_counter.hash.value());
+
+	printf("%-24s %12.2f %12.2f %8.2fx %8zu   %08x %s\n",
+		name,
+		reference_cycles / symbols.size(),
+		new_cycles / symbols.size(),
+		reference_cycles / new_cycles,
+		new_counter.packets,
+		new_counter.hash.value(),
+		match ? "" : "MISMATCH"
+	);
+}
+
+/* Preamble-and-sync followed by a fixed number of symbols: ERT, TPMS, Sonde. */
+template<typename Pattern>
+void run_fixed_length(
+	const char* const name,
+	const uint64_t code,
+	const size_t code_length,
+	const size_t maximum_hanning_distance,
+	const size_t length,
+	const size_t symbol_count,
+	const size_t repeat
+) {
+	SymbolStream stream { symbol_count };
+	while( stream.symbols.size() < symbol_count ) {
+		stream.noise(200 + (stream.random() & 255));
+		stream.code(code, code_length);
+		stream.noise(length);
+	}
+
+	run(name, stream.symbols, repeat,
+		[&](Counter& counter) {
+			return std::make_unique<PacketBuilder<Pattern, NeverMatch, FixedLength, CounterHandler>>(
+				Pattern(code, code_length, maximum_hanning_distance),
+				NeverMatch { },
+				FixedLength { length },
+				CounterHandler { &counter }
+			);
+		},
+		[&](Counter& counter) {
+			return std::make_unique<ReferencePacketBuilder<NeverMatchReference, FixedLength>>(
+				ReferencePattern { code, code_length, maximum_hanning_distance },
+				NeverMatchReference { },
+				FixedLength { length },
+				[&counter](const baseband::Packet& packet) { counter.handler(packet); }
+			);
+		}
+	);
+}
+
+void run_ais(
+	const size_t symbol_count,
+	const size_t repeat
+) {
+	SymbolStream stream { symbol_count };
+	while( stream.symbols.size() < symbol_count ) {
+		stream.noise(200 + (stream.random() & 255));
+		stream.code(0b0101010101111110, 16);
+		stream.stuffed(168 + 16);
+	}
+
+	run("AIS", stream.symbols, repeat,
+		[&](Counter& counter) {
+			return std::make_unique<PacketBuilder<BitPattern32, BitPattern32, BitPattern32, CounterHandler>>(
+				BitPattern32 { 0b0101010101111110, 16, 1 },
+				BitPattern32 { 0b111110, 6 },
+				BitPattern32 { 0b01111110, 8 },
+				CounterHandler { &counter }
+			);
+		},
+		[&](Counter& counter) {
+			return std::make_unique<ReferencePacketBuilder<ReferencePattern, ReferencePattern>>(
+				ReferencePattern { 0b0101010101111110, 16, 1 },
+				ReferencePattern { 0b111110, 6, 0 },
+				ReferencePattern { 0b01111110, 8, 0 },
+				[&counter](const baseband::Packet& packet) { counter.handler(packet); }
+			);
+		}
+	);
+}
+
+} /* namespace */
+
+int main(int argc, char* argv[]) {
+	size_t symbol_count = 1 << 20;
+	size_t repeat = 9;
+
+	for(int i=1; i<argc; i++) {
+		const bool has_value = (i + 1) < argc;
+		if( !strcmp(argv[i], "-n") && has_value ) {
+			symbol_count = strtoul(argv[++i], nullptr, 0);
+		} else if( !strcmp(argv[i], "-r") && has_value ) {
+			repeat = strtoul(argv[++i], nullptr, 0);
+		} else {
+			fprintf(stderr, "usage: packet_builder_bench [-n symbols] [-r repetitions]\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	printf("%zu symbols, best of %zu\n\n", symbol_count, repeat);
+	printf("%-24s %12s %12s %9s %8s   %8s\n", "decoder", "ref cyc/sym", "cyc/sym", "speedup", "packets", "hash");
+
+	/* Patterns and lengths as configured in the proc_*.hpp headers. */
+	run_ais(symbol_count, repeat);
+	run_fixed_length<BitPattern32>("ERT SCM", 0b101010101001011001100110010110100101010101, 32, 1, 150, symbol_count, repeat);
+	run_fixed_length<BitPattern>("ERT IDM", 0b0110011001100110011001100110011001010110011010011001100101011010, 48, 1, 1408, symbol_count, repeat);
+	run_fixed_length<BitPattern32>("TPMS FSK 19k2", 0b010101010101010101010101010110, 30, 1, 160, symbol_count, repeat);
+	run_fixed_length<BitPattern32>("TPMS OOK 8k192", 0b010101010101010101011110, 24, 0, 37 * 2, symbol_count, repeat);
+	run_fixed_length<BitPattern32>("TPMS OOK 8k4", 0b01010101010101010101010101100101, 32, 0, 76 * 2, symbol_count, repeat);
+	run_fixed_length<BitPattern32>("Sonde Meteomodem", 0b00110011001100110101100110110011, 32, 1, 88 * 2 * 8, symbol_count, repeat);
+	run_fixed_length<BitPattern32>("Sonde Vaisala", 0b00001000011011010101001110001000, 32, 1, 320 * 8, symbol_count, repeat);
+
+	return EXIT_SUCCESS;
+}
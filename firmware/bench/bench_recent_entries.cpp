@@ -0,0 +1,224 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* RecentEntries against a std::list model of the same most-recently-used
+ * policy. Random and deliberately colliding key streams exercise eviction,
+ * the hash index's backward-shift removal and the MRU order; after every
+ * update the container must match the model both ways round, find() every
+ * key the same, and hold each entry's own state.
+ *
+ *   recent_entries_bench
+ */
+
+#include "recent_entries.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <vector>
+
+namespace {
+
+template<typename KeyType>
+struct TestEntry {
+	using Key = KeyType;
+	static constexpr Key invalid_key = static_cast<Key>(-1);
+
+	static int live;
+
+	Key k;
+	size_t updates { 0 };
+
+	TestEntry(const Key k) : k { k } { live++; }
+	~TestEntry() { live--; }
+
+	Key key() const { return k; }
+};
+
+template<typename KeyType>
+int TestEntry<KeyType>::live = 0;
+
+template<typename KeyType>
+struct ModelEntry {
+	KeyType key;
+	size_t updates;
+};
+
+template<typename KeyType, size_t Capacity>
+class Checker {
+public:
+	using Entry = TestEntry<KeyType>;
+
+	Checker(const char* const name) : name { name } { }
+
+	void on_packet(const KeyType key) {
+		auto& entry = entries.on_packet(key);
+		entry.updates++;
+
+		auto it = model.begin();
+		while( (it != model.end()) && (it->key != key) ) {
+			++it;
+		}
+		if( it != model.end() ) {
+			model.splice(model.begin(), model, it);
+		} else {
+			if( model.size() == Capacity ) {
+				model.pop_back();
+			}
+			model.push_front({ key, 0 });
+		}
+		model.front().updates++;
+		ops++;
+	}
+
+	void clear() {
+		entries.clear();
+		model.clear();
+	}
+
+	bool check(const std::vector<KeyType>& keys) {
+		if( entries.size() != model.size() ) {
+			return fail("size", entries.size(), model.size());
+		}
+		if( Entry::live != static_cast<int>(model.size()) ) {
+			return fail("live entries", Entry::live, model.size());
+		}
+
+		auto m = model.begin();
+		for(const auto& entry : entries) {
+			if( (m == model.end()) || (entry.key() != m->key) || (entry.updates != m->updates) ) {
+				return fail("MRU order", entry.key(), (m == model.end()) ? 0 : m->key);
+			}
+			++m;
+		}
+
+		auto r = model.rbegin();
+		for(auto it = entries.end(); it != entries.begin(); ) {
+			--it;
+			if( (r == model.rend()) || (it->key() != r->key) ) {
+				return fail("reverse order", it->key(), (r == model.rend()) ? 0 : r->key);
+			}
+			++r;
+		}
+
+		for(const auto key : keys) {
+			bool in_model = false;
+			for(const auto& e : model) {
+				in_model |= (e.key == key);
+			}
+			const auto found = (entries.find(key) != entries.end());
+			if( found != in_model ) {
+				return fail("find", key, in_model);
+			}
+		}
+		return true;
+	}
+
+	bool report() const {
+		printf("%-36s %8zu updates   ok\n", name, ops);
+		return true;
+	}
+
+private:
+	const char* const name;
+	RecentEntries<Entry, Capacity> entries { };
+	std::list<ModelEntry<KeyType>> model { };
+	size_t ops { 0 };
+
+	bool fail(const char* const what, const uint64_t got, const uint64_t expected) const {
+		printf("%-36s %8zu updates   FAIL %s: %llu, expected %llu\n",
+			name, ops, what,
+			static_cast<unsigned long long>(got), static_cast<unsigned long long>(expected)
+		);
+		return false;
+	}
+};
+
+uint32_t lcg_next(uint32_t& lcg) {
+	lcg = lcg * 1664525U + 1013904223U;
+	return lcg >> 8;
+}
+
+/* Uniform keys from a space a few times the capacity: a mix of hits,
+ * inserts and evictions.
+ */
+template<typename KeyType, size_t Capacity>
+bool check_random(const char* const name, const size_t key_space, const KeyType key_stride, const size_t count) {
+	std::vector<KeyType> keys;
+	for(size_t i=0; i<key_space; i++) {
+		keys.push_back(static_cast<KeyType>(i * key_stride + 1));
+	}
+
+	Checker<KeyType, Capacity> checker { name };
+	uint32_t lcg = 1;
+	for(size_t n=0; n<count; n++) {
+		checker.on_packet(keys[lcg_next(lcg) % keys.size()]);
+		if( !checker.check(keys) ) {
+			return false;
+		}
+	}
+
+	// Reuse after clear().
+	checker.clear();
+	for(size_t n=0; n<Capacity * 2; n++) {
+		checker.on_packet(keys[lcg_next(lcg) % keys.size()]);
+	}
+	return checker.check(keys) && checker.report();
+}
+
+/* Keys whose index slots all land in a narrow band, so every insert and
+ * removal works on long probe runs that wrap around the table end.
+ */
+template<size_t Capacity>
+bool check_colliding(const char* const name, const size_t count) {
+	constexpr size_t index_bits = 7;
+	static_assert((size_t { 1 } << index_bits) >= Capacity * 2, "index size");
+
+	std::vector<uint32_t> keys;
+	for(uint32_t key=1; keys.size() < Capacity * 3; key++) {
+		const uint32_t slot = (recent_entry_hash(key) * 2654435769U) >> (32 - index_bits);
+		if( (slot >= 126) || (slot <= 1) ) {
+			keys.push_back(key);
+		}
+	}
+
+	Checker<uint32_t, Capacity> checker { name };
+	uint32_t lcg = 3;
+	for(size_t n=0; n<count; n++) {
+		checker.on_packet(keys[lcg_next(lcg) % keys.size()]);
+		if( !checker.check(keys) ) {
+			return false;
+		}
+	}
+	return checker.report();
+}
+
+} /* namespace */
+
+int main() {
+	bool ok = true;
+
+	ok &= check_random<uint32_t, 64>("random, 64 of 192 keys", 192, 1, 20000);
+	ok &= check_random<uint32_t, 16>("random, 16 of 20 keys", 20, 7, 20000);
+	// Keys differing only above bit 32, folded by recent_entry_hash().
+	ok &= check_random<uint64_t, 64>("random 64-bit, 64 of 160 keys", 160, uint64_t { 1 } << 33, 20000);
+	ok &= check_colliding<64>("colliding slots, 64 of 192 keys", 20000);
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host stand-in for the ChibiOS/RT kernel header. The benchmark drives
+ * processors synchronously from a single thread, so locking and signalling
+ * primitives collapse to no-ops.
+ */
+
+#ifndef __HOST_CH_H__
+#define __HOST_CH_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+
+#include "hal.h"
+
+using msg_t = int32_t;
+using tprio_t = uint32_t;
+using eventmask_t = uint32_t;
+using systime_t = uint32_t;
+using tfunc_t = msg_t (*)(void*);
+
+constexpr tprio_t NORMALPRIO = 64;
+
+#define EVENT_MASK(eid) ((eventmask_t)(1 << (eid)))
+#define ALL_EVENTS ((eventmask_t)-1)
+
+#define WORKING_AREA(s, n) uint8_t s[n]
+
+struct Thread { };
+struct Mutex { };
+
+static inline void chMtxInit(Mutex*) { }
+static inline void chMtxLock(Mutex*) { }
+static inline Mutex* chMtxUnlock() { return nullptr; }
+
+static inline void chSysLock() { }
+static inline void chSysUnlock() { }
+static inline void chSysLockFromIsr() { }
+static inline void chSysUnlockFromIsr() { }
+static inline void chSysHalt() { }
+
+static inline void chEvtSignal(Thread*, const eventmask_t) { }
+static inline void chEvtSignalI(Thread*, const eventmask_t) { }
+
+static inline void chThdSleepMilliseconds(const uint32_t) { }
+static inline bool chThdShouldTerminate() { return true; }
+
+static inline void* chHeapAlloc(void*, const size_t size) { return malloc(size); }
+static inline void chHeapFree(void* const p) { free(p); }
+
+#endif/*__HOST_CH_H__*/
@@ -0,0 +1,278 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host stand-in for the ChibiOS HAL / CMSIS headers. Provides portable C
+ * implementations of the Cortex-M4 DSP intrinsics used by the baseband code,
+ * bit-exact with the instructions they replace, so DSP blocks produce the
+ * same output on the host as on the M4.
+ */
+
+#ifndef __HOST_HAL_H__
+#define __HOST_HAL_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define __STATIC_INLINE static inline
+
+#define __SIMD32_TYPE int32_t
+#define __SIMD32(addr)  (*(__SIMD32_TYPE **) & (addr))
+#define _SIMD32_OFFSET(addr) (*(__SIMD32_TYPE *) (addr))
+
+namespace host_simd {
+
+static inline int32_t lo(const uint32_t x) { return static_cast<int16_t>(x & 0xffff); }
+static inline int32_t hi(const uint32_t x) { return static_cast<int16_t>(x >> 16); }
+
+static inline uint32_t pack(const int32_t l, const int32_t h) {
+	return (static_cast<uint32_t>(l) & 0xffff) | (static_cast<uint32_t>(h) << 16);
+}
+
+static inline int32_t sat(const int64_t x, const unsigned bits) {
+	const int64_t max = (int64_t(1) << (bits - 1)) - 1;
+	const int64_t min = -(int64_t(1) << (bits - 1));
+	return static_cast<int32_t>((x > max) ? max : ((x < min) ? min : x));
+}
+
+static inline uint32_t ror(const uint32_t x, const uint32_t n) {
+	return n ? ((x >> n) | (x << (32 - n))) : x;
+}
+
+} /* namespace host_simd */
+
+/* DWT_CYCCNT stand-in, for the baseband stage probes. */
+typedef uint32_t halrtcnt_t;
+
+static inline halrtcnt_t halGetCounterValue() {
+#if defined(__x86_64__) || defined(__i386__)
+	return static_cast<halrtcnt_t>(__rdtsc());
+#else
+	return 0;
+#endif
+}
+
+static inline uint32_t halGetCounterFrequency() {
+	return 200000000U;
+}
+
+static inline void __DMB() { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __DSB() { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __ISB() { }
+static inline void __SEV() { }
+static inline void __WFE() { }
+static inline void __NOP() { }
+
+static inline int32_t __SSAT(const int32_t x, const uint32_t bits) {
+	return host_simd::sat(x, bits);
+}
+
+static inline uint32_t __USAT(const int32_t x, const uint32_t bits) {
+	const int32_t max = (1 << bits) - 1;
+	return (x < 0) ? 0 : ((x > max) ? max : x);
+}
+
+static inline int32_t __QADD(const int32_t a, const int32_t b) {
+	return host_simd::sat(int64_t(a) + b, 32);
+}
+
+static inline int32_t __QSUB(const int32_t a, const int32_t b) {
+	return host_simd::sat(int64_t(a) - b, 32);
+}
+
+static inline uint32_t __QADD16(const uint32_t a, const uint32_t b) {
+	using namespace host_simd;
+	return pack(sat(lo(a) + lo(b), 16), sat(hi(a) + hi(b), 16));
+}
+
+static inline uint32_t __QSUB16(const uint32_t a, const uint32_t b) {
+	using namespace host_simd;
+	return pack(sat(lo(a) - lo(b), 16), sat(hi(a) - hi(b), 16));
+}
+
+static inline uint32_t __SADD16(const uint32_t a, const uint32_t b) {
+	using namespace host_simd;
+	return pack(lo(a) + lo(b), hi(a) + hi(b));
+}
+
+static inline uint32_t __SSUB16(const uint32_t a, const uint32_t b) {
+	using namespace host_simd;
+	return pack(lo(a) - lo(b), hi(a) - hi(b));
+}
+
+static inline uint32_t __SHADD16(const uint32_t a, const uint32_t b) {
+	using namespace host_simd;
+	return pack((lo(a) + lo(b)) >> 1, (hi(a) + hi(b)) >> 1);
+}
+
+static inline uint32_t __SHSUB16(const uint32_t a, const uint32_t b) {
+	using namespace host_simd;
+	return pack((lo(a) - lo(b)) >> 1, (hi(a) - hi(b)) >> 1);
+}
+
+static inline uint32_t __SHASX(const uint32_t a, const uint32_t b) {
+	using namespace host_simd;
+	return pack((lo(a) - hi(b)) >> 1, (hi(a) + lo(b)) >> 1);
+}
+
+static inline uint32_t __SHSAX(const uint32_t a, const uint32_t b) {
+	using namespace host_simd;
+	return pack((lo(a) + hi(b)) >> 1, (hi(a) - lo(b)) >> 1);
+}
+
+static inline int32_t __SMUAD(const uint32_t a, const uint32_t b) {
+	using namespace host_simd;
+	return static_cast<int32_t>(uint32_t(lo(a) * lo(b)) + uint32_t(hi(a) * hi(b)));
+}
+
+static inline int32_t __SMUADX(const uint32_t a, const uint32_t b) {
+	using namespace host_simd;
+	return static_cast<int32_t>(uint32_t(lo(a) * hi(b)) + uint32_t(hi(a) * lo(b)));
+}
+
+static inline int32_t __SMUSD(const uint32_t a, const uint32_t b) {
+	using namespace host_simd;
+	return lo(a) * lo(b) - hi(a) * hi(b);
+}
+
+static inline int32_t __SMUSDX(const uint32_t a, const uint32_t b) {
+	using namespace host_simd;
+	return lo(a) * hi(b) - hi(a) * lo(b);
+}
+
+static inline int32_t __SMLAD(const uint32_t a, const uint32_t b, const int32_t acc) {
+	return static_cast<int32_t>(uint32_t(acc) + uint32_t(__SMUAD(a, b)));
+}
+
+static inline int32_t __SMLADX(const uint32_t a, const uint32_t b, const int32_t acc) {
+	return static_cast<int32_t>(uint32_t(acc) + uint32_t(__SMUADX(a, b)));
+}
+
+static inline int32_t __SMLSD(const uint32_t a, const uint32_t b, const int32_t acc) {
+	return static_cast<int32_t>(uint32_t(acc) + uint32_t(__SMUSD(a, b)));
+}
+
+static inline int32_t __SMLSDX(const uint32_t a, const uint32_t b, const int32_t acc) {
+	return static_cast<int32_t>(uint32_t(acc) + uint32_t(__SMUSDX(a, b)));
+}
+
+static inline int64_t __SMLALD(const uint32_t a, const uint32_t b, const int64_t acc) {
+	using namespace host_simd;
+	return acc + int64_t(lo(a)) * lo(b) + int64_t(hi(a)) * hi(b);
+}
+
+static inline int64_t __SMLALDX(const uint32_t a, const uint32_t b, const int64_t acc) {
+	using namespace host_simd;
+	return acc + int64_t(lo(a)) * hi(b) + int64_t(hi(a)) * lo(b);
+}
+
+static inline int64_t __SMLSLD(const uint32_t a, const uint32_t b, const int64_t acc) {
+	using namespace host_simd;
+	return acc + int64_t(lo(a)) * lo(b) - int64_t(hi(a)) * hi(b);
+}
+
+static inline int64_t __SMLSLDX(const uint32_t a, const uint32_t b, const int64_t acc) {
+	using namespace host_simd;
+	return acc + int64_t(lo(a)) * hi(b) - int64_t(hi(a)) * lo(b);
+}
+
+static inline int64_t __SMULL(const int32_t a, const int32_t b) {
+	return int64_t(a) * b;
+}
+
+static inline int64_t __SMLAL(const int32_t a, const int32_t b, const int64_t acc) {
+	return acc + int64_t(a) * b;
+}
+
+static inline int32_t __SMULBB(const uint32_t a, const uint32_t b) { return host_simd::lo(a) * host_simd::lo(b); }
+static inline int32_t __SMULBT(const uint32_t a, const uint32_t b) { return host_simd::lo(a) * host_simd::hi(b); }
+static inline int32_t __SMULTB(const uint32_t a, const uint32_t b) { return host_simd::hi(a) * host_simd::lo(b); }
+static inline int32_t __SMULTT(const uint32_t a, const uint32_t b) { return host_simd::hi(a) * host_simd::hi(b); }
+
+static inline int32_t __SMLABB(const uint32_t a, const uint32_t b, const int32_t acc) { return acc + __SMULBB(a, b); }
+static inline int32_t __SMLABT(const uint32_t a, const uint32_t b, const int32_t acc) { return acc + __SMULBT(a, b); }
+static inline int32_t __SMLATB(const uint32_t a, const uint32_t b, const int32_t acc) { return acc + __SMULTB(a, b); }
+static inline int32_t __SMLATT(const uint32_t a, const uint32_t b, const int32_t acc) { return acc + __SMULTT(a, b); }
+
+static inline int32_t __SMULWB(const int32_t a, const uint32_t b) {
+	return static_cast<int32_t>((int64_t(a) * host_simd::lo(b)) >> 16);
+}
+
+static inline int32_t __SMMUL(const int32_t a, const int32_t b) {
+	return static_cast<int32_t>((int64_t(a) * b) >> 32);
+}
+
+static inline int32_t __SMMULR(const int32_t a, const int32_t b) {
+	return static_cast<int32_t>((int64_t(a) * b + 0x80000000LL) >> 32);
+}
+
+static inline int32_t __SMMLA(const int32_t a, const int32_t b, const int32_t acc) {
+	return acc + __SMMUL(a, b);
+}
+
+static inline int32_t __SXTB16(const uint32_t x, const uint32_t rotate = 0) {
+	const uint32_t r = host_simd::ror(x, rotate);
+	return host_simd::pack(static_cast<int8_t>(r & 0xff), static_cast<int8_t>((r >> 16) & 0xff));
+}
+
+static inline int32_t __SXTH(const uint32_t x, const uint32_t rotate) {
+	return static_cast<int16_t>(host_simd::ror(x, rotate) & 0xffff);
+}
+
+static inline int32_t __SXTAH(const uint32_t acc, const uint32_t x, const uint32_t rotate) {
+	return static_cast<int32_t>(acc) + __SXTH(x, rotate);
+}
+
+static inline uint32_t __PKHBT(const uint32_t a, const uint32_t b, const uint32_t shift) {
+	return (a & 0x0000ffff) | ((b << shift) & 0xffff0000);
+}
+
+static inline uint32_t __PKHTB(const uint32_t a, const uint32_t b, const uint32_t shift) {
+	return (a & 0xffff0000) | (static_cast<uint32_t>(static_cast<int32_t>(b) >> shift) & 0x0000ffff);
+}
+
+static inline uint32_t __BFI(const uint32_t rd, const uint32_t rn, const uint32_t lsb, const uint32_t width) {
+	const uint32_t mask = ((width >= 32) ? 0xffffffffU : ((1U << width) - 1)) << lsb;
+	return (rd & ~mask) | ((rn << lsb) & mask);
+}
+
+static inline uint32_t __REV(const uint32_t x) {
+	return __builtin_bswap32(x);
+}
+
+static inline uint32_t __REV16(const uint32_t x) {
+	return ((x & 0xff00ff00U) >> 8) | ((x & 0x00ff00ffU) << 8);
+}
+
+static inline uint32_t __RBIT(uint32_t x) {
+	x = ((x >> 1) & 0x55555555U) | ((x & 0x55555555U) << 1);
+	x = ((x >> 2) & 0x33333333U) | ((x & 0x33333333U) << 2);
+	x = ((x >> 4) & 0x0f0f0f0fU) | ((x & 0x0f0f0f0fU) << 4);
+	return __builtin_bswap32(x);
+}
+
+static inline uint8_t __CLZ(const uint32_t x) {
+	return x ? __builtin_clz(x) : 32;
+}
+
+#endif/*__HOST_HAL_H__*/
@@ -0,0 +1,76 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host stand-in for the LPC43xx register wrappers used by baseband code. */
+
+#ifndef __HOST_LPC43XX_CPP_H__
+#define __HOST_LPC43XX_CPP_H__
+
+#include <cstdint>
+
+#include <hal.h>
+
+#include "utility.hpp"
+
+namespace lpc43xx {
+
+namespace m4 {
+
+static inline bool flag_saturation() {
+	return false;
+}
+
+static inline void clear_flag_saturation() {
+}
+
+} /* namespace m4 */
+
+namespace creg {
+
+namespace m4txevent {
+
+static inline void enable() { }
+static inline void disable() { }
+static inline void assert_event() { }
+static inline void clear() { }
+
+} /* namespace m4txevent */
+
+namespace m0apptxevent {
+
+static inline void enable() { }
+static inline void disable() { }
+static inline void assert_event() { }
+static inline void clear() { }
+
+} /* namespace m0apptxevent */
+
+} /* namespace creg */
+
+namespace rtc {
+
+/* Only held by UI widgets, which the host build never draws. */
+struct RTC {
+};
+
+} /* namespace rtc */
+
+} /* namespace lpc43xx */
+
+#endif/*__HOST_LPC43XX_CPP_H__*/
@@ -0,0 +1,121 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host stand-ins for the hardware-facing parts of the baseband runtime.
+ * Processors are constructed exactly as on the M4, but their baseband and
+ * RSSI threads never start: the benchmark calls execute() directly.
+ */
+
+#include "host_stubs.hpp"
+
+#include "baseband_thread.hpp"
+#include "rssi_thread.hpp"
+#include "event_m4.hpp"
+#include "audio_dma.hpp"
+#include "message_queue.hpp"
+#include "portapack_shared_memory.hpp"
+
+#include <array>
+
+Thread* BasebandThread::thread = nullptr;
+
+BasebandThread::BasebandThread(
+	uint32_t sampling_rate,
+	BasebandProcessor* const baseband_processor,
+	const tprio_t,
+	baseband::Direction direction
+) : baseband_processor { baseband_processor },
+	_direction { direction },
+	sampling_rate { sampling_rate }
+{
+}
+
+BasebandThread::~BasebandThread() {
+}
+
+void BasebandThread::set_sampling_rate(uint32_t new_sampling_rate) {
+	sampling_rate = new_sampling_rate;
+}
+
+void BasebandThread::run() {
+}
+
+Thread* RSSIThread::thread = nullptr;
+
+RSSIThread::RSSIThread(const tprio_t) {
+}
+
+RSSIThread::~RSSIThread() {
+}
+
+void RSSIThread::run() {
+}
+
+Thread* EventDispatcher::thread_event_loop = nullptr;
+
+EventDispatcher::EventDispatcher(
+	std::unique_ptr<BasebandProcessor> baseband_processor
+) : baseband_processor { std::move(baseband_processor) }
+{
+}
+
+void EventDispatcher::run() {
+}
+
+namespace audio {
+namespace dma {
+
+constexpr size_t transfer_samples = 32;
+
+static std::array<sample_t, transfer_samples> buffer_tx;
+static std::array<sample_t, transfer_samples> buffer_rx;
+
+buffer_t tx_empty_buffer() {
+	return { buffer_tx.data(), buffer_tx.size() };
+}
+
+buffer_t rx_empty_buffer() {
+	return { buffer_rx.data(), buffer_rx.size() };
+}
+
+} /* namespace dma */
+} /* namespace audio */
+
+void MessageQueue::signal() {
+}
+
+void MessageMailbox::signal() {
+}
+
+Timestamp Timestamp::now() {
+	return { };
+}
+
+static SharedMemory host_shared_memory;
+SharedMemory& shared_memory = host_shared_memory;
+
+namespace host {
+
+void drain_application_queue() {
+	shared_memory.application_queue.reset();
+	shared_memory.app_local_queue.reset();
+	shared_memory.application_mailbox.reset();
+}
+
+} /* namespace host */
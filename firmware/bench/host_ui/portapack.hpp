@@ -0,0 +1,30 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host stand-in for the application's portapack.hpp. The UI headers only
+ * need the lpc43xx namespace from it.
+ */
+
+#ifndef __HOST_PORTAPACK_H__
+#define __HOST_PORTAPACK_H__
+
+#include "lpc43xx_cpp.hpp"
+using namespace lpc43xx;
+
+#endif/*__HOST_PORTAPACK_H__*/
@@ -161,6 +161,18 @@ __attribute__( ( always_inline ) ) __STATIC_INLINE int32_t __SMLABB(uint32_t rm,
   return rd;
 }
 
+__attribute__( ( always_inline ) ) __STATIC_INLINE int32_t __SMLABT(uint32_t rm, uint32_t rs, uint32_t rn) {
+  int32_t rd;
+  __ASM volatile("smlabt %0, %1, %2, %3" : "=r" (rd) : "r" (rm), "r" (rs), "r" (rn));
+  return rd;
+}
+
+__attribute__( ( always_inline ) ) __STATIC_INLINE int32_t __SMLATT(uint32_t rm, uint32_t rs, uint32_t rn) {
+  int32_t rd;
+  __ASM volatile("smlatt %0, %1, %2, %3" : "=r" (rd) : "r" (rm), "r" (rs), "r" (rn));
+  return rd;
+}
+
 __attribute__( ( always_inline ) ) __STATIC_INLINE int32_t __SXTAH(uint32_t rn, uint32_t rm, uint32_t ror) {
   int32_t rd;
   __ASM volatile("sxtah %0, %1, %2, ror %3" : "=r" (rd) : "r" (rn), "r" (rm), "I" (ror));
@@ -101,7 +101,7 @@ std::string Packet::raw_content() const {
 
 bool Packet::crc_ok() const {
 	CRCReader field_crc { packet_ };
-	CRC<16> acars_fcs { 0x1021, 0x0000, 0x0000 };
+	TableCRC<16, 0x1021> acars_fcs { 0x0000, 0x0000 };
 	
 	for(size_t i=0; i<data_length(); i+=8) {
 		acars_fcs.process_byte(field_crc.read(i, 8));
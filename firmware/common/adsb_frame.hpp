@@ -23,9 +23,12 @@
 #ifndef __ADSB_FRAME_H__
 #define __ADSB_FRAME_H__
 
+#include <cstdint>
 #include <cstring>
 #include <string>
 
+#include "crc.hpp"
+
 namespace adsb {
 
 alignas(4) const uint8_t adsb_preamble[16] = { 1, 0, 1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0 };
@@ -94,35 +97,33 @@ public:
 	bool empty() {
 		return (index == 0);
 	}
+
+	/* Remainder of the whole 112-bit frame by the generator, zero for an
+	 * error-free DF17/DF18 frame. Errors add their own remainders, so a
+	 * single bit error's syndrome depends only on its position.
+	 */
+	uint32_t syndrome() const {
+		crc_t crc { };
+		crc.process_bytes(raw_data, 14);
+		return crc.checksum();
+	}
+
+	void flip_bit(const size_t n) {
+		raw_data[n >> 3] ^= (0x80 >> (n & 7));
+	}
 	
 private:
 	static const uint8_t adsb_preamble[16];
 	static const char icao_id_lut[65];
+	using crc_t = TableCRC<24, 0xFFF409>;	// 0x1FFF409 less x^24
 	alignas(4) uint8_t index { 0 };
 	alignas(4) uint8_t raw_data[14] { };	// 112 bits at most
 	uint32_t rx_timestamp { };
 
-	uint32_t compute_CRC() {
-		uint8_t adsb_crc[14] = { 0 };	// Temp buffer
-		uint8_t b, c, s, bitn;
-		const uint32_t crc_poly = 0x1205FFF;
-		
-		// Copy frame data
-		memcpy(adsb_crc, raw_data, 11);
-		
-		// Compute CRC
-		for (c = 0; c < 11; c++) {
-			for (b = 0; b < 8; b++) {
-				if ((adsb_crc[c] << b) & 0x80) {
-					for (s = 0; s < 25; s++) {
-						bitn = (c * 8) + b + s;
-						if ((crc_poly >> s) & 1) adsb_crc[bitn >> 3] ^= (0x80 >> (bitn & 7));
-					}
-				}
-			}
-		}
-		
-		return (adsb_crc[11] << 16) + (adsb_crc[12] << 8) + adsb_crc[13];
+	uint32_t compute_CRC() const {
+		crc_t crc { };
+		crc.process_bytes(raw_data, 11);
+		return crc.checksum();
 	}
 };
 
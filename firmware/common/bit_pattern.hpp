@@ -39,35 +39,48 @@ private:
 	uint64_t history { 0 };
 };
 
-class BitPattern {
+/* Matches the most recent bits of a BitHistory against a code, allowing up
+ * to maximum_hanning_distance bit errors. Codes of up to 32 bits should use
+ * BitPattern32, which compares only the low word of the history.
+ */
+template<typename T>
+class BasicBitPattern {
 public:
-	constexpr BitPattern(
+	constexpr BasicBitPattern(
 	) : code_ { 0 },
 		mask_ { 0 },
 		maximum_hanning_distance_ { 0 }
 	{
 	}
 	
-	constexpr BitPattern(
-		const uint64_t code,
+	constexpr BasicBitPattern(
+		const T code,
 		const size_t code_length,
 		const size_t maximum_hanning_distance = 0
 	) : code_ { code },
-		mask_ { (1ULL << code_length) - 1ULL },
+		mask_ { static_cast<T>((1ULL << code_length) - 1ULL) },
 		maximum_hanning_distance_ { maximum_hanning_distance }
 	{
 	}
 
 	bool operator()(const BitHistory& history, const size_t) const {
-		const auto delta_bits = (history.value() ^ code_) & mask_;
-		const size_t count = __builtin_popcountll(delta_bits);
-		return (count <= maximum_hanning_distance_);
+		auto delta_bits = (static_cast<T>(history.value()) ^ code_) & mask_;
+		/* Clear one differing bit per allowed error: cheaper than a popcount,
+		 * which the M4 doesn't have and GCC makes a libgcc call of.
+		 */
+		for(size_t i=0; i<maximum_hanning_distance_; i++) {
+			delta_bits &= delta_bits - 1;
+		}
+		return (delta_bits == 0);
 	}
 
 private:
-	uint64_t code_;
-	uint64_t mask_;
+	T code_;
+	T mask_;
 	size_t maximum_hanning_distance_;
 };
 
+using BitPattern = BasicBitPattern<uint64_t>;
+using BitPattern32 = BasicBitPattern<uint32_t>;
+
 #endif/*__BIT_PATTERN_H__*/
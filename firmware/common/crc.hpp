@@ -153,16 +153,168 @@ private:
 	}
 };
 
+/* Table-driven CRC, for a polynomial known at compile time. The tables are
+ * generated by the compiler. Bytes are processed with one lookup each, or,
+ * with Slices = 4, aligned 32-bit words with four lookups into 4x the
+ * table ("slice-by-4"). Checksums match CRC<Width, RevIn, RevOut> with the
+ * same parameters. Use CRC where input isn't whole bytes.
+ *
+ * Tables are 1kB per slice, mind the M4's code space.
+ */
+template<size_t Width, uint32_t TruncatedPolynomial, bool RevIn = false, bool RevOut = false, size_t Slices = 1>
+class TableCRC {
+public:
+	using value_type = uint32_t;
+
+	static_assert((Width >= 8) && (Width <= 32), "TableCRC width must be 8 to 32 bits");
+	static_assert((Slices == 1) || (Slices == 4), "TableCRC supports 1 or 4 slices");
+
+	constexpr TableCRC(
+		const value_type initial_remainder = 0,
+		const value_type final_xor_value = 0
+	) : initial_remainder { initial_remainder },
+		final_xor_value { final_xor_value },
+		remainder { to_register(initial_remainder) }
+	{
+	}
+
+	value_type get_initial_remainder() const {
+		return initial_remainder;
+	}
+
+	void reset(value_type new_initial_remainder) {
+		remainder = to_register(new_initial_remainder);
+	}
+
+	void reset() {
+		remainder = to_register(initial_remainder);
+	}
+
+	void process_byte(const uint8_t byte) {
+		if( RevIn ) {
+			remainder = (remainder >> 8) ^ table[0][(remainder ^ byte) & 0xff];
+		} else {
+			remainder = (remainder << 8) ^ table[0][(remainder >> 24) ^ byte];
+		}
+	}
+
+	void process_bytes(const void* const data, const size_t length) {
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+		const uint8_t* const end = p + length;
+
+		if constexpr( Slices == 4 ) {
+			while( (p < end) && (reinterpret_cast<uintptr_t>(p) & 3) ) {
+				process_byte(*(p++));
+			}
+			for(; (end - p) >= 4; p+=4) {
+				process_word(*reinterpret_cast<const uint32_t*>(p));
+			}
+		}
+
+		while( p < end ) {
+			process_byte(*(p++));
+		}
+	}
+
+	template<size_t N>
+	void process_bytes(const std::array<uint8_t, N>& data) {
+		process_bytes(data.data(), data.size());
+	}
+
+	value_type checksum() const {
+		// The register holds the remainder reflected for RevIn, and shifted
+		// to the top of the word otherwise.
+		const value_type r = RevIn ? remainder : (remainder >> (32 - Width));
+		return (((RevIn != RevOut) ? reflect(r) : r) ^ final_xor_value) & mask();
+	}
+
+private:
+	using table_t = std::array<std::array<value_type, 256>, Slices>;
+
+	const value_type initial_remainder;
+	const value_type final_xor_value;
+	value_type remainder;
+
+	static constexpr value_type mask() {
+		return (Width == 32) ? 0xffffffffU : ((1U << (Width % 32)) - 1);
+	}
+
+	static constexpr value_type reflect(value_type x) {
+		value_type reflection = 0;
+		for(size_t i=0; i<Width; ++i) {
+			reflection = (reflection << 1) | (x & 1);
+			x >>= 1;
+		}
+		return reflection;
+	}
+
+	static constexpr value_type to_register(const value_type value) {
+		return RevIn ? reflect(value & mask()) : ((value & mask()) << (32 - Width));
+	}
+
+	static constexpr table_t make_table() {
+		table_t t { };
+
+		const value_type polynomial = RevIn ? reflect(TruncatedPolynomial) : (TruncatedPolynomial << (32 - Width));
+		for(size_t i=0; i<256; i++) {
+			value_type r = RevIn ? i : (i << 24);
+			for(size_t b=0; b<8; b++) {
+				if( RevIn ) {
+					r = (r & 1) ? ((r >> 1) ^ polynomial) : (r >> 1);
+				} else {
+					r = (r & 0x80000000U) ? ((r << 1) ^ polynomial) : (r << 1);
+				}
+			}
+			t[0][i] = r;
+		}
+
+		// Slice n is slice n-1 followed by a zero byte.
+		for(size_t n=1; n<Slices; n++) {
+			for(size_t i=0; i<256; i++) {
+				const auto r = t[n - 1][i];
+				t[n][i] = RevIn ? ((r >> 8) ^ t[0][r & 0xff]) : ((r << 8) ^ t[0][r >> 24]);
+			}
+		}
+
+		return t;
+	}
+
+	static constexpr table_t table = make_table();
+
+	/* Four bytes, in memory order, little-endian load. */
+	void process_word(const uint32_t word) {
+		if( RevIn ) {
+			const auto r = remainder ^ word;
+			remainder = table[3][r & 0xff] ^ table[2][(r >> 8) & 0xff]
+			          ^ table[1][(r >> 16) & 0xff] ^ table[0][r >> 24];
+		} else {
+			const auto r = remainder ^ __builtin_bswap32(word);
+			remainder = table[3][r >> 24] ^ table[2][(r >> 16) & 0xff]
+			          ^ table[1][(r >> 8) & 0xff] ^ table[0][r & 0xff];
+		}
+	}
+};
+
 class Adler32 {
 public:
 	void feed(const uint8_t v) {
 		feed_one(v);
 	}
 
+	/* The modulo is deferred for as many bytes as can't overflow b. */
 	void feed(const void* const data, const size_t n) {
-		const uint8_t* const p = reinterpret_cast<const uint8_t*>(data);
-		for(size_t i=0; i<n; i++) {
-			feed_one(p[i]);
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+		size_t remaining = n;
+		while( remaining ) {
+			const size_t block = (remaining < nmax) ? remaining : nmax;
+			for(size_t i=0; i<block; i++) {
+				a += p[i];
+				b += a;
+			}
+			a %= mod;
+			b %= mod;
+			p += block;
+			remaining -= block;
 		}
 	}
 
@@ -182,6 +334,7 @@ public:
 
 private:
 	static constexpr uint32_t mod = 65521;
+	static constexpr size_t nmax = 5552;
 
 	uint32_t a { 1 };
 	uint32_t b { 0 };
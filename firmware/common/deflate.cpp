@@ -0,0 +1,246 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "deflate.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint16_t reverse_bits(uint16_t code, size_t length) {
+	uint16_t result = 0;
+	for(size_t i=0; i<length; i++) {
+		result = (result << 1) | (code & 1);
+		code >>= 1;
+	}
+	return result;
+}
+
+/* RFC 1951 3.2.6: fixed literal/length code lengths. */
+constexpr size_t symbol_length(const size_t symbol) {
+	return (symbol < 144) ? 8 : ((symbol < 256) ? 9 : ((symbol < 280) ? 7 : 8));
+}
+
+constexpr uint16_t symbol_code(const size_t symbol) {
+	return (symbol < 144) ? (0x030 + symbol) :
+		((symbol < 256) ? (0x190 + symbol - 144) :
+		((symbol < 280) ? (symbol - 256) : (0x0c0 + symbol - 280)));
+}
+
+/* Huffman codes are packed MSB first, the rest of the stream LSB first. */
+struct FixedCodes {
+	uint16_t symbol[288];
+	uint8_t distance[30];
+};
+
+constexpr FixedCodes make_fixed_codes() {
+	FixedCodes codes { };
+	for(size_t i=0; i<288; i++) {
+		codes.symbol[i] = reverse_bits(symbol_code(i), symbol_length(i));
+	}
+	for(size_t i=0; i<30; i++) {
+		codes.distance[i] = reverse_bits(i, 5);
+	}
+	return codes;
+}
+
+constexpr FixedCodes fixed_codes = make_fixed_codes();
+
+constexpr uint16_t length_base[29] {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+constexpr uint8_t length_extra[29] {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+constexpr uint16_t distance_base[30] {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+constexpr uint8_t distance_extra[30] {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+} /* namespace */
+
+Deflate::Deflate(
+	Sink sink
+) : sink { std::move(sink) }
+{
+	head.fill(position_none);
+
+	// BFINAL=1, BTYPE=01 (fixed Huffman codes).
+	put_bits(0b011, 3);
+}
+
+void Deflate::feed(const void* const data, const size_t count) {
+	auto p = reinterpret_cast<const uint8_t*>(data);
+	size_t remaining = count;
+
+	while( remaining ) {
+		if( end == window.size() ) {
+			compress(match_max);
+			slide();
+		}
+
+		const size_t n = std::min(remaining, window.size() - end);
+		memcpy(&window[end], p, n);
+		end += n;
+		p += n;
+		remaining -= n;
+	}
+}
+
+void Deflate::finish() {
+	compress(0);
+	put_symbol(256);	// End of block
+	flush_bits();
+	flush_out();
+}
+
+/* Encode until only `lookahead` bytes are left, so matches near the end of
+ * the buffer aren't cut short by data that hasn't arrived yet.
+ */
+void Deflate::compress(const size_t lookahead) {
+	while( (end - position) > lookahead ) {
+		const size_t limit = std::min(match_max, end - position);
+
+		size_t best_length = 0;
+		size_t best_distance = 0;
+		if( limit >= match_min ) {
+			auto try_candidate = [&](const size_t candidate) {
+				const size_t length = match_length(candidate, limit);
+				if( length > best_length ) {
+					best_length = length;
+					best_distance = position - candidate;
+				}
+			};
+
+			if( position >= 1 ) {
+				try_candidate(position - 1);
+			}
+			if( position >= 3 ) {
+				try_candidate(position - 3);
+			}
+
+			const size_t h = hash(position);
+			const size_t candidate = head[h];
+			head[h] = position;
+			if( (candidate != position_none) && (best_length < limit) ) {
+				try_candidate(candidate);
+			}
+		}
+
+		if( best_length >= match_min ) {
+			put_match(best_length, best_distance);
+			for(size_t p=position+1; (p<position+best_length) && (p+match_min<=end); p++) {
+				head[hash(p)] = p;
+			}
+			position += best_length;
+		} else {
+			put_literal(window[position]);
+			position++;
+		}
+	}
+}
+
+void Deflate::slide() {
+	if( position < window_size ) {
+		return;
+	}
+
+	memmove(&window[0], &window[window_size], end - window_size);
+	position -= window_size;
+	end -= window_size;
+
+	for(auto& p : head) {
+		p = ((p == position_none) || (p < window_size)) ? position_none : (p - window_size);
+	}
+}
+
+size_t Deflate::hash(const size_t p) const {
+	const uint32_t v = window[p] | (window[p + 1] << 8) | (window[p + 2] << 16);
+	return (v * 2654435761U) >> (32 - hash_bits);
+}
+
+size_t Deflate::match_length(const size_t candidate, const size_t limit) const {
+	const uint8_t* const a = &window[candidate];
+	const uint8_t* const b = &window[position];
+	size_t length = 0;
+	while( (length < limit) && (a[length] == b[length]) ) {
+		length++;
+	}
+	return length;
+}
+
+void Deflate::put_literal(const uint8_t value) {
+	put_symbol(value);
+}
+
+void Deflate::put_match(const size_t length, const size_t distance) {
+	size_t l = 28;
+	while( length_base[l] > length ) {
+		l--;
+	}
+	put_symbol(257 + l);
+	put_bits(length - length_base[l], length_extra[l]);
+
+	size_t d = 29;
+	while( distance_base[d] > distance ) {
+		d--;
+	}
+	put_bits(fixed_codes.distance[d], 5);
+	put_bits(distance - distance_base[d], distance_extra[d]);
+}
+
+void Deflate::put_symbol(const size_t symbol) {
+	put_bits(fixed_codes.symbol[symbol], symbol_length(symbol));
+}
+
+void Deflate::put_bits(const uint32_t value, const size_t count) {
+	bit_buffer |= value << bit_count;
+	bit_count += count;
+	while( bit_count >= 8 ) {
+		out[out_count++] = bit_buffer & 0xff;
+		bit_buffer >>= 8;
+		bit_count -= 8;
+		if( out_count == out.size() ) {
+			flush_out();
+		}
+	}
+}
+
+void Deflate::flush_bits() {
+	if( bit_count ) {
+		put_bits(0, 8 - bit_count);
+	}
+}
+
+void Deflate::flush_out() {
+	if( out_count ) {
+		sink(out.data(), out_count);
+		out_count = 0;
+	}
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DEFLATE_H__
+#define __DEFLATE_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <functional>
+
+/* Streaming raw DEFLATE (RFC 1951) encoder: one fixed-Huffman block, LZ77
+ * over a small sliding window. Sized for the M0: a 2KB window buffer and
+ * a 512-entry hash table of most recent positions, no hash chains. Besides
+ * the hash candidate, distances 1 and 3 (a repeated byte or RGB pixel) are
+ * always tried, which is what filtered image rows mostly consist of.
+ */
+class Deflate {
+public:
+	using Sink = std::function<void(const uint8_t* const data, const size_t count)>;
+
+	explicit Deflate(Sink sink);
+
+	Deflate(const Deflate&) = delete;
+	Deflate& operator=(const Deflate&) = delete;
+
+	void feed(const void* const data, const size_t count);
+
+	/* Encodes what's left, ends the block and pads to a byte boundary. */
+	void finish();
+
+private:
+	static constexpr size_t window_size = 1024;
+	static constexpr size_t hash_bits = 9;
+	static constexpr size_t match_min = 3;
+	static constexpr size_t match_max = 258;
+	static constexpr uint16_t position_none = 0xffff;
+
+	Sink sink;
+
+	std::array<uint8_t, window_size * 2> window { };
+	std::array<uint16_t, 1 << hash_bits> head { };
+	size_t position { 0 };
+	size_t end { 0 };
+
+	uint32_t bit_buffer { 0 };
+	size_t bit_count { 0 };
+	std::array<uint8_t, 64> out { };
+	size_t out_count { 0 };
+
+	void compress(const size_t lookahead);
+	void slide();
+
+	size_t hash(const size_t p) const;
+	size_t match_length(const size_t candidate, const size_t limit) const;
+
+	void put_literal(const uint8_t value);
+	void put_match(const size_t length, const size_t distance);
+	void put_symbol(const size_t symbol);
+	void put_bits(const uint32_t value, const size_t count);
+	void flush_bits();
+	void flush_out();
+};
+
+#endif/*__DEFLATE_H__*/
@@ -96,6 +96,35 @@ void fft_swap_in_place(std::array<T, N>& data) {
 	}
 }
 
+/* Compile-time trigonometry for generating twiddle tables. Only evaluated by
+ * the compiler, so accuracy matters more than speed. Valid for |x| <= pi/2.
+ */
+namespace fft_constexpr {
+
+constexpr double pi = 3.14159265358979323846;
+
+constexpr double sin(const double x) {
+	double term = x;
+	double sum = x;
+	for(int n=1; n<14; n++) {
+		term *= -x * x / ((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return sum;
+}
+
+constexpr double cos(const double x) {
+	double term = 1.0;
+	double sum = 1.0;
+	for(int n=1; n<14; n++) {
+		term *= -x * x / ((2 * n - 1) * (2 * n));
+		sum += term;
+	}
+	return sum;
+}
+
+} /* namespace fft_constexpr */
+
 /* http://beige.ucs.indiana.edu/B673/node14.html */
 /* http://www.drdobbs.com/cpp/a-simple-and-efficient-fft-implementatio/199500857?pgno=3 */
 
@@ -105,18 +134,22 @@ void fft_c_preswapped(std::array<T, N>& data, const size_t from, const size_t to
 	constexpr auto K = log_2(N);
 	if ((to > K) || (from > K)) return;
 
-	constexpr size_t K_max = 8;
-	static_assert(K <= K_max, "No FFT twiddle factors for K > 8");
-	static constexpr std::array<std::complex<float>, K_max> wp_table { {
-		{ -2.0f,                        0.0f                     },	// 2
-		{ -1.0f,                       -1.0f                     },	// 4
-		{ -0.2928932188134524756f,     -0.7071067811865475244f   },	// 8
-		{ -0.076120467488713243872f,   -0.38268343236508977173f  },	// 16
-		{ -0.019214719596769550874f,   -0.19509032201612826785f  },	// 32
-		{ -0.0048152733278031137552f,  -0.098017140329560601994f },	// 64
-		{ -0.0012045437948276072852f,  -0.049067674327418014255f },	// 128
-		{ -0.00030118130379577988423f, -0.024541228522912288032f },	// 256
-	} };
+	/* Twiddle recurrence step for stage k: { cos(pi/2^k) - 1, -sin(pi/2^k) } */
+	constexpr size_t K_max = 11;
+	static_assert(K <= K_max, "No FFT twiddle factors for K > 11");
+	static constexpr std::array<std::complex<float>, K_max> wp_table = []() {
+		std::array<std::complex<float>, K_max> table { { { -2.0f, 0.0f } } };
+		double x = fft_constexpr::pi / 2;
+		for(size_t k=1; k<K_max; k++) {
+			const double s = fft_constexpr::sin(x / 2);
+			table[k] = {
+				static_cast<float>(-2.0 * s * s),
+				static_cast<float>(-2.0 * s * fft_constexpr::cos(x / 2))
+			};
+			x /= 2;
+		}
+		return table;
+	}();
 
 	/* Provide data to this function, pre-swapped. */
 	for(size_t k = from; k < to; k++) {
@@ -135,4 +168,153 @@ void fft_c_preswapped(std::array<T, N>& data, const size_t from, const size_t to
 	}
 }
 
+/* Quarter-wave sine table, sin(2*pi*i/N) for i in [0, N/4], in Q15. */
+template<size_t N>
+struct FFTSineTable {
+	static constexpr size_t quarter = N / 4;
+
+	static constexpr std::array<int16_t, quarter + 1> values = []() {
+		std::array<int16_t, quarter + 1> table { };
+		for(size_t i=0; i<=quarter; i++) {
+			const double v = fft_constexpr::sin(2.0 * fft_constexpr::pi * i / N);
+			table[i] = static_cast<int16_t>(v * 32767.0 + 0.5);
+		}
+		return table;
+	}();
+
+	/* cos(2*pi*t/N) in Q15, for any t. */
+	static int32_t cos(size_t t) {
+		t &= N - 1;
+		if( t > N / 2 ) {
+			t = N - t;
+		}
+		return (t <= quarter) ? values[quarter - t] : -values[t - quarter];
+	}
+
+	/* W_N^t = cos(2*pi*t/N) - j*sin(2*pi*t/N) for t in [0, 3N/4), packed as
+	 * complex16_t (real in the low halfword) for the dual 16-bit MAC.
+	 */
+	static uint32_t twiddle(const size_t t) {
+		const size_t q = t / quarter;
+		const size_t r = t % quarter;
+		const int32_t s = values[r];
+		const int32_t c = values[quarter - r];
+		switch(q) {
+		case 0:		return __PKHBT(c, -s, 16);
+		case 1:		return __PKHBT(-s, -c, 16);
+		default:	return __PKHBT(-c, s, 16);
+		}
+	}
+};
+
+/* Q15 complex multiply, rounded: x * w. */
+static inline uint32_t fft_c16_mul(const uint32_t x, const uint32_t w) {
+	const int32_t re = __SMLSD(x, w, 0x4000);
+	const int32_t im = __SMLADX(x, w, 0x4000);
+	return __PKHBT(re >> 15, im, 1);
+}
+
+/* Radix-4 butterfly on d[0], d[h], d[2h], d[3h], with the last three
+ * already multiplied by their twiddles. Scales by 1/4.
+ */
+static inline void fft_c16_butterfly4(
+	uint32_t* const d,
+	const size_t h,
+	const uint32_t b,
+	const uint32_t c,
+	const uint32_t e
+) {
+	const uint32_t a = d[0];
+
+	const uint32_t s0 = __SHADD16(a, b);
+	const uint32_t s1 = __SHSUB16(a, b);
+	const uint32_t s2 = __SHADD16(c, e);
+	const uint32_t s3 = __SHSUB16(c, e);
+
+	d[h * 0] = __SHADD16(s0, s2);
+	d[h * 1] = __SHSAX(s1, s3);		/* (s1 - j*s3) / 2 */
+	d[h * 2] = __SHSUB16(s0, s2);
+	d[h * 3] = __SHASX(s1, s3);		/* (s1 + j*s3) / 2 */
+}
+
+/* In-place fixed-point complex FFT on bit-reverse-ordered (fft_swap) data.
+ * Radix-2^2 decimation in time: each pass does two radix-2 stages as one
+ * radix-4 butterfly (three twiddle multiplies per four points) using the
+ * dual 16-bit SIMD instructions. A leading radix-2 pass handles odd log2(N).
+ *
+ * The input is first normalized to use the available headroom, then every
+ * radix-2 stage halves, so the result can't overflow. Returns the block
+ * exponent e such that DFT(input) = data * 2^e.
+ *
+ * Up to 1024 points, which costs about a fifth of a 20Msps buffer's cycles,
+ * so it fits only where the transform runs every few buffers. 2048 would
+ * take more than half.
+ */
+template<size_t N>
+int fft_c16_preswapped(std::array<complex16_t, N>& data) {
+	static_assert(power_of_two(N) && (N >= 16) && (N <= 1024), "only defined for N == power of two in [16, 1024]");
+	constexpr auto K = log_2(N);
+
+	uint32_t* const d = reinterpret_cast<uint32_t*>(data.data());
+
+	/* Normalize so the peak component magnitude is in [2^13, 2^14). */
+	uint32_t peak = 0;
+	for(size_t i=0; i<N; i++) {
+		const int32_t re = data[i].real();
+		const int32_t im = data[i].imag();
+		peak |= (re ^ (re >> 31)) | (im ^ (im >> 31));
+	}
+	const int shift = (peak == 0) ? 0 : (static_cast<int>(__CLZ(peak)) - 18);
+	if( shift > 0 ) {
+		for(size_t i=0; i<N; i++) {
+			/* Halves shifted apart, so a negative real's sign bits stay out
+			 * of the imaginary.
+			 */
+			const uint32_t v = d[i];
+			d[i] = ((v & 0xffff0000) << shift) | ((v << shift) & 0x0000ffff);
+		}
+	} else if( shift < 0 ) {
+		for(size_t i=0; i<N; i++) {
+			d[i] = __SHADD16(d[i], 0);
+		}
+	}
+
+	size_t h = 1;
+	if( K & 1 ) {
+		for(size_t i=0; i<N; i+=2) {
+			const uint32_t a = d[i + 0];
+			const uint32_t b = d[i + 1];
+			d[i + 0] = __SHADD16(a, b);
+			d[i + 1] = __SHSUB16(a, b);
+		}
+		h = 2;
+	}
+
+	for(; h<N; h*=4) {
+		const size_t span = h * 4;
+		const size_t t_step = N / span;
+
+		/* j == 0: all twiddles are 1. */
+		for(size_t i=0; i<N; i+=span) {
+			fft_c16_butterfly4(&d[i], h, d[i + h * 1], d[i + h * 2], d[i + h * 3]);
+		}
+
+		for(size_t j=1; j<h; j++) {
+			const size_t t = j * t_step;
+			const uint32_t w1 = FFTSineTable<N>::twiddle(t * 1);
+			const uint32_t w2 = FFTSineTable<N>::twiddle(t * 2);
+			const uint32_t w3 = FFTSineTable<N>::twiddle(t * 3);
+			for(size_t i=j; i<N; i+=span) {
+				fft_c16_butterfly4(&d[i], h,
+					fft_c16_mul(d[i + h * 1], w2),
+					fft_c16_mul(d[i + h * 2], w1),
+					fft_c16_mul(d[i + h * 3], w3)
+				);
+			}
+		}
+	}
+
+	return static_cast<int>(K) - shift;
+}
+
 #endif/*__DSP_FFT_H__*/
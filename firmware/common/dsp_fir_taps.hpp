@@ -406,4 +406,63 @@ static constexpr fir_taps_real<16> taps_200k_decim_1 = {
 	} },
 };
 
+// Channelizer filters ////////////////////////////////////////////////////
+
+// Polyphase filter bank prototype: 32 branches x 12 taps, Kaiser beta=7,
+// -6dB at half the bin spacing, pass=0.35, stop=0.7 bin spacings.
+constexpr fir_taps_real<384> taps_channelizer_32x12 {
+	.pass_frequency_normalized = 0.35f / 32.0f,
+	.stop_frequency_normalized = 0.70f / 32.0f,
+	.taps = { {
+		     0,    -2,    -3,    -5,    -6,    -9,   -11,   -14,
+		   -16,   -19,   -23,   -26,   -29,   -33,   -36,   -39,
+		   -42,   -45,   -47,   -49,   -50,   -51,   -51,   -50,
+		   -48,   -45,   -42,   -37,   -31,   -23,   -15,    -5,
+		     6,    18,    31,    45,    60,    75,    92,   109,
+		   126,   143,   160,   177,   193,   208,   222,   234,
+		   244,   253,   259,   262,   262,   259,   253,   243,
+		   229,   212,   190,   164,   135,   101,    63,    22,
+		   -23,   -71,  -122,  -175,  -230,  -287,  -344,  -402,
+		  -459,  -515,  -569,  -621,  -669,  -713,  -751,  -784,
+		  -810,  -829,  -840,  -842,  -835,  -817,  -790,  -752,
+		  -703,  -643,  -573,  -491,  -399,  -296,  -184,   -64,
+		    65,   202,   344,   491,   642,   794,   948,  1099,
+		  1248,  1392,  1530,  1659,  1777,  1883,  1975,  2051,
+		  2109,  2148,  2166,  2161,  2133,  2081,  2003,  1899,
+		  1769,  1613,  1431,  1223,   991,   735,   456,   157,
+		  -161,  -495,  -843, -1202, -1568, -1939, -2310, -2679,
+		 -3040, -3390, -3724, -4039, -4329, -4591, -4820, -5012,
+		 -5162, -5267, -5323, -5326, -5273, -5161, -4987, -4749,
+		 -4445, -4074, -3635, -3126, -2549, -1904, -1191,  -413,
+		   429,  1331,  2291,  3305,  4369,  5478,  6627,  7810,
+		  9022, 10257, 11508, 12768, 14030, 15287, 16532, 17758,
+		 18957, 20123, 21248, 22325, 23348, 24310, 25206, 26029,
+		 26775, 27438, 28015, 28501, 28894, 29191, 29390, 29490,
+		 29490, 29390, 29191, 28894, 28501, 28015, 27438, 26775,
+		 26029, 25206, 24310, 23348, 22325, 21248, 20123, 18957,
+		 17758, 16532, 15287, 14030, 12768, 11508, 10257,  9022,
+		  7810,  6627,  5478,  4369,  3305,  2291,  1331,   429,
+		  -413, -1191, -1904, -2549, -3126, -3635, -4074, -4445,
+		 -4749, -4987, -5161, -5273, -5326, -5323, -5267, -5162,
+		 -5012, -4820, -4591, -4329, -4039, -3724, -3390, -3040,
+		 -2679, -2310, -1939, -1568, -1202,  -843,  -495,  -161,
+		   157,   456,   735,   991,  1223,  1431,  1613,  1769,
+		  1899,  2003,  2081,  2133,  2161,  2166,  2148,  2109,
+		  2051,  1975,  1883,  1777,  1659,  1530,  1392,  1248,
+		  1099,   948,   794,   642,   491,   344,   202,    65,
+		   -64,  -184,  -296,  -399,  -491,  -573,  -643,  -703,
+		  -752,  -790,  -817,  -835,  -842,  -840,  -829,  -810,
+		  -784,  -751,  -713,  -669,  -621,  -569,  -515,  -459,
+		  -402,  -344,  -287,  -230,  -175,  -122,   -71,   -23,
+		    22,    63,   101,   135,   164,   190,   212,   229,
+		   243,   253,   259,   262,   262,   259,   253,   244,
+		   234,   222,   208,   193,   177,   160,   143,   126,
+		   109,    92,    75,    60,    45,    31,    18,     6,
+		    -5,   -15,   -23,   -31,   -37,   -42,   -45,   -48,
+		   -50,   -51,   -51,   -50,   -49,   -47,   -45,   -42,
+		   -39,   -36,   -33,   -29,   -26,   -23,   -19,   -16,
+		   -14,   -11,    -9,    -6,    -5,    -3,    -2,     0,
+	} },
+};
+
 #endif/*__DSP_FIR_TAPS_H__*/
@@ -23,6 +23,8 @@
 #define __DSP_IIR_H__
 
 #include <array>
+#include <cstdint>
+#include <cstddef>
 
 #include "dsp_types.hpp"
 
@@ -67,4 +69,61 @@ private:
 	std::array<float, 3> y { { 0.0f, 0.0f, 0.0f } };
 };
 
+/* Cascade of N transposed direct form II biquads on int16 samples. Float
+ * configs are converted to Q30 (|coefficient| < 2) by configure(). Between
+ * sections samples are carried as Q29, 14 bits finer than int16 with 4x
+ * headroom, and the section state is 64 bits wide, so each multiply-
+ * accumulate is one SMLAL and the low-cutoff HPFs don't drown in
+ * quantization noise. Output is rounded and saturated back to int16.
+ */
+template<size_t N>
+class IIRBiquadCascade {
+public:
+	void configure(const size_t section, const iir_biquad_config_t& config) {
+		sections[section] = {
+			{ { q30(config.b[0]), q30(config.b[1]), q30(config.b[2]) } },
+			{ { q30(-config.a[1]), q30(-config.a[2]) } },
+			0, 0
+		};
+	}
+
+	void execute(const buffer_s16_t& buffer_in, const buffer_s16_t& buffer_out) {
+		for(size_t i=0; i<buffer_out.count; i++) {
+			int32_t sample = static_cast<int32_t>(buffer_in.p[i]) << signal_shift;
+			for(auto& section : sections) {
+				sample = section.execute(sample);
+			}
+			const int32_t rounded = (sample + (1 << (signal_shift - 1))) >> signal_shift;
+			buffer_out.p[i] = (rounded > INT16_MAX) ? INT16_MAX : ((rounded < INT16_MIN) ? INT16_MIN : rounded);
+		}
+	}
+
+	void execute_in_place(const buffer_s16_t& buffer) {
+		execute(buffer, buffer);
+	}
+
+private:
+	static constexpr size_t signal_shift = 14;
+
+	struct Section {
+		std::array<int32_t, 3> b;
+		std::array<int32_t, 2> a_neg;
+		int64_t s1;
+		int64_t s2;
+
+		int32_t execute(const int32_t x) {
+			const int32_t y = (static_cast<int64_t>(b[0]) * x + s1 + (1 << 29)) >> 30;
+			s1 = static_cast<int64_t>(b[1]) * x + static_cast<int64_t>(a_neg[0]) * y + s2;
+			s2 = static_cast<int64_t>(b[2]) * x + static_cast<int64_t>(a_neg[1]) * y;
+			return y;
+		}
+	};
+
+	std::array<Section, N> sections { };
+
+	static constexpr int32_t q30(const float value) {
+		return static_cast<int32_t>(value * 1073741824.0f + ((value < 0.0f) ? -0.5f : 0.5f));
+	}
+};
+
 #endif/*__DSP_IIR_H__*/
@@ -103,9 +103,14 @@ public:
 		poke_n(len);
 		copy_in((const T*)buf, len, _in + recsize());
 		_in += len + recsize();
+		smp_mb();
 		return len;
 	}
 
+	static constexpr size_t record_len(const size_t len) {
+		return len + recsize();
+	}
+
 	bool out(T& val) {
 		if( is_empty() ) {
 			return false;
@@ -128,9 +133,11 @@ public:
 		if( is_empty() ) {
 			return false;
 		}
+		smp_rmb();
 
 		size_t len = peek_n();
 		_out += len + recsize();
+		smp_mb();
 		return true;
 	}
 
@@ -138,6 +145,7 @@ public:
 		if( is_empty() ) {
 			return 0;
 		}
+		smp_rmb();
 
 		size_t n;
 		len = out_copy_r((T*)buf, len, &n);
@@ -148,10 +156,12 @@ public:
 		if( is_empty() ) {
 			return 0;
 		}
+		smp_rmb();
 
 		size_t n;
 		len = out_copy_r((T*)buf, len, &n);
 		_out += n + recsize();
+		smp_mb();
 		return len;
 	}
 
@@ -172,10 +182,24 @@ private:
 		return 2;
 	}
 
+	/* Both cores see the shared SRAM directly, but the M4 may reorder its
+	 * accesses. A record's bytes must land before the index publishing it
+	 * (wmb), and must not be read before the index was (rmb). The index
+	 * update is ordered against the following read of the other index
+	 * (mb), so a writer and a reader can't both miss each other's update.
+	 */
 	void smp_wmb() {
 		__DMB();
 	}
 
+	void smp_rmb() {
+		__DMB();
+	}
+
+	void smp_mb() {
+		__DMB();
+	}
+
 	size_t peek_n() {
 		size_t l = _data[_out & mask()];
 		if( recsize() > 1 ) {
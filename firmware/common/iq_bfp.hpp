@@ -0,0 +1,100 @@
+/*
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __IQ_BFP_H__
+#define __IQ_BFP_H__
+
+#include "complex.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+/* Block floating point IQ: complex int16 samples are stored as blocks of
+ * int8 I/Q mantissas sharing one exponent. Each block starts with a two
+ * byte header (exponent, sample count), the mantissas follow interleaved
+ * I, Q. A sample decodes as mantissa << exponent.
+ */
+namespace iq_bfp {
+
+struct Header {
+	uint8_t exponent;
+	uint8_t count;
+};
+
+constexpr size_t header_bytes = sizeof(Header);
+constexpr size_t block_samples_max = 128;
+constexpr size_t block_bytes_max = header_bytes + block_samples_max * 2;
+
+/* int16 magnitudes need at most 8 bits of shift to fit in an int8. */
+constexpr uint8_t exponent_max = 8;
+
+constexpr size_t block_bytes(const size_t count) {
+	return header_bytes + count * 2;
+}
+
+/* Stream bytes for `samples` samples, encoded in full blocks. */
+constexpr uint64_t encoded_bytes(const uint64_t samples) {
+	return samples * block_bytes_max / block_samples_max;
+}
+
+constexpr bool is_valid(const Header& header) {
+	return (header.exponent <= exponent_max) && (header.count > 0) && (header.count <= block_samples_max);
+}
+
+/* Encodes up to block_samples_max samples into dst, returns the block size
+ * in bytes.
+ */
+inline size_t encode_block(const complex16_t* const src, const size_t count, uint8_t* const dst) {
+	// One's complement magnitude, -128 and 127 both fit an int8 mantissa.
+	uint32_t magnitude = 0;
+	for(size_t i=0; i<count; i++) {
+		const int32_t re = src[i].real();
+		const int32_t im = src[i].imag();
+		magnitude |= (re ^ (re >> 31)) | (im ^ (im >> 31));
+	}
+
+	const uint32_t bits = magnitude ? (32 - __builtin_clz(magnitude)) : 0;
+	const uint32_t exponent = (bits > 7) ? (bits - 7) : 0;
+	const int32_t round = exponent ? (1 << (exponent - 1)) : 0;
+
+	dst[0] = exponent;
+	dst[1] = count;
+
+	auto mantissa = reinterpret_cast<int8_t*>(&dst[header_bytes]);
+	for(size_t i=0; i<count; i++) {
+		const int32_t re = (src[i].real() + round) >> exponent;
+		const int32_t im = (src[i].imag() + round) >> exponent;
+		// Rounding can carry 127 up to 128.
+		*(mantissa++) = (re > 127) ? 127 : re;
+		*(mantissa++) = (im > 127) ? 127 : im;
+	}
+
+	return block_bytes(count);
+}
+
+inline complex16_t decode_sample(const int8_t* const mantissa, const uint8_t exponent) {
+	return {
+		static_cast<int16_t>(mantissa[0] << exponent),
+		static_cast<int16_t>(mantissa[1] << exponent)
+	};
+}
+
+} /* namespace iq_bfp */
+
+#endif/*__IQ_BFP_H__*/
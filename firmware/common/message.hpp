@@ -111,6 +111,13 @@ public:
 		AudioLevelReport = 51,
 		CodedSquelch = 52,
 		AudioSpectrum = 53,
+		BasebandStageStatistics = 54,
+		ChannelizerConfigure = 55,
+		ChannelizerStatus = 56,
+		SpectrumSweepConfig = 57,
+		SpectrumSweepRetune = 58,
+		SpectrumSweepTuned = 59,
+		OOKRemotePacket = 60,
 		MAX
 	};
 
@@ -162,6 +169,44 @@ public:
 	BasebandStatistics statistics;
 };
 
+/* Cycles spent per baseband buffer in BasebandProcessor::execute(), and in
+ * the common DSP stages it calls, over the last report interval.
+ */
+struct BasebandStageStatistics {
+	enum Stage : size_t {
+		Execute = 0,
+		Decimation = 1,
+		ChannelFilter = 2,
+		Demodulation = 3,
+		AudioOutput = 4,
+		Spectrum = 5,
+		StageCount
+	};
+
+	struct Cycles {
+		uint32_t min { 0 };
+		uint32_t avg { 0 };
+		uint32_t max { 0 };
+	};
+
+	std::array<Cycles, StageCount> stages { };
+	uint32_t budget { 0 };		/* Cycles available per buffer at the sampling rate */
+	uint32_t buffers { 0 };
+	uint32_t overruns { 0 };	/* Buffers where execute() took longer than budget */
+};
+
+class BasebandStageStatisticsMessage : public Message {
+public:
+	constexpr BasebandStageStatisticsMessage(
+		const BasebandStageStatistics& statistics
+	) : Message { ID::BasebandStageStatistics },
+		statistics { statistics }
+	{
+	}
+
+	BasebandStageStatistics statistics;
+};
+
 struct ChannelStatistics {
 	int32_t max_db;
 	size_t count;
@@ -253,14 +298,44 @@ public:
 		Running = 1,
 	};
 
+	/* Time-domain window applied before the FFT. */
+	enum class Window : uint32_t {
+		Rectangular = 0,
+		Hamming = 1,
+		Hann = 2,
+		BlackmanHarris = 3,
+		FlatTop = 4,
+	};
+
+	/* How successive FFT frames are combined before being reported.
+	 * Welch: mean of average_count frames, reported once per average_count.
+	 * PeakHold: maximum since streaming started.
+	 * Exponential: running average with weight 1/average_count.
+	 */
+	enum class Averaging : uint32_t {
+		None = 0,
+		Welch = 1,
+		PeakHold = 2,
+		Exponential = 3,
+	};
+
 	constexpr SpectrumStreamingConfigMessage(
-		Mode mode
+		Mode mode,
+		Window window = Window::Hamming,
+		Averaging averaging = Averaging::None,
+		uint32_t average_count = 1
 	) : Message { ID::SpectrumStreamingConfig },
-		mode { mode }
+		mode { mode },
+		window { window },
+		averaging { averaging },
+		average_count { average_count }
 	{
 	}
 
 	Mode mode { Mode::Stopped };
+	Window window { Window::Hamming };
+	Averaging averaging { Averaging::None };
+	uint32_t average_count { 1 };
 };
 
 class WidebandSpectrumConfigMessage : public Message {
@@ -278,6 +353,60 @@ public:
 	size_t trigger { 0 };
 };
 
+/* Sweep mode: the M4 steps through slice_count slices, `step` Hz apart,
+ * asking the application for each retune (SpectrumSweepRetuneMessage) and
+ * waiting for SpectrumSweepTunedMessage before discarding settle_buffers
+ * buffers and averaging the spectra of the next average_count. A slice_count
+ * of 0 stops sweeping.
+ */
+class SpectrumSweepConfigMessage : public Message {
+public:
+	constexpr SpectrumSweepConfigMessage(
+		const int64_t first_frequency,
+		const uint32_t step,
+		const uint32_t slice_count,
+		const uint32_t settle_buffers,
+		const uint32_t average_count
+	) : Message { ID::SpectrumSweepConfig },
+		first_frequency { first_frequency },
+		step { step },
+		slice_count { slice_count },
+		settle_buffers { settle_buffers },
+		average_count { average_count }
+	{
+	}
+
+	int64_t first_frequency { 0 };
+	uint32_t step { 0 };
+	uint32_t slice_count { 0 };
+	uint32_t settle_buffers { 0 };
+	uint32_t average_count { 1 };
+};
+
+class SpectrumSweepRetuneMessage : public Message {
+public:
+	constexpr SpectrumSweepRetuneMessage(
+		const int64_t frequency
+	) : Message { ID::SpectrumSweepRetune },
+		frequency { frequency }
+	{
+	}
+
+	int64_t frequency { 0 };
+};
+
+class SpectrumSweepTunedMessage : public Message {
+public:
+	constexpr SpectrumSweepTunedMessage(
+		const int64_t frequency
+	) : Message { ID::SpectrumSweepTuned },
+		frequency { frequency }
+	{
+	}
+
+	int64_t frequency { 0 };
+};
+
 struct AudioSpectrum {
 	std::array<uint8_t, 128> db { { 0 } };
 	//uint32_t sampling_rate { 0 };
@@ -300,6 +429,7 @@ struct ChannelSpectrum {
 	uint32_t sampling_rate { 0 };
 	uint32_t channel_filter_pass_frequency { 0 };
 	uint32_t channel_filter_stop_frequency { 0 };
+	int64_t center_frequency { 0 };		// Sweep mode only, tuned frequency of the slice
 };
 
 using ChannelSpectrumFIFO = FIFO<ChannelSpectrum>;
@@ -321,13 +451,16 @@ public:
 class AISPacketMessage : public Message {
 public:
 	constexpr AISPacketMessage(
-		const baseband::Packet& packet
+		const baseband::Packet& packet,
+		const uint32_t channel
 	) : Message { ID::AISPacket },
-		packet { packet }
+		packet { packet },
+		channel { channel }
 	{
 	}
 
 	baseband::Packet packet;
+	uint32_t channel;	/* 0: 161.975MHz (A), 1: 162.025MHz (B) */
 };
 
 class TPMSPacketMessage : public Message {
@@ -448,6 +581,24 @@ public:
 	baseband::Packet packet;
 };
 
+class OOKRemotePacketMessage : public Message {
+public:
+	constexpr OOKRemotePacketMessage(
+		const uint64_t code,
+		const size_t bit_count,
+		const uint32_t short_pulse_us
+	) : Message { ID::OOKRemotePacket },
+		code { code },
+		bit_count { bit_count },
+		short_pulse_us { short_pulse_us }
+	{
+	}
+
+	uint64_t code;
+	size_t bit_count;
+	uint32_t short_pulse_us;
+};
+
 class TestAppPacketMessage : public Message {
 public:
 	constexpr TestAppPacketMessage(
@@ -501,6 +652,62 @@ public:
 	const uint8_t squelch_level;
 };
 
+class ChannelizerConfigureMessage : public Message {
+public:
+	static constexpr size_t channels_max = 16;
+	static constexpr uint32_t sampling_rate_per_spacing = 256;
+
+	constexpr ChannelizerConfigureMessage(
+		const uint32_t channel_spacing,
+		const size_t channel_count,
+		const size_t deviation,
+		const iir_biquad_config_t audio_hpf_config,
+		const iir_biquad_config_t audio_deemph_config,
+		const int32_t squelch_db,
+		const int32_t audio_channel
+	) : Message { ID::ChannelizerConfigure },
+		channel_spacing { channel_spacing },
+		channel_count { channel_count },
+		deviation { deviation },
+		audio_hpf_config(audio_hpf_config),
+		audio_deemph_config(audio_deemph_config),
+		squelch_db { squelch_db },
+		audio_channel { audio_channel }
+	{
+	}
+
+	/* Baseband sampling rate is channel_spacing * sampling_rate_per_spacing.
+	 * Channel c is centred at (c - channel_count / 2) * channel_spacing from
+	 * the tuned frequency.
+	 */
+	const uint32_t channel_spacing;
+	const size_t channel_count;
+	const size_t deviation;
+	const iir_biquad_config_t audio_hpf_config;
+	const iir_biquad_config_t audio_deemph_config;
+	const int32_t squelch_db;
+	/* Channel to listen to, or -1 to follow the strongest open channel. */
+	const int32_t audio_channel;
+};
+
+struct ChannelizerStatus {
+	std::array<int8_t, ChannelizerConfigureMessage::channels_max> max_db;
+	uint32_t squelch_open;
+	int32_t audio_channel;
+};
+
+class ChannelizerStatusMessage : public Message {
+public:
+	constexpr ChannelizerStatusMessage(
+		const ChannelizerStatus& status
+	) : Message { ID::ChannelizerStatus },
+		status(status)
+	{
+	}
+
+	ChannelizerStatus status;
+};
+
 class WFMConfigureMessage : public Message {
 public:
 	constexpr WFMConfigureMessage(
@@ -620,8 +827,23 @@ public:
 };
 
 struct CaptureConfig {
+	enum class Format : uint32_t {
+		/* Decimated by 8, complex int16. */
+		C16 = 0,
+		/* Full baseband rate, complex int8. The baseband DMA writes straight
+		 * into the stream buffers, write_size must be a multiple of one DMA
+		 * transfer (4096 bytes).
+		 */
+		C8Direct = 1,
+		/* Decimated by 8, block floating point (see iq_bfp.hpp). Blocks
+		 * are never split by a dropped buffer.
+		 */
+		BFP8 = 2,
+	};
+
 	const size_t write_size;
 	const size_t buffer_count;
+	const Format format;
 	uint64_t baseband_bytes_received;
 	uint64_t baseband_bytes_dropped;
 	FIFO<StreamBuffer*>* fifo_buffers_empty;
@@ -629,9 +851,11 @@ struct CaptureConfig {
 
 	constexpr CaptureConfig(
 		const size_t write_size,
-		const size_t buffer_count
+		const size_t buffer_count,
+		const Format format = Format::C16
 	) : write_size { write_size },
 		buffer_count { buffer_count },
+		format { format },
 		baseband_bytes_received { 0 },
 		baseband_bytes_dropped { 0 },
 		fifo_buffers_empty { nullptr },
@@ -644,7 +868,7 @@ struct CaptureConfig {
 			return 0;
 		} else {
 			const size_t percent = baseband_bytes_dropped * 100U / baseband_bytes_received;
-			return std::max(1U, percent);
+			return std::max<size_t>(1U, percent);
 		}
 	}
 };
@@ -662,17 +886,23 @@ public:
 };
 
 struct ReplayConfig {
+	/* C16 or BFP8, as recorded. */
+	using Format = CaptureConfig::Format;
+
 	const size_t read_size;
 	const size_t buffer_count;
+	const Format format;
 	uint64_t baseband_bytes_received;
 	FIFO<StreamBuffer*>* fifo_buffers_empty;
 	FIFO<StreamBuffer*>* fifo_buffers_full;
 
 	constexpr ReplayConfig(
 		const size_t read_size,
-		const size_t buffer_count
+		const size_t buffer_count,
+		const Format format = Format::C16
 	) : read_size { read_size },
 		buffer_count { buffer_count },
+		format { format },
 		baseband_bytes_received { 0 },
 		fifo_buffers_empty { nullptr },
 		fifo_buffers_full { nullptr }
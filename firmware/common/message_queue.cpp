@@ -28,10 +28,18 @@ using namespace lpc43xx;
 void MessageQueue::signal() {
 	creg::m0apptxevent::assert_event();
 }
+
+void MessageMailbox::signal() {
+	creg::m0apptxevent::assert_event();
+}
 #endif
 
 #if defined(LPC43XX_M4)
 void MessageQueue::signal() {
 	creg::m4txevent::assert_event();
 }
+
+void MessageMailbox::signal() {
+	creg::m4txevent::assert_event();
+}
 #endif
@@ -23,6 +23,8 @@
 #define __MESSAGE_QUEUE_H__
 
 #include <cstdint>
+#include <cstring>
+#include <array>
 
 #include "message.hpp"
 #include "fifo.hpp"
@@ -40,7 +42,6 @@ public:
 		size_t k
 	) : fifo { data, k }
 	{
-		chMtxInit(&mutex_write);
 	}
 
 	template<typename T>
@@ -51,12 +52,16 @@ public:
 		return push(&message, sizeof(message));
 	}
 
+	/* Sleeps the core until the other side has drained the queue. Its
+	 * event (or any interrupt) wakes the core to check again.
+	 */
 	template<typename T>
 	bool push_and_wait(const T& message) {
 		const bool result = push(message);
 		if( result ) {
-			// TODO: More graceful method of waiting for empty? Maybe sleep for a bit?
-			while( !is_empty() );
+			while( !is_empty() ) {
+				__WFE();
+			}
 		}
 		return result;
 	}
@@ -77,10 +82,21 @@ public:
 	void reset() {
 		fifo.reset();
 	}
+
+	/* Most bytes ever queued at once, records included. */
+	size_t high_water() const {
+		return high_water_;
+	}
+
+	/* Pushes that found the queue full, and were discarded. */
+	uint32_t rejected() const {
+		return rejected_;
+	}
 	
 private:
 	FIFO<uint8_t> fifo;
-	Mutex mutex_write { };
+	volatile size_t high_water_ { 0 };
+	volatile uint32_t rejected_ { 0 };
 
 	Message* peek(std::array<uint8_t, Message::MAX_SIZE>& buf) {
 		Message* const p = reinterpret_cast<Message*>(buf.data());
@@ -100,13 +116,32 @@ private:
 		return fifo.len();
 	}
 
+	/* One reader and one writer per queue, normally on different cores,
+	 * need no lock: FIFO orders the record ahead of the index that
+	 * publishes it. Threads sharing the writing core are serialized by a
+	 * short critical section around the copy.
+	 *
+	 * The reader drains everything queued before it goes back to sleep,
+	 * so the other core is only interrupted for a push into an empty
+	 * queue. Messages pushed while the reader is busy ride along.
+	 */
 	bool push(const void* const buf, const size_t len) {
-		chMtxLock(&mutex_write);
-		const auto result = fifo.in_r(buf, len);
-		chMtxUnlock();
-
-		const bool success = (result == len);
+		chSysLock();
+		const bool success = (fifo.in_r(buf, len) == len);
+		// Checked after the record is published: if the reader has already
+		// caught up to it, the reader may have seen the queue empty.
+		const size_t queued = fifo.len();
 		if( success ) {
+			if( queued > high_water_ ) {
+				high_water_ = queued;
+			}
+		} else {
+			rejected_ = rejected_ + 1;
+		}
+		chSysUnlock();
+
+		const bool only_record = (queued == fifo.record_len(len));
+		if( success && only_record ) {
 			signal();
 		}
 		return success;
@@ -115,4 +150,134 @@ private:
 	void signal();
 };
 
+/* Latest-value slots for periodic telemetry (statistics, levels, status).
+ * Posting overwrites whatever the reader hasn't taken yet, so a slow reader
+ * sees the newest value and the stream never fills application_queue,
+ * leaving it to messages that must not be lost, like decoded packets.
+ *
+ * Each slot is a sequence lock: the writer makes the sequence odd while it
+ * copies, and the reader retries if the sequence moved during its copy.
+ * The reader keeps its own `seen` count, so neither core ever writes a
+ * word the other one writes.
+ */
+class MessageMailbox {
+public:
+	static constexpr size_t slot_size = 96;
+
+	MessageMailbox() = default;
+	MessageMailbox(const MessageMailbox&) = delete;
+	MessageMailbox(MessageMailbox&&) = delete;
+
+	static constexpr bool is_mailbox_message(const Message::ID id) {
+		return slot_index(id) < slot_count;
+	}
+
+	template<typename T>
+	void post(const T& message) {
+		static_assert(sizeof(T) <= slot_size, "MessageMailbox::slot_size too small for message type");
+		static_assert(std::is_base_of<Message, T>::value, "type is not based on Message");
+
+		const auto index = slot_index(message.id);
+		if( index < slot_count ) {
+			post(slots[index], &message, sizeof(message));
+		}
+	}
+
+	template<typename HandlerFn>
+	void handle(HandlerFn handler) {
+		std::array<uint32_t, slot_size / sizeof(uint32_t)> message_buffer;
+		for(auto& slot : slots) {
+			while(take(slot, message_buffer.data())) {
+				handler(reinterpret_cast<Message*>(message_buffer.data()));
+			}
+		}
+	}
+
+	bool is_pending() const {
+		for(const auto& slot : slots) {
+			if( slot.sequence != slot.seen ) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/* Only while the writing core is stopped. */
+	void reset() {
+		for(auto& slot : slots) {
+			slot.sequence = 0;
+			slot.seen = 0;
+		}
+	}
+
+private:
+	static constexpr size_t slot_count = 8;
+
+	static constexpr size_t slot_index(const Message::ID id) {
+		switch(id) {
+		case Message::ID::RSSIStatistics:			return 0;
+		case Message::ID::BasebandStatistics:		return 1;
+		case Message::ID::ChannelStatistics:		return 2;
+		case Message::ID::AudioStatistics:			return 3;
+		case Message::ID::BasebandStageStatistics:	return 4;
+		case Message::ID::AudioLevelReport:			return 5;
+		case Message::ID::ChannelizerStatus:		return 6;
+		case Message::ID::AudioSpectrum:			return 7;
+		default:									return slot_count;
+		}
+	}
+
+	struct Slot {
+		volatile uint32_t sequence { 0 };
+		volatile uint32_t seen { 0 };
+		uint32_t data[slot_size / sizeof(uint32_t)] { };
+	};
+
+	std::array<Slot, slot_count> slots { };
+
+	void post(Slot& slot, const void* const message, const size_t len) {
+		chSysLock();
+		const uint32_t sequence = slot.sequence;
+		slot.sequence = sequence + 1;
+		__DMB();
+		memcpy(slot.data, message, len);
+		__DMB();
+		slot.sequence = sequence + 2;
+		__DMB();
+		// The reader had caught up before this post, so it may be asleep.
+		const bool wake = (slot.seen == sequence);
+		chSysUnlock();
+
+		if( wake ) {
+			signal();
+		}
+	}
+
+	bool take(Slot& slot, uint32_t* const buf) {
+		// A post is a short copy; give up after a few tries rather than spin
+		// on a writer that was stopped mid-copy. The slot stays pending, and
+		// the reader must come back for it: the post won't signal again.
+		for(size_t tries=0; tries<4; tries++) {
+			const uint32_t sequence = slot.sequence;
+			if( sequence == slot.seen ) {
+				return false;
+			}
+			if( sequence & 1 ) {
+				continue;
+			}
+			__DMB();
+			memcpy(buf, slot.data, slot_size);
+			__DMB();
+			if( slot.sequence == sequence ) {
+				slot.seen = sequence;
+				__DMB();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void signal();
+};
+
 #endif/*__MESSAGE_QUEUE_H__*/
@@ -21,6 +21,10 @@
 
 #include "png_writer.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
 static constexpr std::array<uint8_t, 8> png_file_header { {
 	0x89, 0x50, 0x4e, 0x47,
 	0x0d, 0x0a, 0x1a, 0x0a,
@@ -59,49 +63,119 @@ Optional<File::Error> PNGWriter::create(
 
 	file.write(png_file_header);
 	file.write(png_ihdr_screen_capture);
-	
-	write_chunk_header(
-		2 + height * (5 + 1 + width * 3) + 4,
-		png_idat_chunk_type
-	);
+
+	state = std::make_unique<State>([this](const uint8_t* const data, const size_t count) {
+		this->write_idat(data, count);
+	});
 
 	constexpr std::array<uint8_t, 2> zlib_header { 0x78, 0x01 };	// Zlib CM, CINFO, FLG.
-	write_chunk_content(zlib_header);
+	write_idat(zlib_header.data(), zlib_header.size());
 
 	return { };
 }
 
 PNGWriter::~PNGWriter() {
-	write_chunk_content(adler_32.bytes());
-	write_chunk_crc();
+	if( !state ) {
+		return;
+	}
+
+	state->deflate.finish();
+
+	const auto adler = adler_32.bytes();
+	write_idat(adler.data(), adler.size());
+	flush_idat();
 
 	file.write(png_iend);
 }
 
 void PNGWriter::write_scanline(const std::array<ui::ColorRGB888, 240>& scanline) {
-	constexpr uint8_t scanline_filter_type = 0;
-	constexpr uint32_t deflate_block_length = 1 + sizeof(scanline);
-
-	const std::array<uint8_t, 6> deflate_and_scanline_header {
-		static_cast<uint8_t>((scanline_count == (height - 1)) ? 0x01 : 0x00),	// DEFLATE header bits, bfinal=0, btype=00
-		static_cast<uint8_t>((deflate_block_length >> 0) & 0xff),			// Length LSB
-		static_cast<uint8_t>((deflate_block_length >> 8) & 0xff),			// Length MSB
-		static_cast<uint8_t>((deflate_block_length >> 0) & 0xff) ^ 0xff,	// ~Length LSB
-		static_cast<uint8_t>((deflate_block_length >> 8) & 0xff) ^ 0xff,	// ~Length MSB
-		scanline_filter_type,
-	};
-	write_chunk_content(deflate_and_scanline_header);
-
-	adler_32.feed(scanline_filter_type);
-	adler_32.feed(scanline);
-
-	// Small writes to avoid some sort of large-transfer plus block
-	// boundary FatFs or SDC driver bug?
-	write_chunk_content(&scanline[  0], 80 * sizeof(ui::ColorRGB888));
-	write_chunk_content(&scanline[ 80], 80 * sizeof(ui::ColorRGB888));
-	write_chunk_content(&scanline[160], 80 * sizeof(ui::ColorRGB888));
-
-	scanline_count++;
+	const auto row = reinterpret_cast<const uint8_t*>(scanline.data());
+
+	filter_row(row);
+	adler_32.feed(state->filtered);
+	state->deflate.feed(state->filtered.data(), state->filtered.size());
+
+	memcpy(state->previous.data(), row, row_bytes);
+}
+
+/* Pick the filter with the smallest sum of absolute (signed) residuals,
+ * the usual heuristic. Flat areas and rows repeating the one above come
+ * out as runs of zeros, which the deflate matches cheaply.
+ */
+void PNGWriter::filter_row(const uint8_t* const row) {
+	constexpr size_t bpp = sizeof(ui::ColorRGB888);
+	const auto previous = state->previous.data();
+	auto& filtered = state->filtered;
+
+	uint32_t cost_none = 0;
+	uint32_t cost_sub = 0;
+	uint32_t cost_up = 0;
+	for(size_t i=0; i<row_bytes; i++) {
+		const int8_t none = row[i];
+		const int8_t sub = row[i] - ((i >= bpp) ? row[i - bpp] : 0);
+		const int8_t up = row[i] - previous[i];
+		cost_none += std::abs(none);
+		cost_sub += std::abs(sub);
+		cost_up += std::abs(up);
+	}
+
+	Filter filter = Filter::None;
+	uint32_t cost = cost_none;
+	if( cost_sub < cost ) {
+		filter = Filter::Sub;
+		cost = cost_sub;
+	}
+	if( cost_up < cost ) {
+		filter = Filter::Up;
+	}
+
+	filtered[0] = filter;
+	uint8_t* const out = &filtered[1];
+	switch(filter) {
+	case Filter::Sub:
+		for(size_t i=0; i<bpp; i++) {
+			out[i] = row[i];
+		}
+		for(size_t i=bpp; i<row_bytes; i++) {
+			out[i] = row[i] - row[i - bpp];
+		}
+		break;
+
+	case Filter::Up:
+		for(size_t i=0; i<row_bytes; i++) {
+			out[i] = row[i] - previous[i];
+		}
+		break;
+
+	default:
+		memcpy(out, row, row_bytes);
+		break;
+	}
+}
+
+void PNGWriter::write_idat(const void* const p, const size_t count) {
+	auto data = reinterpret_cast<const uint8_t*>(p);
+	size_t remaining = count;
+	while( remaining ) {
+		const size_t n = std::min(remaining, state->idat.size() - state->idat_count);
+		memcpy(&state->idat[state->idat_count], data, n);
+		state->idat_count += n;
+		data += n;
+		remaining -= n;
+
+		if( state->idat_count == state->idat.size() ) {
+			flush_idat();
+		}
+	}
+}
+
+void PNGWriter::flush_idat() {
+	if( state->idat_count ) {
+		write_chunk_header(state->idat_count, png_idat_chunk_type);
+		write_chunk_content(state->idat.data(), state->idat_count);
+		write_chunk_crc();
+		state->idat_count = 0;
+	}
 }
 
 void PNGWriter::write_chunk_header(
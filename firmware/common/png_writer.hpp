@@ -26,11 +26,17 @@
 #include <cstddef>
 #include <string>
 #include <array>
+#include <memory>
 
 #include "ui.hpp"
 #include "file.hpp"
 #include "crc.hpp"
+#include "deflate.hpp"
 
+/* Rows are filtered (None, Sub or Up, whichever looks cheapest) and
+ * compressed with a fixed-Huffman deflate stream, then written out as a
+ * series of IDAT chunks so no chunk length has to be patched afterwards.
+ */
 class PNGWriter {
 public:
 	~PNGWriter();
@@ -44,11 +50,35 @@ private:
 	static constexpr int width { 240 };
 	static constexpr int height { 320 };
 
+	static constexpr size_t row_bytes { width * sizeof(ui::ColorRGB888) };
+
+	enum Filter : uint8_t {
+		None = 0,
+		Sub = 1,
+		Up = 2,
+	};
+
+	/* Kept off the caller's stack. */
+	struct State {
+		Deflate deflate;
+		std::array<uint8_t, row_bytes> previous { };
+		std::array<uint8_t, 1 + row_bytes> filtered { };
+		std::array<uint8_t, 512> idat { };
+		size_t idat_count { 0 };
+
+		explicit State(Deflate::Sink sink) : deflate { std::move(sink) } { }
+	};
+
 	File file { };
-	int scanline_count { 0 };
-	CRC<32, true, true> crc { 0x04c11db7, 0xffffffff, 0xffffffff };
+	std::unique_ptr<State> state { };
+	TableCRC<32, 0x04c11db7, true, true, 4> crc { 0xffffffff, 0xffffffff };
 	Adler32 adler_32 { };
 
+	void filter_row(const uint8_t* const row);
+
+	void write_idat(const void* const p, const size_t count);
+	void flush_idat();
+
 	void write_chunk_header(const size_t length, const std::array<uint8_t, 4>& type);
 	void write_chunk_content(const void* const p, const size_t count);
 
@@ -56,6 +56,7 @@ struct SharedMemory {
 	const Message* volatile baseband_message { nullptr };
 	MessageQueue application_queue { application_queue_data, application_queue_k };
 	MessageQueue app_local_queue { app_local_queue_data, app_local_queue_k };
+	MessageMailbox application_mailbox { };
 
 	char m4_panic_msg[32] { 0 };
 	
@@ -76,8 +76,10 @@ constexpr image_tag_t image_tag_am_tv			        { 'P', 'A', 'M', 'T' };
 constexpr image_tag_t image_tag_capture				{ 'P', 'C', 'A', 'P' };
 constexpr image_tag_t image_tag_ert					{ 'P', 'E', 'R', 'T' };
 constexpr image_tag_t image_tag_nfm_audio			{ 'P', 'N', 'F', 'M' };
+constexpr image_tag_t image_tag_nfm_channelizer	{ 'P', 'N', 'F', 'C' };
 constexpr image_tag_t image_tag_pocsag				{ 'P', 'P', 'O', 'C' };
 constexpr image_tag_t image_tag_sonde				{ 'P', 'S', 'O', 'N' };
+constexpr image_tag_t image_tag_subghz				{ 'P', 'S', 'G', 'Z' };
 constexpr image_tag_t image_tag_tpms				{ 'P', 'T', 'P', 'M' };
 constexpr image_tag_t image_tag_wfm_audio			{ 'P', 'W', 'F', 'M' };
 constexpr image_tag_t image_tag_wideband_spectrum	{ 'P', 'S', 'P', 'E' };
@@ -18,25 +18,47 @@
 # Boston, MA 02110-1301, USA.
 #
 
+# airlines.db layout, as read by AirlinesDB (ui_adsb_rx.cpp):
+#   0x0000: 3-letter ICAO codes, NUL-terminated (4 bytes each), sorted,
+#           ended by an all-zero code. The firmware loads this block once
+#           and binary-searches it, so it MUST stay sorted.
+#   0x2000: one 64-byte record per code, same order: name (32 bytes) then
+#           country (32 bytes), NUL-padded.
+
 import sys
-import struct
 
-outfile = open("airlines.db", "w")
+CODES_SIZE = 0x2000
+FIELD_SIZE = 32
+
+def field(s):
+	b = s.encode('ascii', 'replace')[:FIELD_SIZE - 1]
+	return b + b'\0' * (FIELD_SIZE - len(b))
 
 # Download airlines.txt from http://xdeco.org/?page_id=30
-lines = [line.rstrip('\n') for line in open('../../sdcard/ADSB/airlines.txt', 'r')]
-n = 0
-
-for line in lines:
-	if line:
-		nd = line.find('(')
-		if (nd == -1):
-			nd = None
-		else:
-			nd -= 1
-		nline = line[4:7] + '\0' + line[10:nd] + '\0'
-		print nline
-		b = bytearray(nline)
-		pad_len = 32 - len(b)
-		b += "\0" * pad_len
-		outfile.write(b)
+airlines = {}
+for line in open('../../sdcard/ADSB/airlines.txt', 'r'):
+	line = line.rstrip('\n')
+	if not line:
+		continue
+	code = line[4:7]
+	nd = line.find('(')
+	if nd == -1:
+		name = line[10:].strip()
+		country = ''
+	else:
+		name = line[10:nd].strip()
+		country = line[nd + 1:].split(')')[0].strip()
+	airlines[code] = (name, country)
+
+codes = sorted(airlines)
+if (len(codes) + 1) * 4 > CODES_SIZE:
+	sys.exit("too many airlines for the code table")
+
+with open("airlines.db", "wb") as outfile:
+	table = b''.join(code.encode('ascii') + b'\0' for code in codes)
+	outfile.write(table + b'\0' * (CODES_SIZE - len(table)))
+	for code in codes:
+		name, country = airlines[code]
+		outfile.write(field(name) + field(country))
+
+print("%d airlines" % len(codes))
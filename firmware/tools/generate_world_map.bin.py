@@ -23,28 +23,57 @@ import sys
 import struct
 from PIL import Image
 
-outfile = open('../../sdcard/ADSB/world_map.bin', 'wb')
+# Tiled layout, as read by GeoMap::init() (ui_geomap.cpp):
+#   u16 0, u16 tile size, u16 level count, u16 0
+#   per level: u16 width, u16 height, u32 offset of its first tile
+#   per level, at a 512-byte aligned offset: row-major tiles, each
+#   TILE_SIZE x TILE_SIZE RGB565 pixels, row-major, edge tiles padded.
+# Each level is half the size of the previous one (zoomed out).
+
+TILE_SIZE = 32		# 2kB tiles, must match GeoMap::tile_size
+LEVELS = 3
+SECTOR = 512
+
+def rgb565(p):
+	# RRRRRGGGGGGBBBBB
+	return ((p[0] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[2] >> 3)
+
+def tiles(im):
+	pix = im.load()
+	tiles_x = (im.size[0] + TILE_SIZE - 1) // TILE_SIZE
+	tiles_y = (im.size[1] + TILE_SIZE - 1) // TILE_SIZE
+	data = bytearray()
+	for ty in range(0, tiles_y):
+		for tx in range(0, tiles_x):
+			for y in range(ty * TILE_SIZE, (ty + 1) * TILE_SIZE):
+				for x in range(tx * TILE_SIZE, (tx + 1) * TILE_SIZE):
+					if (x < im.size[0]) and (y < im.size[1]):
+						data += struct.pack('<H', rgb565(pix[x, y]))
+					else:
+						data += struct.pack('<H', 0)
+		print(str(ty) + '/' + str(tiles_y) + '\r', end="")
+	print()
+	return data
 
 # Allow for bigger images
 Image.MAX_IMAGE_PIXELS = None
-im = Image.open("../../sdcard/ADSB/world_map.jpg")
-pix = im.load()
-
-outfile.write(struct.pack('H', im.size[0]))
-outfile.write(struct.pack('H', im.size[1]))
-
-for y in range (0, im.size[1]):
-	line = ''
-	for x in range (0, im.size[0]):
-		# RRRRRGGGGGGBBBBB
-		pixel_lcd = (pix[x, y][0] >> 3) << 11
-		pixel_lcd |= (pix[x, y][1] >> 2) << 5
-		pixel_lcd |= (pix[x, y][2] >> 3)
-		#         RRRGGGBB to
-		# RRR00GGG000BB000
-		# pixel_lcd = (pix[x, y][0] >> 5) << 5
-		# pixel_lcd |= (pix[x, y][1] >> 5) << 2
-		# pixel_lcd |= (pix[x, y][2] >> 6)
-		line += struct.pack('H', pixel_lcd)
-	outfile.write(line)
-	print(str(y) + '/' + str(im.size[1]) + '\r', end="")
+im = Image.open("../../sdcard/ADSB/world_map.jpg").convert('RGB')
+
+levels = []
+for level in range(0, LEVELS):
+	size = (im.size[0] >> level, im.size[1] >> level)
+	levels.append((size, tiles(im if level == 0 else im.resize(size, Image.LANCZOS))))
+
+header_size = 8 + 8 * LEVELS
+offset = (header_size + SECTOR - 1) // SECTOR * SECTOR
+
+with open('../../sdcard/ADSB/world_map.bin', 'wb') as outfile:
+	outfile.write(struct.pack('<HHHH', 0, TILE_SIZE, LEVELS, 0))
+	offsets = []
+	for size, data in levels:
+		outfile.write(struct.pack('<HHI', size[0], size[1], offset))
+		offsets.append(offset)
+		offset = (offset + len(data) + SECTOR - 1) // SECTOR * SECTOR
+	for (size, data), level_offset in zip(levels, offsets):
+		outfile.write(b'\0' * (level_offset - outfile.tell()))
+		outfile.write(data)